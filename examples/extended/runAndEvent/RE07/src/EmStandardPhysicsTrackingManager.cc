@@ -29,7 +29,7 @@
 // Original author: Jonas Hahnfeld, 2021
 
 #include "EmStandardPhysicsTrackingManager.hh"
-#include "TrackingManagerHelper.hh"
+#include "G4TrackingManagerHelper.hh"
 
 #include "G4CoulombScattering.hh"
 #include "G4UrbanMscModel.hh"
@@ -240,7 +240,7 @@ void EmStandardPhysicsTrackingManager::PreparePhysicsTable(
 
 void EmStandardPhysicsTrackingManager::TrackElectron(G4Track* aTrack)
 {
-  class ElectronPhysics final : public TrackingManagerHelper::Physics
+  class ElectronPhysics final : public G4TrackingManagerHelper::Physics
   {
    public:
     ElectronPhysics(EmStandardPhysicsTrackingManager& mgr)
@@ -406,12 +406,12 @@ void EmStandardPhysicsTrackingManager::TrackElectron(G4Track* aTrack)
   };
 
   ElectronPhysics physics(*this);
-  TrackingManagerHelper::TrackChargedParticle(aTrack, physics);
+  G4TrackingManagerHelper::TrackChargedParticle(aTrack, physics);
 }
 
 void EmStandardPhysicsTrackingManager::TrackPositron(G4Track* aTrack)
 {
-  class PositronPhysics final : public TrackingManagerHelper::Physics
+  class PositronPhysics final : public G4TrackingManagerHelper::Physics
   {
    public:
     PositronPhysics(EmStandardPhysicsTrackingManager& mgr)
@@ -617,12 +617,12 @@ void EmStandardPhysicsTrackingManager::TrackPositron(G4Track* aTrack)
   };
 
   PositronPhysics physics(*this);
-  TrackingManagerHelper::TrackChargedParticle(aTrack, physics);
+  G4TrackingManagerHelper::TrackChargedParticle(aTrack, physics);
 }
 
 void EmStandardPhysicsTrackingManager::TrackGamma(G4Track* aTrack)
 {
-  class GammaPhysics final : public TrackingManagerHelper::Physics
+  class GammaPhysics final : public G4TrackingManagerHelper::Physics
   {
    public:
     GammaPhysics(EmStandardPhysicsTrackingManager& mgr)
@@ -765,7 +765,7 @@ void EmStandardPhysicsTrackingManager::TrackGamma(G4Track* aTrack)
   };
 
   GammaPhysics physics(*this);
-  TrackingManagerHelper::TrackNeutralParticle(aTrack, physics);
+  G4TrackingManagerHelper::TrackNeutralParticle(aTrack, physics);
 }
 
 void EmStandardPhysicsTrackingManager::HandOverOneTrack(G4Track* aTrack)
@@ -0,0 +1,114 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4BucketedTrackStack
+//
+// Class description:
+//
+// This is a stack class which may be used by G4StackManager in place of
+// the urgent stack (see G4StackManager::SetBucketing()). Tracks are
+// stored in buckets, one per particle type and optionally per region of
+// their current volume. Tracks of one bucket are popped in LIFO order
+// until the bucket is empty, then the most populated bucket is drained,
+// so that consecutive tracks share their process manager, models and
+// physics tables.
+// The number of particle type changes between consecutive tracks, in the
+// order tracks are pushed (that is the order of the ordinary LIFO stack)
+// and in the order tracks are popped, is counted to measure the benefit.
+
+// --------------------------------------------------------------------
+#ifndef G4BucketedTrackStack_hh
+#define G4BucketedTrackStack_hh 1
+
+#include <map>
+#include <utility>
+
+#include "G4StackedTrack.hh"
+#include "G4TrackStack.hh"
+#include "globals.hh"
+
+class G4ParticleDefinition;
+
+class G4BucketedTrackStack
+{
+  public:
+
+    G4BucketedTrackStack(G4bool perRegion = false);
+   ~G4BucketedTrackStack();
+
+    G4BucketedTrackStack& operator=(const G4BucketedTrackStack&) = delete;
+    G4bool operator==(const G4BucketedTrackStack&) const = delete;
+    G4bool operator!=(const G4BucketedTrackStack&) const = delete;
+
+    void PushToStack(const G4StackedTrack& aStackedTrack);
+    G4StackedTrack PopFromStack();
+    void clear();
+    void clearAndDestroy();
+    void TransferTo(G4TrackStack* aStack);
+
+    inline G4int GetNTrack() const { return nTracks; }
+    inline G4int GetMaxNTrack() const { return maxNTracks; }
+    inline G4bool IsPerRegion() const { return perRegion; }
+
+    void SetSpillThreshold(std::size_t n, const G4String& dir = "");
+      // Set the spill threshold of each bucket (see G4TrackStack)
+
+    void ResetStatistics();
+    void DumpStatistics() const;
+
+  private:
+
+    using BucketKey = std::pair<G4int, G4int>;
+      // particle definition ID and region instance ID (-1 if not used)
+
+    G4TrackStack* SelectBucket();
+
+  private:
+
+    G4bool perRegion;
+    std::map<BucketKey, G4TrackStack*> buckets;
+      // ordered by key, such that the bucket selection does not depend on
+      // the order of creation of buckets
+    BucketKey lastKey;
+    G4TrackStack* lastBucket = nullptr;
+      // bucket of the last pushed track, to skip the look-up for series of
+      // tracks of the same type
+    G4TrackStack* currentBucket = nullptr;
+    G4int nTracks = 0;
+    G4int maxNTracks = 0;
+    std::size_t spillThreshold = 0;
+    G4String spillDir = "";
+
+    // statistics
+    const G4ParticleDefinition* lastPushed = nullptr;
+    const G4ParticleDefinition* lastPopped = nullptr;
+    G4long nPushed = 0;
+    G4long nPopped = 0;
+    G4long nPushedChanges = 0;
+    G4long nPoppedChanges = 0;
+    G4long nBucketSwitches = 0;
+};
+
+#endif
@@ -46,7 +46,14 @@ enum G4ClassificationOfNewTrack
   // number of waiting stacks
   //----------------------------------------------------------------
   fWaiting_1=11, fWaiting_2=12, fWaiting_3=13, fWaiting_4=14, fWaiting_5=15,
-  fWaiting_6=16, fWaiting_7=17, fWaiting_8=18, fWaiting_9=19, fWaiting_10=20
+  fWaiting_6=16, fWaiting_7=17, fWaiting_8=18, fWaiting_9=19, fWaiting_10=20,
+  //----------------------------------------------------------------
+  // following ENUM are available only if the user registers the
+  // corresponding sub-event type to G4StackManager
+  //----------------------------------------------------------------
+  fSubEvent_0=100, fSubEvent_1=101, fSubEvent_2=102, fSubEvent_3=103,
+  fSubEvent_4=104, fSubEvent_5=105, fSubEvent_6=106, fSubEvent_7=107,
+  fSubEvent_8=108, fSubEvent_9=109
 };
 
 #endif
@@ -32,6 +32,8 @@
 //     /event/
 //     /event/abort
 //     /event/verbose
+//     /event/keepCurrentEvent
+//     /event/useArena
 
 // Author: M.Asai, SLAC
 // --------------------------------------------------------------------
@@ -44,6 +46,7 @@ class G4EventManager;
 class G4UIdirectory;
 class G4UIcmdWithoutParameter;
 class G4UIcmdWithAnInteger;
+class G4UIcmdWithABool;
 
 class G4EvManMessenger : public G4UImessenger
 {
@@ -61,6 +64,7 @@ class G4EvManMessenger : public G4UImessenger
     G4UIcmdWithoutParameter* abortCmd = nullptr;
     G4UIcmdWithAnInteger* verboseCmd = nullptr;
     G4UIcmdWithoutParameter* storeEvtCmd = nullptr;
+    G4UIcmdWithABool* useArenaCmd = nullptr;
 };
 
 #endif
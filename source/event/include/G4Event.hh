@@ -164,6 +164,15 @@ class G4Event
       // of this event), and G4TrajectoryContainer (trajectory coonainer),
       // respectively.
 
+    G4int MergeSubEventResults(const G4Event* subEvent);
+      //  Merge the hits collections of a sub-event (see G4SubEvent) into
+      // the hits collections of this event. Only collections of type
+      // G4THitsMap<G4double>, G4THitsMap<G4int> and G4THitsMap<G4StatDouble>
+      // (e.g. those of primitive scorers and scoring meshes) are merged
+      // here; other hits collections have to be merged by
+      // G4UserEventAction::MergeSubEventResults(). Returns the number of
+      // non-empty collections of the sub-event which were not merged.
+
     inline G4bool IsAborted() const { return eventAborted; }
       //  Return a boolean which indicates the event has been aborted and thus
       // it should not be used for analysis.
@@ -52,11 +52,18 @@ class G4SDManager;
 class G4StateManager;
 #include "globals.hh"
 class G4VUserEventInformation;
+class G4SubEvent;
+class G4EventArena;
+
+#include <cstdint>
+#include <functional>
+#include <vector>
 
 class G4EventManager 
 {
  public:
   using ProfilerConfig = G4ProfilerConfig<G4ProfileType::Event>;
+  using SubEventDispatcher = std::function<G4bool(G4SubEvent*)>;
 
  public:
     static G4EventManager* GetEventManager();
@@ -92,6 +99,48 @@ class G4EventManager
       // Helper function to stack a vector of tracks for processing in the
       // current event.
 
+    void ProcessSubEvent(G4SubEvent* subEvent);
+      // This is the entry for a thread which processes a sub-event detached
+      // from an event of another thread. If the sub-event has not already
+      // been taken back by its owner, its tracks are processed into a
+      // temporary G4Event object, which is handed back to the owner for
+      // merging. User's event action is not invoked for a sub-event.
+      // The state of the random number engine and the track ID counter of
+      // this thread are restored afterwards, so that its own events do not
+      // depend on the sub-events it processed.
+      // The reference of the caller to the sub-event is released.
+
+    void SpawnSubEvent(G4int ty, G4TrackStack* subEventStack);
+      // Detach all tracks of the given stack from the current event as a
+      // new G4SubEvent and pass it to the sub-event dispatcher, if any.
+      // This method is invoked by G4StackManager.
+      // All sub-events are completed and merged before the user's
+      // EndOfEventAction() is invoked: sub-events which have not been taken
+      // by another thread are processed by this thread itself, and hits
+      // collections of the others are merged into the current event
+      // (see G4Event::MergeSubEventResults() and
+      // G4UserEventAction::MergeSubEventResults()). Each sub-event is
+      // processed with its own random number seeds, derived from the
+      // state of the engine at the start of the event and from the index
+      // of the sub-event without drawing numbers, and its new tracks get
+      // IDs from a range of their own (see G4SubEvent). Thus results do
+      // not depend on which thread processes it, and spawning does not
+      // change the rest of the event. Trajectories of sub-events processed
+      // by another thread are not kept.
+
+    inline void SetSubEventDispatcher(SubEventDispatcher f)
+      { subEventDispatcher = f; }
+      // Set the function used to offer a new sub-event to other threads.
+      // It returns false if the sub-event could not be offered, in which
+      // case it is processed by this thread at the end of the event.
+
+    void CleanUpSubEvents();
+      // Delete the temporary G4Event objects of the sub-events processed by
+      // this thread, once they have been merged by their owner.
+
+    inline void RegisterSubEventType(G4int ty, G4int maxEnt)
+      { trackContainer->RegisterSubEventType(ty, maxEnt); }
+
     inline const G4Event* GetConstCurrentEvent()
       { return currentEvent; }
     inline G4Event* GetNonconstCurrentEvent()
@@ -157,9 +206,22 @@ class G4EventManager
     inline void StoreRandomNumberStatusToG4Event(G4int vl)
       { storetRandomNumberStatusToG4Event = vl; }
 
+    inline void UseEventArena(G4bool val) { useArena = val; }
+    inline G4bool IsEventArenaUsed() const { return useArena; }
+    inline const G4EventArena* GetEventArena() const { return arena; }
+      // If set, G4Track and G4DynamicParticle objects created during an
+      // event are allocated in a per-thread G4EventArena which is released
+      // at once at the end of the event. Such objects must not be kept
+      // beyond the end of the event.
+
   private:
 
-    void DoProcessing(G4Event* anEvent);
+    void DoProcessing(G4Event* anEvent,
+                      G4TrackVector* subEventTracks = nullptr);
+      // With sub-event tracks, they are stacked in place of the primaries
+      // and the event is processed as a sub-event
+    void ProcessStackedTracks();
+    void ProcessSubEvents();
   
   private:
 
@@ -176,6 +238,8 @@ class G4EventManager
     G4PrimaryTransformer* transformer = nullptr;
     G4bool tracking = false;
     G4bool abortRequested = false;
+    G4bool useArena = false;
+    G4EventArena* arena = nullptr;
 
     G4EvManMessenger* theMessenger = nullptr;
 
@@ -189,6 +253,12 @@ class G4EventManager
 
     G4StateManager* stateManager = nullptr;
 
+    SubEventDispatcher subEventDispatcher;
+    std::vector<G4SubEvent*> spawnedSubEvents;
+    std::vector<G4SubEvent*> processedSubEvents;
+    G4int nSubEvents = 0;
+    std::uint64_t subEventSeedKey = 0;
+
  private:
   std::unique_ptr<ProfilerConfig> eventProfiler;
 };
@@ -59,6 +59,13 @@
 // The position and time of the primary interaction must be set by the
 // corresponding set methods of G4VPrimaryGenerator base class, otherwise
 // zero will be set.
+//
+// If "prefetch" is set in the constructor, the file is read through the
+// G4HEPEvtReader shared by all threads: events are parsed in advance by
+// a background thread, each event is given the record matching its
+// event ID whatever the thread processing it, and the compact binary
+// format described in G4HEPEvtReader.hh is accepted as well as the
+// ASCII one.
 
 // Author: Makoto Asai, 1997
 // --------------------------------------------------------------------
@@ -71,6 +78,7 @@
 #include "globals.hh"
 #include "G4VPrimaryGenerator.hh"
 #include "G4HEPEvtParticle.hh"
+#include "G4HEPEvtReader.hh"
 
 class G4PrimaryVertex;
 class G4Event;
@@ -79,20 +87,31 @@ class G4HEPEvtInterface : public G4VPrimaryGenerator
 {
   public:
 
-    G4HEPEvtInterface(const char* evfile, G4int vl=0);
+    G4HEPEvtInterface(const char* evfile, G4int vl=0,
+                      G4bool prefetch=false);
     // Constructor, "evfile" is the file name (with directory path).
+    // With "prefetch", the events are taken from the G4HEPEvtReader of
+    // the file, shared by the interfaces of all threads.
   
     ~G4HEPEvtInterface();
     // Destructor
 
     void GeneratePrimaryVertex(G4Event* evt);
 
+  private:
+
+    G4bool ReadEvent(G4int eventID);
+    // Fills HPlist with the particles of the next event. With the shared
+    // reader, this is the record of the given event (see G4HEPEvtReader)
+
   private:
 
     G4int vLevel = 0;
     G4String fileName;
     std::ifstream inputFile;
     std::vector<G4HEPEvtParticle*> HPlist;
+    G4HEPEvtReader* reader = nullptr;
+    std::vector<G4HEPEvtReader::Entry> entries;
 };
 
 #endif
@@ -0,0 +1,148 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4HEPEvtReader
+//
+// Class description:
+//
+// Reader of HEPEvt files shared by the G4HEPEvtInterface objects of all
+// threads (see G4HEPEvtInterface(evfile, vl, prefetch)).
+// In multi-threaded builds, the file is parsed by a background thread
+// into a buffer of events, from which worker threads take events. The
+// buffer holds plain particle records: the G4PrimaryParticle and
+// G4PrimaryVertex objects are created by the worker, as they are
+// allocated by thread-local allocators. In sequential builds events are
+// parsed on demand.
+// Records are tied to event IDs, not to the order in which threads ask
+// for them: the event with ID n of a run is given the n-th record after
+// those of the previous runs, whatever the thread processing it. Runs are
+// followed through the application state of the threads using the
+// reader; records of a run which are not asked for are skipped.
+//
+// Two input formats are accepted:
+//  - the ASCII format described in G4HEPEvtInterface.hh;
+//  - a compact binary format, recognised by its leading 8 bytes
+//    "G4HEPEVB", followed for each event by NHEP (int32) and NHEP records
+//    of ISTHEP, IDHEP, JDAHEP1, JDAHEP2 (int32) and PHEP1, PHEP2, PHEP3,
+//    PHEP5 (double, GeV), in native byte order. Such a file can be
+//    written from an ASCII one with ConvertToBinary().
+// --------------------------------------------------------------------
+#ifndef G4HEPEvtReader_hh
+#define G4HEPEvtReader_hh 1
+
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <vector>
+
+#include "globals.hh"
+#include "G4Threading.hh"
+
+class G4HEPEvtReader
+{
+  public:
+
+    struct Entry
+    {
+      std::int32_t ISTHEP;  // status code
+      std::int32_t IDHEP;   // PDG code
+      std::int32_t JDAHEP1; // first daughter
+      std::int32_t JDAHEP2; // last daughter
+      G4double PHEP1;       // px in GeV
+      G4double PHEP2;       // py in GeV
+      G4double PHEP3;       // pz in GeV
+      G4double PHEP5;       // mass in GeV
+    };
+
+    static G4HEPEvtReader* GetReader(const G4String& fileName,
+                                     std::size_t bufferSize = 256);
+      // Returns the reader of the given file, created at the first call.
+      // "bufferSize" is the number of events parsed in advance.
+
+    static G4bool ConvertToBinary(const G4String& asciiFile,
+                                  const G4String& binaryFile);
+      // Writes the events of an ASCII HEPEvt file in the binary format
+
+   ~G4HEPEvtReader();
+
+    G4HEPEvtReader(const G4HEPEvtReader&) = delete;
+    G4HEPEvtReader& operator=(const G4HEPEvtReader&) = delete;
+
+    G4bool NextEvent(G4int eventID, std::vector<Entry>& entries);
+      // Moves the particles of the record of the given event of the
+      // current run into "entries". Returns false at the end of the file.
+
+    inline const G4String& GetFileName() const { return fileName; }
+    inline G4bool IsBinary() const { return binary; }
+
+  private:
+
+    G4HEPEvtReader(const G4String& fileName, std::size_t bufferSize);
+
+    G4bool ReadEvent(std::vector<Entry>& entries);
+      // Parses the next event of the file
+    void Prefetch();
+      // Loop of the background thread
+    void BeginOfRun();
+    void EndOfRun();
+      // Invoked at the start and at the end of a run of each thread using
+      // the reader. A new run starts when no thread is in a run.
+
+    friend class G4HEPEvtRunObserver;
+
+  private:
+
+    struct Record
+    {
+      G4bool taken = false;
+      std::vector<Entry> entries;
+    };
+
+    G4String fileName;
+    std::ifstream inputFile;
+    G4bool binary = false;
+    G4bool badEvent = false;
+
+    std::size_t bufferSize = 0;
+    std::deque<Record> buffer;
+      // records from index "first" on, parsed and not yet released
+    std::size_t first = 0;
+    std::size_t wanted = 0;
+      // index of the furthest record asked for
+    std::size_t runBase = 0;
+      // index of the record of event 0 of the current run
+    std::size_t runEnd = 0;
+      // runBase plus the largest event ID given in the current run, plus 1
+    G4int nThreadsInRun = 0;
+    G4bool finished = false;
+    G4bool stop = false;
+    G4Mutex bufferMutex;
+    G4Condition bufferChanged;
+#ifdef G4MULTITHREADED
+    G4Thread* prefetcher = nullptr;
+#endif
+};
+
+#endif
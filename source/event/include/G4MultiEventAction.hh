@@ -63,6 +63,7 @@ class G4MultiEventAction : public G4UserEventAction
     virtual void SetEventManager(G4EventManager* ) override;
     virtual void BeginOfEventAction(const G4Event* ) override;
     virtual void EndOfEventAction(const G4Event* ) override;
+    virtual G4bool MergeSubEventResults(G4Event*, const G4Event* ) override;
 };
 
 #endif
@@ -0,0 +1,84 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4SPSAliasTable
+//
+// Class Description:
+//
+// Alias table (Walker/Vose method) used by the SPS distributions to
+// sample a bin of a cumulative histogram (IPDF) in constant time, in
+// place of a search over the cumulative values.
+// The table is built from a G4PhysicsFreeVector holding the normalised
+// cumulative values at the bin edges, as built by the SPS classes. The
+// first node holds a point mass at the lowest edge, bin i > 0 covers
+// the range between edges i-1 and i. Within a bin the values are
+// uniformly distributed, which reproduces the linear interpolation of
+// G4PhysicsVector::GetEnergy() on the cumulative histogram.
+// Sampling uses a single flat random number and does not modify the
+// table, which can then be shared by threads once built.
+// --------------------------------------------------------------------
+#ifndef G4SPSAliasTable_hh
+#define G4SPSAliasTable_hh 1
+
+#include <vector>
+
+#include "G4PhysicsVector.hh"
+#include "globals.hh"
+
+class G4SPSAliasTable
+{
+  public:
+
+    G4SPSAliasTable() = default;
+   ~G4SPSAliasTable() = default;
+
+    void Build(const G4PhysicsVector& ipdf);
+      // Builds the table from a cumulative histogram
+    void Clear();
+
+    inline G4bool IsEmpty() const { return prob.empty(); }
+
+    std::size_t SampleBin(G4double rndm, G4double& frac) const;
+      // Returns the bin for a flat random number in [0,1[, and in "frac"
+      // the position in [0,1[ within the bin
+    G4double Sample(G4double rndm) const;
+      // Returns a value distributed as the histogram
+
+    inline G4double GetLowEdge(std::size_t bin) const
+      { return (bin > 0) ? edges[bin - 1] : edges[0]; }
+    inline G4double GetHighEdge(std::size_t bin) const
+      { return edges[bin]; }
+    inline G4double GetBinProbability(std::size_t bin) const
+      { return binProb[bin]; }
+
+  private:
+
+    std::vector<G4double> edges;
+    std::vector<G4double> binProb;
+    std::vector<G4double> prob;
+    std::vector<std::size_t> alias;
+};
+
+#endif
@@ -66,6 +66,7 @@
 #include <vector>
 
 #include "G4SPSRandomGenerator.hh"
+#include "G4SPSAliasTable.hh"
 
 class G4SPSEneDistribution
 {
@@ -217,6 +218,7 @@ class G4SPSEneDistribution
     void GenerateCdgEnergies();
     void GenUserHistEnergies();
     void GenEpnHistEnergies();
+    G4double SampleUserHist(); // samples IPDFEnergyH
     void GenArbPointEnergies(); // NOTE: REQUIRES UPDATE OF DATA MEMBERS
     void GenerateExpEnergies(G4bool);
     void GenerateLinearEnergies(G4bool);
@@ -251,6 +253,8 @@ class G4SPSEneDistribution
     G4bool IPDFEnergyExist = false, IPDFArbExist = false, Epnflag = false;
     G4PhysicsFreeVector ArbEnergyH; // Arb x,y histogram
     G4PhysicsFreeVector IPDFArbEnergyH; // IPDF for Arb
+    G4SPSAliasTable EnergyAlias; // alias table of IPDFEnergyH
+    G4SPSAliasTable ArbEnergyAlias; // alias table of IPDFArbEnergyH
     G4PhysicsFreeVector EpnEnergyH;
     G4double CDGhist[3]; // cumulative histo for cdg
     
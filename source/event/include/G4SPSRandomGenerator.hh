@@ -56,6 +56,7 @@
 #include "G4ThreeVector.hh"
 #include "G4Threading.hh"
 #include "G4Cache.hh"
+#include "G4SPSAliasTable.hh"
 
 class G4SPSRandomGenerator
 {
@@ -132,6 +133,9 @@ class G4SPSRandomGenerator
     G4double GetBiasWeight() const ;
       // Returns the weight change after biasing
 
+    inline G4bool IsEnergyBiased() const { return EnergyBias; }
+      // If not, GenRandEnergy() returns a flat random number
+
         // method to re-set the histograms
     void ReSetHist(const G4String&);
       // Resets the histogram for user defined distribution
@@ -139,6 +143,13 @@ class G4SPSRandomGenerator
     void SetVerbosity(G4int a);
       // Sets the verbosity level
 
+  private:
+
+    G4double GenBiasedRand(const G4SPSAliasTable& table,
+                           G4double& weight) const;
+      // Samples a biasing histogram with its alias table and sets the
+      // corresponding weight
+
   private:
 
     // Encapsulate in a struct to guarantee that correct
@@ -156,34 +167,42 @@ class G4SPSRandomGenerator
     G4bool XBias, IPDFXBias;
     G4PhysicsFreeVector XBiasH;
     G4PhysicsFreeVector IPDFXBiasH;
+    G4SPSAliasTable XBiasAlias;
     G4Cache<a_check> local_IPDFYBias;
     G4bool YBias, IPDFYBias;
     G4PhysicsFreeVector YBiasH;
     G4PhysicsFreeVector IPDFYBiasH;
+    G4SPSAliasTable YBiasAlias;
     G4Cache<a_check> local_IPDFZBias;
     G4bool ZBias, IPDFZBias;
     G4PhysicsFreeVector ZBiasH;
     G4PhysicsFreeVector IPDFZBiasH;
+    G4SPSAliasTable ZBiasAlias;
     G4Cache<a_check> local_IPDFThetaBias;
     G4bool ThetaBias, IPDFThetaBias;
     G4PhysicsFreeVector ThetaBiasH;
     G4PhysicsFreeVector IPDFThetaBiasH;
+    G4SPSAliasTable ThetaBiasAlias;
     G4Cache<a_check> local_IPDFPhiBias;
     G4bool PhiBias, IPDFPhiBias;
     G4PhysicsFreeVector PhiBiasH;
     G4PhysicsFreeVector IPDFPhiBiasH;
+    G4SPSAliasTable PhiBiasAlias;
     G4Cache<a_check> local_IPDFEnergyBias;
     G4bool EnergyBias, IPDFEnergyBias;
     G4PhysicsFreeVector EnergyBiasH;
     G4PhysicsFreeVector IPDFEnergyBiasH;
+    G4SPSAliasTable EnergyBiasAlias;
     G4Cache<a_check> local_IPDFPosThetaBias;
     G4bool PosThetaBias, IPDFPosThetaBias;
     G4PhysicsFreeVector PosThetaBiasH;
     G4PhysicsFreeVector IPDFPosThetaBiasH;
+    G4SPSAliasTable PosThetaBiasAlias;
     G4Cache<a_check> local_IPDFPosPhiBias;
     G4bool PosPhiBias, IPDFPosPhiBias;
     G4PhysicsFreeVector PosPhiBiasH;
     G4PhysicsFreeVector IPDFPosPhiBiasH;
+    G4SPSAliasTable PosPhiBiasAlias;
 
     struct bweights_t
     {
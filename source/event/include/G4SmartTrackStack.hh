@@ -56,6 +56,8 @@ class G4SmartTrackStack
     void clearAndDestroy();
     void TransferTo(G4TrackStack* aStack);
     G4double getEnergyOfStack(G4TrackStack* aTrackStack);
+    void SetSpillThreshold(std::size_t n, const G4String& dir = "");
+      // Set the spill threshold of each dedicated stack (see G4TrackStack)
     void dumpStatistics();
 
     inline G4int GetNTrack() const { return nTracks; }
@@ -36,6 +36,9 @@
 // G4StackManager has three stacks, the urgent stack, the
 // waiting stack, and the postpone to next event stack. The meanings
 // of each stack is descrived in the Geant4 User's Manual.
+// Optionally, tracks can be collected in sub-event stacks and detached
+// from the event as G4SubEvent objects (see RegisterSubEventType()), and
+// urgent tracks can be grouped by particle type (see SetBucketing()).
 
 // Author: Makoto Asai, 1996
 //
@@ -50,6 +53,7 @@
 #include "G4StackedTrack.hh"
 #include "G4TrackStack.hh"
 #include "G4SmartTrackStack.hh"
+#include "G4BucketedTrackStack.hh"
 #include "G4ClassificationOfNewTrack.hh"
 #include "G4Track.hh"
 #include "G4TrackStatus.hh"
@@ -91,6 +95,50 @@ class G4StackManager
       // The user should invoke G4RunManager::SetNumberOfAdditionalWaitingStacks
       // method, which invokes this method.
 
+    void RegisterSubEventType(G4int ty, G4int maxEnt);
+      // Register the sub-event type "ty" (0 to 9). Once registered, the
+      // user can use the corresponding fSubEvent_<ty> ENUM of
+      // G4ClassificationOfNewTrack. Tracks of such classification are
+      // collected in a dedicated stack and, each time "maxEnt" tracks are
+      // collected, they are detached from this event as a G4SubEvent which
+      // may be processed by another thread (see G4EventManager). The
+      // remaining tracks are detached at the end of the event.
+      // This method must be invoked at PreInit, Init or Idle states.
+
+    void ReleaseSubEvents();
+      // Detach all tracks remaining in the sub-event stacks.
+      // This method is invoked by G4EventManager at the end of an event.
+
+    inline void SetSubEventProcessing(G4bool val)
+      { subEventProcessing = val; }
+    inline G4bool IsSubEventProcessing() const
+      { return subEventProcessing; }
+    inline G4bool HasSubEventTypes() const
+      { return !subEventStacks.empty(); }
+      // While a sub-event is being processed, tracks classified to any
+      // sub-event type are sent to the urgent stack, i.e. a sub-event does
+      // not spawn sub-events.
+
+    void SetBucketing(G4int mode);
+      // Set the policy of the urgent stack.
+      //  0 : ordinary LIFO stack (default)
+      //  1 : tracks are grouped by particle type and one group is
+      //      processed at a time (see G4BucketedTrackStack)
+      //  2 : as 1, tracks being grouped by particle type and region
+      // The classification by the user stacking action is not affected.
+      // This method must be invoked at PreInit or Idle states.
+    G4int GetBucketing() const;
+    void DumpBucketStatistics() const;
+
+    void SetSpillThreshold(G4int nTrack, const G4String& dir = "");
+      // Maximum number of tracks kept in memory by each urgent and waiting
+      // stack. Beyond it, the oldest tracks are written to a temporary
+      // file in "dir" (default temporary directory if empty) and read back
+      // when the tracks in memory are exhausted (see G4TrackStack).
+      // Zero (default) disables spilling.
+    inline G4int GetSpillThreshold() const { return spillThreshold; }
+    G4int GetNSpilledTrack() const;
+
     void TransferStackedTracks(G4ClassificationOfNewTrack origin,
                                G4ClassificationOfNewTrack destination);
       // Transfer all stacked tracks from the origin stack to the
@@ -115,12 +163,23 @@ class G4StackManager
     G4int GetNUrgentTrack() const;
     G4int GetNWaitingTrack(G4int i=0) const;
     G4int GetNPostponedTrack() const;
+    G4int GetNSubEventTrack() const;
     void SetVerboseLevel( G4int const value );
     void SetUserStackingAction(G4UserStackingAction* value);
 
   private:
 
     G4ClassificationOfNewTrack DefaultClassification(G4Track* aTrack);
+    void PushToSubEventStack(G4ClassificationOfNewTrack classification,
+                             const G4StackedTrack& aStackedTrack,
+                             const char* origin);
+    void ReleaseSubEvent(G4int ty);
+
+    inline void PushToUrgentStack(const G4StackedTrack& aStackedTrack);
+    inline G4StackedTrack PopFromUrgentStack();
+    inline void TransferToUrgentStack(G4TrackStack* aStack);
+    inline void TransferFromUrgentStack(G4TrackStack* aStack);
+    inline void ClearAndDestroyUrgentStack();
 
   private:
 
@@ -131,11 +190,53 @@ class G4StackManager
 #else
     G4TrackStack* urgentStack = nullptr;
 #endif
+    G4BucketedTrackStack* bucketedStack = nullptr;
+      // replaces the urgent stack if bucketing is enabled
     G4TrackStack* waitingStack = nullptr;
     G4TrackStack* postponeStack = nullptr;
     G4StackingMessenger* theMessenger = nullptr;
     std::vector<G4TrackStack*> additionalWaitingStacks;
     G4int numberOfAdditionalWaitingStacks = 0;
+    G4int spillThreshold = 0;
+    G4String spillDir = "";
+    std::vector<G4TrackStack*> subEventStacks;
+    std::vector<G4int> subEventMaxEntries;
+    G4bool subEventProcessing = false;
 };
 
+// ------------------------
+// Inline methods
+// ------------------------
+
+inline void
+G4StackManager::PushToUrgentStack(const G4StackedTrack& aStackedTrack)
+{
+  if(bucketedStack != nullptr) { bucketedStack->PushToStack(aStackedTrack); }
+  else                         { urgentStack->PushToStack(aStackedTrack); }
+}
+
+inline G4StackedTrack G4StackManager::PopFromUrgentStack()
+{
+  if(bucketedStack != nullptr) { return bucketedStack->PopFromStack(); }
+  return urgentStack->PopFromStack();
+}
+
+inline void G4StackManager::TransferToUrgentStack(G4TrackStack* aStack)
+{
+  if(bucketedStack != nullptr) { aStack->TransferTo(bucketedStack); }
+  else                         { aStack->TransferTo(urgentStack); }
+}
+
+inline void G4StackManager::TransferFromUrgentStack(G4TrackStack* aStack)
+{
+  if(bucketedStack != nullptr) { bucketedStack->TransferTo(aStack); }
+  else                         { urgentStack->TransferTo(aStack); }
+}
+
+inline void G4StackManager::ClearAndDestroyUrgentStack()
+{
+  if(bucketedStack != nullptr) { bucketedStack->clearAndDestroy(); }
+  urgentStack->clearAndDestroy();
+}
+
 #endif
@@ -0,0 +1,176 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4SubEvent
+//
+// Class description:
+//
+// A G4SubEvent is a batch of tracks of one event which has been detached
+// from the stacks of the G4StackManager owning the event, so that it can
+// be processed by another worker thread (sub-event parallelism).
+// Tracks are stored in a compact, thread-agnostic form: the original
+// G4Track objects are deleted by the owning thread and new ones are
+// created by the thread that processes the sub-event.
+//
+// A G4SubEvent is shared between two parties: the G4EventManager of the
+// thread owning the event, and the thread which processes the sub-event.
+// The hand-shake between them is the following:
+//  - the owner creates the sub-event and offers it (see Retain()) to a
+//    dispatcher, e.g. the task queue of G4TaskRunManager;
+//  - a processing thread calls Claim(). If it succeeds, it processes
+//    the tracks into its own G4Event and hands it over with SetProcessed();
+//  - at the end of the event the owner calls Reclaim() for each sub-event.
+//    If it succeeds, the sub-event was not started elsewhere and the owner
+//    processes it itself; otherwise it waits with WaitForResult(), merges
+//    the results and calls SetMerged();
+//  - the result G4Event must be deleted by the thread which created it,
+//    only once IsMerged() is true;
+//  - each party calls Release() when done. The object deletes itself
+//    when the last reference is released.
+// --------------------------------------------------------------------
+#ifndef G4SubEvent_hh
+#define G4SubEvent_hh 1
+
+#include <atomic>
+#include <vector>
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4Threading.hh"
+#include "G4TrackVector.hh"
+
+class G4Event;
+class G4Track;
+class G4ParticleDefinition;
+class G4PrimaryParticle;
+class G4VProcess;
+class G4LogicalVolume;
+class G4VUserTrackInformation;
+
+class G4SubEvent
+{
+  public:
+
+    G4SubEvent(G4int evID, G4int subEvtType, G4long s1, G4long s2,
+               G4int idOffset);
+   ~G4SubEvent();
+
+    G4SubEvent(const G4SubEvent&) = delete;
+    G4SubEvent& operator=(const G4SubEvent&) = delete;
+
+    void StoreTrack(const G4Track* aTrack);
+      // Copy the state of a G4Track into this sub-event. The user track
+      // information is moved to the sub-event; the track itself is not
+      // deleted by this method.
+    G4TrackVector* GimmeTracks();
+      // Create G4Track objects of the stored tracks. Tracks are allocated
+      // by the calling thread. Ownership of the vector and of the tracks
+      // is passed to the caller.
+
+    inline std::size_t GetNTrack() const { return tracks.size(); }
+    inline G4int GetEventID() const { return eventID; }
+    inline G4int GetSubEventType() const { return subEventType; }
+    inline void GetSeeds(long* seeds) const
+      { seeds[0] = seed1; seeds[1] = seed2; seeds[2] = 0; }
+    inline G4int GetTrackIDOffset() const { return trackIDOffset; }
+      // Tracks created while processing this sub-event get IDs above
+      // this offset, whichever thread processes it
+
+    static constexpr G4int kTrackIDBase = 1 << 30;
+    static constexpr G4int kTrackIDRange = 1 << 20;
+    static constexpr G4int kMaxSubEvents = (1 << 10) - 1;
+      // The n-th sub-event of an event has the offset
+      // kTrackIDBase + n*kTrackIDRange, above the IDs of the tracks of
+      // the event itself; at most kMaxSubEvents get distinct ranges
+
+    // Hand-shake between the owner and the processing thread
+    G4bool Claim();
+    G4bool Reclaim();
+    void SetProcessed(G4Event* aResult);
+    G4Event* WaitForResult();
+    inline G4Event* GetResult() const { return result; }
+    inline void SetMerged() { merged = true; }
+    inline G4bool IsMerged() const { return merged; }
+
+    inline void Retain() { ++refCount; }
+    void Release();
+
+  private:
+
+    enum SubEventStatus { fPending, fProcessing, fProcessed, fReclaimed };
+
+    struct StoredTrack
+    {
+      const G4ParticleDefinition* particle = nullptr;
+      G4ThreeVector momentumDirection;
+      G4ThreeVector polarization;
+      G4double kineticEnergy = 0.;
+      G4double mass = 0.;
+      G4double charge = 0.;
+      G4double magneticMoment = 0.;
+      G4double dynamicProperTime = 0.;
+      G4PrimaryParticle* primaryParticle = nullptr;
+      G4int pdgCode = 0;
+
+      G4ThreeVector position;
+      G4double globalTime = 0.;
+      G4double localTime = 0.;
+      G4double properTime = 0.;
+      G4double weight = 1.;
+      G4int trackID = 0;
+      G4int parentID = 0;
+      const G4VProcess* creatorProcess = nullptr;
+      G4int creatorModelID = -1;
+      G4ThreeVector vertexPosition;
+      G4ThreeVector vertexMomentumDirection;
+      G4double vertexKineticEnergy = 0.;
+      const G4LogicalVolume* vertexVolume = nullptr;
+      G4VUserTrackInformation* userInfo = nullptr;
+    };
+
+    static const G4VProcess* GetSharedProcess(const G4VProcess* proc);
+    static const G4VProcess* GetLocalProcess(const G4VProcess* sharedProc);
+      // Creator processes are thread-local objects. They are stored through
+      // the corresponding process of the master thread and translated back
+      // to the process instance of the thread which creates the G4Track.
+
+  private:
+
+    G4int eventID = 0;
+    G4int subEventType = 0;
+    G4long seed1 = 0;
+    G4long seed2 = 0;
+    G4int trackIDOffset = 0;
+    std::vector<StoredTrack> tracks;
+
+    std::atomic<G4int> status{fPending};
+    std::atomic<G4int> refCount{1};
+    std::atomic<G4bool> merged{false};
+    G4Event* result = nullptr;
+    G4Mutex resultMutex;
+    G4Condition resultReady;
+};
+
+#endif
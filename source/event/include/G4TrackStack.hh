@@ -28,18 +28,34 @@
 // This is a stack class used by G4StackManager. This class object
 // stores G4StackedTrack class objects in the form of bi-directional
 // linked list.
+// Optionally (see SetSpillThreshold()), once the number of tracks in
+// memory reaches a threshold, the oldest half of them is written in a
+// compact form to a temporary file and the G4Track objects are deleted.
+// Only plain data are written: particles, processes and volumes are
+// replaced by indices to a table kept in memory, and the primary
+// particle, user information and trajectory of a spilled track are kept
+// in memory with its position in the block, as are the tracks which
+// cannot be spilled. Spilled tracks are read back, most recent block
+// first and in their original order, when the tracks in memory are
+// exhausted, so that the LIFO order is kept.
 
 // Author: Makoto Asai (SLAC) - 09/Dec/96
 // --------------------------------------------------------------------
 #ifndef G4TrackStack_hh
 #define G4TrackStack_hh 1
 
+#include <cstdio>
+#include <unordered_map>
 #include <vector>
 
 #include "G4StackedTrack.hh"
 #include "G4Types.hh"
+#include "G4String.hh"
 
 class G4SmartTrackStack;
+class G4BucketedTrackStack;
+class G4PrimaryParticle;
+class G4VUserTrackInformation;
 
 class G4TrackStack : public std::vector<G4StackedTrack>
 {
@@ -52,20 +68,37 @@ class G4TrackStack : public std::vector<G4StackedTrack>
         safetyValue2(G4int(4*n/5-100)), nstick(100) { reserve(n); }
    ~G4TrackStack();
   
+    G4TrackStack(const G4TrackStack&) = delete;
     G4TrackStack& operator=(const G4TrackStack&) = delete;
     G4bool operator==(const G4TrackStack&) const = delete;
     G4bool operator!=(const G4TrackStack&) const = delete;
   
     inline void PushToStack(const G4StackedTrack& aStackedTrack)
-      { push_back(aStackedTrack); }
+    {
+      push_back(aStackedTrack);
+      if(spillMark > 0 && size() >= spillMark) { SpillToFile(); }
+    }
     inline G4StackedTrack PopFromStack()
-      { G4StackedTrack st = back(); pop_back(); return st; }
+    {
+      if(empty() && !spilledBlocks.empty()) { RestoreFromFile(); }
+      G4StackedTrack st = back(); pop_back(); return st;
+    }
     void TransferTo(G4TrackStack* aStack);
     void TransferTo(G4SmartTrackStack* aStack);
+    void TransferTo(G4BucketedTrackStack* aStack);
   
+    void clear();
     void clearAndDestroy();
 
-    inline std::size_t GetNTrack() const { return size(); }
+    void SetSpillThreshold(std::size_t n, const G4String& dir = "");
+      // Maximum number of tracks kept in memory. Zero (default) disables
+      // spilling. Spilled tracks are written to an anonymous temporary
+      // file in the directory "dir", or in the default temporary directory
+      // if "dir" is empty.
+    inline std::size_t GetSpillThreshold() const { return spillThreshold; }
+    inline std::size_t GetNSpilledTrack() const { return nSpilled; }
+
+    inline std::size_t GetNTrack() const { return size() + nSpilled; }
     inline std::size_t GetMaxNTrack() const { return max_size(); }
     inline G4int GetSafetyValue1() const { return safetyValue1; }
     inline G4int GetSafetyValue2() const { return safetyValue2; }
@@ -74,11 +107,50 @@ class G4TrackStack : public std::vector<G4StackedTrack>
     G4double getTotalEnergy(void) const;
     inline void SetSafetyValue2(G4int x) { safetyValue2 = x  < 0 ? 0 : x; }
   
+  private:
+
+    void SpillToFile();
+    void RestoreFromFile();
+    void ReadBlock(std::size_t iBlock, std::vector<G4StackedTrack>& tracks);
+    void DiscardSpilledTracks();
+    G4int GetSpilledPointerIndex(const void* ptr);
+      // Index of the pointer in spilledPointers, -1 for nullptr
+
   private:
 
     G4int safetyValue1;
     G4int safetyValue2;
     G4int nstick;
+
+    struct SpilledTrackRefs
+    {
+      G4PrimaryParticle* primaryParticle;
+      G4VUserTrackInformation* userInfo;
+      G4VTrajectory* trajectory;
+    };
+
+    struct SpilledBlock
+    {
+      long offset;
+      std::size_t nTrack;
+        // number of tracks written to the file
+      G4double energy;
+      std::vector<std::pair<std::size_t, G4StackedTrack>> kept;
+        // tracks which could not be spilled, with their position
+      std::unordered_map<std::size_t, SpilledTrackRefs> refs;
+        // objects of the spilled tracks kept in memory, by position
+    };
+
+    std::size_t spillThreshold = 0;
+    std::size_t spillMark = 0;
+      // number of tracks in memory triggering the next spill
+    G4String spillDir = "";
+    std::FILE* spillFile = nullptr;
+    std::vector<SpilledBlock> spilledBlocks;
+    std::size_t nSpilled = 0;
+    std::vector<const void*> spilledPointers;
+    std::unordered_map<const void*, G4int> spilledPointerIndex;
+      // particles, creator processes and vertex volumes of spilled tracks
 };
 
 #endif
@@ -42,6 +42,8 @@
 #ifndef G4UserEventAction_hh
 #define G4UserEventAction_hh 1
 
+#include "globals.hh"
+
 class G4EventManager;
 class G4Event;
 
@@ -57,6 +59,20 @@ class G4UserEventAction
     virtual void EndOfEventAction(const G4Event* anEvent);
       // Two virtual method the user can override.
 
+    virtual G4bool MergeSubEventResults(G4Event* anEvent,
+                                        const G4Event* subEvent);
+      // This method is invoked by G4EventManager, before EndOfEventAction(),
+      // for each sub-event of the current event which has been processed by
+      // another thread (see G4StackManager::RegisterSubEventType()).
+      // "subEvent" holds the hits collections filled by that thread.
+      // Collections of type G4THitsMap<G4double>, G4THitsMap<G4int> and
+      // G4THitsMap<G4StatDouble> are already merged by
+      // G4Event::MergeSubEventResults(); other results have to be merged
+      // into "anEvent" here by the user, who then returns true. Otherwise
+      // G4EventManager warns that they are lost. Note that "subEvent" and
+      // its hits are owned and deleted by the other thread: hits must be
+      // copied, not moved.
+
   protected:
 
       G4EventManager* fpEventManager = nullptr;
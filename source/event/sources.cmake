@@ -6,6 +6,7 @@ geant4_add_module(G4event
     G4AdjointPosOnPhysVolGenerator.hh
     G4AdjointPrimaryGenerator.hh
     G4AdjointStackingAction.hh
+    G4BucketedTrackStack.hh
     G4ClassificationOfNewTrack.hh
     G4EvManMessenger.hh
     G4Event.hh
@@ -15,10 +16,12 @@ geant4_add_module(G4event
     G4GeneralParticleSourceMessenger.hh
     G4HEPEvtInterface.hh
     G4HEPEvtParticle.hh
+    G4HEPEvtReader.hh
     G4ParticleGun.hh
     G4ParticleGunMessenger.hh
     G4PrimaryTransformer.hh
     G4RayShooter.hh
+    G4SPSAliasTable.hh
     G4SPSAngDistribution.hh
     G4SPSEneDistribution.hh
     G4SPSPosDistribution.hh
@@ -29,6 +32,7 @@ geant4_add_module(G4event
     G4StackManager.hh
     G4StackedTrack.hh
     G4StackingMessenger.hh
+    G4SubEvent.hh
     G4TrackStack.hh
     G4TrajectoryContainer.hh
     G4UserEventAction.hh
@@ -41,6 +45,7 @@ geant4_add_module(G4event
     G4AdjointPosOnPhysVolGenerator.cc
     G4AdjointPrimaryGenerator.cc
     G4AdjointStackingAction.cc
+    G4BucketedTrackStack.cc
     G4EvManMessenger.cc
     G4Event.cc
     G4EventManager.cc
@@ -49,10 +54,12 @@ geant4_add_module(G4event
     G4GeneralParticleSourceMessenger.cc
     G4HEPEvtInterface.cc
     G4HEPEvtParticle.cc
+    G4HEPEvtReader.cc
     G4ParticleGun.cc
     G4ParticleGunMessenger.cc
     G4PrimaryTransformer.cc
     G4RayShooter.cc
+    G4SPSAliasTable.cc
     G4SPSAngDistribution.cc
     G4SPSEneDistribution.cc
     G4SPSPosDistribution.cc
@@ -62,6 +69,7 @@ geant4_add_module(G4event
     G4StackChecker.cc
     G4StackManager.cc
     G4StackingMessenger.cc
+    G4SubEvent.cc
     G4TrackStack.cc
     G4TrajectoryContainer.cc
     G4UserEventAction.cc
@@ -0,0 +1,199 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4BucketedTrackStack class implementation
+// --------------------------------------------------------------------
+
+#include "G4BucketedTrackStack.hh"
+#include "G4LogicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Region.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VTrajectory.hh"
+#include "G4ios.hh"
+
+G4BucketedTrackStack::G4BucketedTrackStack(G4bool perReg)
+  : perRegion(perReg), lastKey(-1, -1)
+{
+}
+
+G4BucketedTrackStack::~G4BucketedTrackStack()
+{
+  for(auto& bucket : buckets)
+  {
+    delete bucket.second;
+  }
+}
+
+void G4BucketedTrackStack::PushToStack(const G4StackedTrack& aStackedTrack)
+{
+  const G4Track* aTrack = aStackedTrack.GetTrack();
+  const G4ParticleDefinition* pd = aTrack->GetParticleDefinition();
+
+  BucketKey key(pd->GetParticleDefinitionID(), -1);
+  if(perRegion)
+  {
+    const G4VPhysicalVolume* pv = aTrack->GetVolume();
+    if(pv != nullptr && pv->GetLogicalVolume()->GetRegion() != nullptr)
+    {
+      key.second = pv->GetLogicalVolume()->GetRegion()->GetInstanceID();
+    }
+  }
+
+  if(lastBucket == nullptr || key != lastKey)
+  {
+    auto itr = buckets.find(key);
+    if(itr == buckets.end())
+    {
+      itr = buckets.insert(std::make_pair(key, new G4TrackStack(100))).first;
+      itr->second->SetSpillThreshold(spillThreshold, spillDir);
+    }
+    lastKey = key;
+    lastBucket = itr->second;
+  }
+  lastBucket->PushToStack(aStackedTrack);
+  if(++nTracks > maxNTracks) maxNTracks = nTracks;
+
+  ++nPushed;
+  if(pd != lastPushed)
+  {
+    ++nPushedChanges;
+    lastPushed = pd;
+  }
+}
+
+G4TrackStack* G4BucketedTrackStack::SelectBucket()
+{
+  G4TrackStack* selected = nullptr;
+  std::size_t nMax = 0;
+  for(auto& bucket : buckets)
+  {
+    if(bucket.second->GetNTrack() > nMax)
+    {
+      nMax = bucket.second->GetNTrack();
+      selected = bucket.second;
+    }
+  }
+  return selected;
+}
+
+G4StackedTrack G4BucketedTrackStack::PopFromStack()
+{
+  G4StackedTrack aStackedTrack;
+  if(nTracks == 0) return aStackedTrack;
+
+  if(currentBucket == nullptr || currentBucket->GetNTrack() == 0)
+  {
+    currentBucket = SelectBucket();
+    ++nBucketSwitches;
+  }
+  aStackedTrack = currentBucket->PopFromStack();
+  --nTracks;
+
+  ++nPopped;
+  const G4ParticleDefinition* pd =
+    aStackedTrack.GetTrack()->GetParticleDefinition();
+  if(pd != lastPopped)
+  {
+    ++nPoppedChanges;
+    lastPopped = pd;
+  }
+  return aStackedTrack;
+}
+
+void G4BucketedTrackStack::clear()
+{
+  for(auto& bucket : buckets)
+  {
+    bucket.second->clear();
+  }
+  currentBucket = nullptr;
+  nTracks = 0;
+}
+
+void G4BucketedTrackStack::clearAndDestroy()
+{
+  for(auto& bucket : buckets)
+  {
+    bucket.second->clearAndDestroy();
+  }
+  currentBucket = nullptr;
+  nTracks = 0;
+}
+
+void G4BucketedTrackStack::TransferTo(G4TrackStack* aStack)
+{
+  for(auto& bucket : buckets)
+  {
+    bucket.second->TransferTo(aStack);
+  }
+  currentBucket = nullptr;
+  nTracks = 0;
+}
+
+void G4BucketedTrackStack::SetSpillThreshold(std::size_t n,
+                                             const G4String& dir)
+{
+  spillThreshold = n;
+  spillDir = dir;
+  for(auto& bucket : buckets)
+  {
+    bucket.second->SetSpillThreshold(n, dir);
+  }
+}
+
+void G4BucketedTrackStack::ResetStatistics()
+{
+  lastPushed = nullptr;
+  lastPopped = nullptr;
+  nPushed = 0;
+  nPopped = 0;
+  nPushedChanges = 0;
+  nPoppedChanges = 0;
+  nBucketSwitches = 0;
+}
+
+void G4BucketedTrackStack::DumpStatistics() const
+{
+  G4cout << " Bucketed urgent stack ("
+         << (perRegion ? "per particle type and region" : "per particle type")
+         << ") : " << buckets.size() << " buckets" << G4endl;
+  G4cout << "    Tracks pushed / popped       : " << nPushed << " / "
+         << nPopped << G4endl;
+  G4cout << "    Particle type changes        : " << nPushedChanges
+         << " in push (LIFO) order, " << nPoppedChanges
+         << " in processing order" << G4endl;
+  G4cout << "    Bucket switches              : " << nBucketSwitches
+         << G4endl;
+  if(nPoppedChanges > 0)
+  {
+    G4cout << "    Mean tracks per type change  : "
+           << G4double(nPopped) / nPoppedChanges << " (LIFO : "
+           << (nPushedChanges > 0 ? G4double(nPushed) / nPushedChanges : 0.)
+           << ")" << G4endl;
+  }
+  G4cout << "    Maximum number of tracks     : " << maxNTracks << G4endl;
+}
@@ -33,6 +33,7 @@
 #include "G4UIdirectory.hh"
 #include "G4UIcmdWithoutParameter.hh"
 #include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithABool.hh"
 
 G4EvManMessenger::G4EvManMessenger(G4EventManager * fEvMan)
   : fEvManager(fEvMan)
@@ -58,6 +59,15 @@ G4EvManMessenger::G4EvManMessenger(G4EventManager * fEvMan)
   storeEvtCmd->SetGuidance("Given the potential large memory size of G4Event and its data-member objects stored in G4Event,");
   storeEvtCmd->SetGuidance("the user must be careful and responsible for not to store too many G4Event objects.");
   storeEvtCmd->AvailableForStates(G4State_EventProc);
+
+  useArenaCmd = new G4UIcmdWithABool("/event/useArena",this);
+  useArenaCmd->SetGuidance("Allocate G4Track and G4DynamicParticle objects of an event in a per-thread arena");
+  useArenaCmd->SetGuidance("which is released at once at the end of the event, instead of the G4Allocator pools.");
+  useArenaCmd->SetGuidance("Tracks and dynamic particles must then not be kept beyond the end of the event.");
+  useArenaCmd->SetGuidance("Statistics of the arena are printed with /event/verbose 1.");
+  useArenaCmd->SetParameterName("flag",true);
+  useArenaCmd->SetDefaultValue(true);
+  useArenaCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
 }
 
 G4EvManMessenger::~G4EvManMessenger()
@@ -65,6 +75,7 @@ G4EvManMessenger::~G4EvManMessenger()
   delete abortCmd;
   delete verboseCmd;
   delete storeEvtCmd;
+  delete useArenaCmd;
   delete eventDirectory;
 }
 
@@ -76,6 +87,8 @@ void G4EvManMessenger::SetNewValue(G4UIcommand * command,G4String newValues)
   { fEvManager->AbortCurrentEvent(); }
   if( command == storeEvtCmd )
   { fEvManager->KeepTheCurrentEvent(); }
+  if( command == useArenaCmd )
+  { fEvManager->UseEventArena(useArenaCmd->GetNewBoolValue(newValues)); }
 }
 
 G4String G4EvManMessenger::GetCurrentValue(G4UIcommand * command)
@@ -83,5 +96,7 @@ G4String G4EvManMessenger::GetCurrentValue(G4UIcommand * command)
   G4String cv;
   if( command == verboseCmd )
   { cv = verboseCmd->ConvertToString(fEvManager->GetVerboseLevel()); }
+  if( command == useArenaCmd )
+  { cv = useArenaCmd->ConvertToString(fEvManager->IsEventArenaUsed()); }
   return cv;
 }
@@ -32,6 +32,8 @@
 #include "G4VVisManager.hh"
 #include "G4VHitsCollection.hh"
 #include "G4VDigiCollection.hh"
+#include "G4THitsMap.hh"
+#include "G4StatDouble.hh"
 #include "G4ios.hh"
 
 G4Allocator<G4Event>*& anEventAllocator()
@@ -82,6 +84,43 @@ G4bool G4Event::operator!=(const G4Event& right) const
   return ( eventID != right.eventID );
 }
 
+namespace
+{
+  template <typename T>
+  G4bool MergeHitsMap(G4VHitsCollection* hc, G4VHitsCollection* subHC)
+  {
+    auto hitsMap = dynamic_cast<G4THitsMap<T>*>(hc);
+    auto subHitsMap = dynamic_cast<G4THitsMap<T>*>(subHC);
+    if(hitsMap == nullptr || subHitsMap == nullptr) return false;
+    *hitsMap += *subHitsMap;
+    return true;
+  }
+}
+
+G4int G4Event::MergeSubEventResults(const G4Event* subEvent)
+{
+  G4HCofThisEvent* subHC = subEvent->GetHCofThisEvent();
+  if(subHC == nullptr) return 0;
+
+  G4int nNotMerged = 0;
+  for(std::size_t j=0; j<subHC->GetCapacity(); ++j)
+  {
+    G4VHitsCollection* subCol = subHC->GetHC(G4int(j));
+    if(subCol == nullptr || subCol->GetSize() == 0) continue;
+    G4VHitsCollection* col = (HC != nullptr && j < HC->GetCapacity())
+                           ? HC->GetHC(G4int(j)) : nullptr;
+    if(col == nullptr || col->GetName() != subCol->GetName()
+       || col->GetSDname() != subCol->GetSDname()
+       || !(MergeHitsMap<G4double>(col, subCol)
+            || MergeHitsMap<G4int>(col, subCol)
+            || MergeHitsMap<G4StatDouble>(col, subCol)))
+    {
+      ++nNotMerged;
+    }
+  }
+  return nNotMerged;
+}
+
 void G4Event::Print() const
 {
   G4cout << "G4Event " << eventID << G4endl;
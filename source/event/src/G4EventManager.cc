@@ -32,21 +32,42 @@
 #include "G4ios.hh"
 #include "G4EvManMessenger.hh"
 #include "G4Event.hh"
+#include "G4SubEvent.hh"
+#include "G4EventArena.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4VTrackingManager.hh"
 #include "G4UserEventAction.hh"
 #include "G4UserStackingAction.hh"
+#include "G4UserSteppingBatchAction.hh"
 #include "G4SDManager.hh"
 #include "G4StateManager.hh"
 #include "G4ApplicationState.hh"
 #include "G4TransportationManager.hh"
 #include "G4Navigator.hh"
 #include "Randomize.hh"
+#include "G4RandomTools.hh"
 #include "G4Profiler.hh"
 #include "G4TiMemory.hh"
 
+#include <sstream>
 #include <unordered_set>
 
+namespace
+{
+  void CheckSubEventTrackIDs(const G4SubEvent* subEvent, G4int counter)
+  {
+    if(counter - subEvent->GetTrackIDOffset() < G4SubEvent::kTrackIDRange)
+      return;
+    G4ExceptionDescription ED;
+    ED << "A sub-event of event " << subEvent->GetEventID() << " created "
+       << counter - subEvent->GetTrackIDOffset() << " tracks, more than "
+       << G4SubEvent::kTrackIDRange << ": their IDs overlap with those of"
+       << " the next sub-event.";
+    G4Exception("G4EventManager::ProcessSubEvent", "Event0061", JustWarning,
+                ED);
+  }
+}
+
 G4ThreadLocal G4EventManager* G4EventManager::fpEventManager = nullptr;
 
 G4EventManager* G4EventManager::GetEventManager()
@@ -75,26 +96,59 @@ G4EventManager::G4EventManager()
 
 G4EventManager::~G4EventManager()
 {
+  for(auto subEvent : processedSubEvents)
+  {
+    delete subEvent->GetResult();
+    subEvent->Release();
+  }
   delete trackContainer;
   delete transformer;
   delete trackManager;
   delete theMessenger;
   delete userEventAction;
+  if(arena != nullptr)
+  {
+#ifdef G4VERBOSE
+    if(verboseLevel > 0)
+    {
+      G4cout << "G4EventManager: event arena used for "
+             << arena->GetNumberOfResets() << " events, "
+             << arena->GetTotalNumberOfAllocations() << " allocations with "
+             << arena->GetNumberOfBlockAllocations() << " block allocations,"
+             << " peak " << arena->GetPeakBytes() << " bytes per event."
+             << G4endl;
+    }
+#endif
+    // Deleted last, as the stacks may still hold tracks allocated in it
+    delete arena;
+  }
   fpEventManager = nullptr;
 }
 
-void G4EventManager::DoProcessing(G4Event* anEvent)
+void G4EventManager::DoProcessing(G4Event* anEvent,
+                                  G4TrackVector* subEventTracks)
 {
+  G4bool subEvent = (subEventTracks != nullptr);
   abortRequested = false;
   G4ApplicationState currentState = stateManager->GetCurrentState();
   if(currentState != G4State_GeomClosed)
   {
     G4Exception("G4EventManager::ProcessOneEvent", "Event0002", JustWarning,
            "IllegalState -- Geometry not closed: cannot process an event.");
+    if(subEvent)
+    {
+      for(auto aTrack : *subEventTracks) { delete aTrack; }
+      subEventTracks->clear();
+    }
     return;
   }
   currentEvent = anEvent;
   stateManager->SetNewState(G4State_EventProc);
+  if(useArena && !subEvent)
+  {
+    if(arena == nullptr) { arena = new G4EventArena; }
+    arena->SetActive(true);
+  }
   if(storetRandomNumberStatusToG4Event > 1)
   {
     std::ostringstream oss;
@@ -102,6 +156,20 @@ void G4EventManager::DoProcessing(G4Event* anEvent)
     randomNumberStatusToG4Event = oss.str();
     currentEvent->SetRandomNumberStatusForProcessing(randomNumberStatusToG4Event); 
   }
+  if(!subEvent)
+  {
+    nSubEvents = 0;
+    if(trackContainer->HasSubEventTypes())
+    {
+      // Seeds of the sub-events are derived from the engine state at the
+      // start of the event, which is read without drawing numbers
+      subEventSeedKey = 0;
+      for(auto word : G4Random::getTheEngine()->put())
+      {
+        subEventSeedKey = G4SplitMix64(subEventSeedKey ^ word);
+      }
+    }
+  }
 
   // Resetting Navigator has been moved to G4EventManager,
   // so that resetting is now done for every event.
@@ -109,9 +177,6 @@ void G4EventManager::DoProcessing(G4Event* anEvent)
   G4Navigator* navigator = G4TransportationManager::GetTransportationManager()
                          ->GetNavigatorForTracking();
   navigator->LocateGlobalPointAndSetup(center,0,false);
-                                                                                      
-  G4Track* track = nullptr;
-  G4TrackStatus istop = fAlive;
 
 #ifdef G4VERBOSE
   if ( verboseLevel > 0 )
@@ -122,7 +187,7 @@ void G4EventManager::DoProcessing(G4Event* anEvent)
   }
 #endif
 
-  trackContainer->PrepareNewEvent();
+  if(!subEvent) { trackContainer->PrepareNewEvent(); }
 
 #ifdef G4_STORE_TRAJECTORY
   trajectoryContainer = nullptr;
@@ -132,7 +197,10 @@ void G4EventManager::DoProcessing(G4Event* anEvent)
   if(sdManager != nullptr)
   { currentEvent->SetHCofThisEvent(sdManager->PrepareNewEvent()); }
 
-  if(userEventAction) userEventAction->BeginOfEventAction(currentEvent);
+  if(userEventAction && !subEvent)
+  {
+    userEventAction->BeginOfEventAction(currentEvent);
+  }
 
 #if defined(GEANT4_USE_TIMEMORY)
   eventProfiler.reset(new ProfilerConfig(currentEvent));
@@ -146,7 +214,11 @@ void G4EventManager::DoProcessing(G4Event* anEvent)
   }
 #endif
 
-  if(!abortRequested)
+  if(subEvent)
+  {
+    StackTracks(subEventTracks, true);
+  }
+  else if(!abortRequested)
   {
     StackTracks(transformer->GimmePrimaries(currentEvent,trackIDCounter), true);
   }
@@ -160,6 +232,69 @@ void G4EventManager::DoProcessing(G4Event* anEvent)
   }
 #endif
 
+  ProcessStackedTracks();
+
+  if(!subEvent)
+  {
+    // Tracks remaining in the sub-event stacks are detached at the end of
+    // the event, then all sub-events are completed and merged
+    trackContainer->ReleaseSubEvents();
+    if(!spawnedSubEvents.empty()) { ProcessSubEvents(); }
+  }
+
+#ifdef G4VERBOSE
+  if ( verboseLevel > 0 )
+  {
+    G4cout << "NULL returned from G4StackManager." << G4endl;
+    G4cout << "Terminate current event processing." << G4endl;
+  }
+#endif
+
+  if(sdManager != nullptr)
+  {
+    sdManager->TerminateCurrentEvent(currentEvent->GetHCofThisEvent());
+  }
+
+#if defined(GEANT4_USE_TIMEMORY)
+  eventProfiler.reset();
+#endif
+
+  // Steps recorded by batched stepping actions are delivered before
+  // the end of event
+  G4UserSteppingBatchAction::EndOfEvent();
+
+  if(userEventAction && !subEvent)
+  {
+    userEventAction->EndOfEventAction(currentEvent);
+  }
+
+  if(arena != nullptr && arena->IsActive() && !subEvent)
+  {
+    arena->SetActive(false);
+#ifdef G4VERBOSE
+    if(verboseLevel > 0)
+    {
+      G4cout << "Event arena: " << arena->GetNumberOfAllocations()
+             << " allocations (" << arena->GetNumberOfReuses()
+             << " reused), " << arena->GetBytesInUse() << " bytes in use, "
+             << arena->GetReservedBytes() << " bytes reserved." << G4endl;
+    }
+#endif
+    // Postponed tracks are still alive: the arena is rewound only once
+    // no track allocated in it survives the event
+    if(trackContainer->GetNPostponedTrack() == 0) { arena->Reset(); }
+  }
+
+  stateManager->SetNewState(G4State_GeomClosed);
+  currentEvent = nullptr;
+  abortRequested = false;
+}
+
+void G4EventManager::ProcessStackedTracks()
+{
+  G4Track* track = nullptr;
+  G4TrackStatus istop = fAlive;
+
   std::unordered_set<G4VTrackingManager *> trackingManagersToFlush;
 
   do
@@ -281,32 +416,181 @@ void G4EventManager::DoProcessing(G4Event* anEvent)
 
     // Check if flushing one of the tracking managers stacked new secondaries.
   } while (trackContainer->GetNUrgentTrack() > 0);
+}
 
+void G4EventManager::ProcessSubEvents()
+{
+  // Sub-events which have not been started by another thread are
+  // processed by this thread. Each one is processed with its own seeds
+  // and track IDs, exactly as it would be by another thread; the engine
+  // state and the track ID counter of the event are restored afterwards.
+  std::ostringstream engineState;
+  G4bool engineSaved = false;
+  G4int eventTrackIDCounter = trackIDCounter;
+  trackContainer->SetSubEventProcessing(true);
+  for(auto subEvent : spawnedSubEvents)
+  {
+    if(!subEvent->Reclaim()) continue;
+    if(abortRequested) continue;
 #ifdef G4VERBOSE
-  if ( verboseLevel > 0 )
+    if ( verboseLevel > 1 )
+    {
+      G4cout << "Sub-event with " << subEvent->GetNTrack()
+             << " tracks is processed by the owner of the event." << G4endl;
+    }
+#endif
+    if(!engineSaved)
+    {
+      G4Random::saveFullState(engineState);
+      engineSaved = true;
+    }
+    long seeds[3];
+    subEvent->GetSeeds(seeds);
+    G4Random::setTheSeeds(seeds, -1);
+    trackIDCounter = subEvent->GetTrackIDOffset();
+    G4TrackVector* trackVector = subEvent->GimmeTracks();
+    StackTracks(trackVector, true);
+    delete trackVector;
+    ProcessStackedTracks();
+    CheckSubEventTrackIDs(subEvent, trackIDCounter);
+  }
+  trackContainer->SetSubEventProcessing(false);
+  trackIDCounter = eventTrackIDCounter;
+  if(engineSaved)
   {
-    G4cout << "NULL returned from G4StackManager." << G4endl;
-    G4cout << "Terminate current event processing." << G4endl;
+    std::istringstream in(engineState.str());
+    G4Random::restoreFullState(in);
   }
-#endif
 
-  if(sdManager != nullptr)
+  // Wait for the sub-events taken by other threads and merge their
+  // results in the order they were spawned
+  G4int nNotMerged = 0;
+  std::size_t nTrajectories = 0;
+  for(auto subEvent : spawnedSubEvents)
   {
-    sdManager->TerminateCurrentEvent(currentEvent->GetHCofThisEvent());
+    G4Event* result = subEvent->WaitForResult();
+    if(result != nullptr && !abortRequested)
+    {
+      G4int n = currentEvent->MergeSubEventResults(result);
+      G4bool merged = (userEventAction != nullptr)
+        && userEventAction->MergeSubEventResults(currentEvent, result);
+      if(!merged) { nNotMerged += n; }
+      if(result->GetTrajectoryContainer() != nullptr)
+      {
+        nTrajectories += result->GetTrajectoryContainer()->entries();
+      }
+    }
+    subEvent->SetMerged();
+    subEvent->Release();
   }
+  spawnedSubEvents.clear();
 
-#if defined(GEANT4_USE_TIMEMORY)
-  eventProfiler.reset();
-#endif
+  static G4ThreadLocal G4bool warned = false;
+  if((nNotMerged > 0 || nTrajectories > 0) && !warned)
+  {
+    G4ExceptionDescription ED;
+    ED << "Results of sub-events processed by other threads are lost: "
+       << nNotMerged << " hits collections which are not of a G4THitsMap"
+       << " type merged by G4Event, nor merged by the user's event action,"
+       << " and " << nTrajectories << " trajectories."
+       << " This warning is issued once.";
+    G4Exception("G4EventManager::ProcessSubEvents", "Event0062", JustWarning,
+                ED);
+    warned = true;
+  }
+}
 
-  if(userEventAction)
+void G4EventManager::SpawnSubEvent(G4int ty, G4TrackStack* subEventStack)
+{
+  // Seeds and track IDs depend only on the index of the sub-event in the
+  // event; no number is drawn from the engine of the event
+  G4int index = nSubEvents++;
+  G4long seeds[2];
+  G4DeriveSeeds(G4SplitMix64(subEventSeedKey ^ std::uint64_t(index)), 2,
+                seeds);
+  if(index == G4SubEvent::kMaxSubEvents)
   {
-    userEventAction->EndOfEventAction(currentEvent);
+    G4ExceptionDescription ED;
+    ED << "Event " << currentEvent->GetEventID() << " has more than "
+       << G4SubEvent::kMaxSubEvents << " sub-events: the track IDs of the"
+       << " following ones overlap with those of the first ones.";
+    G4Exception("G4EventManager::SpawnSubEvent", "Event0060", JustWarning,
+                ED);
   }
+  G4int idOffset = G4SubEvent::kTrackIDBase
+    + (index % G4SubEvent::kMaxSubEvents) * G4SubEvent::kTrackIDRange;
+  G4int evID = (currentEvent != nullptr) ? currentEvent->GetEventID() : -1;
+  auto subEvent = new G4SubEvent(evID, ty, seeds[0], seeds[1], idOffset);
+  for(auto& stackedTrack : *subEventStack)
+  {
+    subEvent->StoreTrack(stackedTrack.GetTrack());
+    delete stackedTrack.GetTrack();
+    delete stackedTrack.GetTrajectory();
+  }
+  subEventStack->clear();
+  spawnedSubEvents.push_back(subEvent);
 
-  stateManager->SetNewState(G4State_GeomClosed);
-  currentEvent = nullptr;
-  abortRequested = false;
+  if(subEventDispatcher)
+  {
+    subEvent->Retain();
+    if(!subEventDispatcher(subEvent)) { subEvent->Release(); }
+  }
+}
+
+void G4EventManager::ProcessSubEvent(G4SubEvent* subEvent)
+{
+  CleanUpSubEvents();
+  if(!subEvent->Claim())
+  {
+    // Already taken back by the owner of the event
+    subEvent->Release();
+    return;
+  }
+
+  // The engine state and the track ID counter of this thread are
+  // restored afterwards, so that its own events do not depend on the
+  // sub-events it happened to process
+  std::ostringstream engineState;
+  G4Random::saveFullState(engineState);
+  G4int threadTrackIDCounter = trackIDCounter;
+
+  long seeds[3];
+  subEvent->GetSeeds(seeds);
+  G4Random::setTheSeeds(seeds, -1);
+
+  auto anEvent = new G4Event(subEvent->GetEventID());
+  trackIDCounter = subEvent->GetTrackIDOffset();
+  trackContainer->SetSubEventProcessing(true);
+  G4TrackVector* trackVector = subEvent->GimmeTracks();
+  DoProcessing(anEvent, trackVector);
+  delete trackVector;
+  trackContainer->SetSubEventProcessing(false);
+  CheckSubEventTrackIDs(subEvent, trackIDCounter);
+
+  trackIDCounter = threadTrackIDCounter;
+  std::istringstream in(engineState.str());
+  G4Random::restoreFullState(in);
+
+  // The owner is waiting for the result, even if processing failed
+  subEvent->SetProcessed(anEvent);
+  processedSubEvents.push_back(subEvent);
+}
+
+void G4EventManager::CleanUpSubEvents()
+{
+  for(auto itr = processedSubEvents.begin(); itr != processedSubEvents.end();)
+  {
+    if((*itr)->IsMerged())
+    {
+      delete (*itr)->GetResult();
+      (*itr)->Release();
+      itr = processedSubEvents.erase(itr);
+    }
+    else
+    {
+      ++itr;
+    }
+  }
 }
 
 void G4EventManager::StackTracks(G4TrackVector* trackVector,
@@ -373,6 +657,7 @@ void G4EventManager::SetUserAction(G4UserSteppingAction* userAction)
 
 void G4EventManager::ProcessOneEvent(G4Event* anEvent)
 {
+  CleanUpSubEvents();
   trackIDCounter = 0;
   DoProcessing(anEvent);
 }
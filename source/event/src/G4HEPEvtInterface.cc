@@ -39,20 +39,33 @@
 #include "G4HEPEvtParticle.hh"
 #include "G4Event.hh"
 
-G4HEPEvtInterface::G4HEPEvtInterface(const char* evfile, G4int vl)
+G4HEPEvtInterface::G4HEPEvtInterface(const char* evfile, G4int vl,
+                                     G4bool prefetch)
   : vLevel(vl)
 {
-  inputFile.open((char*)evfile);
-  if (inputFile.is_open())
+  if(prefetch)
   {
+    reader = G4HEPEvtReader::GetReader(evfile);
     fileName = evfile;
     if(vl>0)
-      G4cout << "G4HEPEvtInterface - " << fileName << " is open." << G4endl;
+      G4cout << "G4HEPEvtInterface - " << fileName << " is read by "
+             << (reader->IsBinary() ? "binary" : "ASCII")
+             << " prefetching reader." << G4endl;
   }
   else
   {
-    G4Exception("G4HEPEvtInterface::G4HEPEvtInterface","Event0201",
-                FatalException, "G4HEPEvtInterface:: cannot open file.");
+    inputFile.open((char*)evfile);
+    if (inputFile.is_open())
+    {
+      fileName = evfile;
+      if(vl>0)
+        G4cout << "G4HEPEvtInterface - " << fileName << " is open." << G4endl;
+    }
+    else
+    {
+      G4Exception("G4HEPEvtInterface::G4HEPEvtInterface","Event0201",
+                  FatalException, "G4HEPEvtInterface:: cannot open file.");
+    }
   }
   G4ThreeVector zero;
   particle_position = zero;
@@ -63,8 +76,33 @@ G4HEPEvtInterface::~G4HEPEvtInterface()
 {
 }
 
-void G4HEPEvtInterface::GeneratePrimaryVertex(G4Event* evt)
+G4bool G4HEPEvtInterface::ReadEvent(G4int eventID)
 {
+  if(reader != nullptr)
+  {
+    if(!reader->NextEvent(eventID, entries)) return false;
+    if(vLevel > 0)
+    {
+      G4cout << "G4HEPEvtInterface - reading " << entries.size()
+             << " HEPEvt particles from " << fileName << "." << G4endl;
+    }
+    for(const auto& e : entries)
+    {
+      if(vLevel > 1)
+      {
+        G4cout << " " << e.ISTHEP << " " << e.IDHEP << " " << e.JDAHEP1
+               << " " << e.JDAHEP2 << " " << e.PHEP1 << " " << e.PHEP2
+               << " " << e.PHEP3 << " " << e.PHEP5 << G4endl;
+      }
+      G4PrimaryParticle* particle = new G4PrimaryParticle( e.IDHEP );
+      particle->SetMass( e.PHEP5*GeV );
+      particle->SetMomentum(e.PHEP1*GeV, e.PHEP2*GeV, e.PHEP3*GeV );
+      HPlist.push_back(
+        new G4HEPEvtParticle( particle, e.ISTHEP, e.JDAHEP1, e.JDAHEP2 ) );
+    }
+    return true;
+  }
+
   G4int NHEP = 0;  // number of entries
   if (inputFile.is_open())
   {
@@ -75,13 +113,7 @@ void G4HEPEvtInterface::GeneratePrimaryVertex(G4Event* evt)
     G4Exception("G4HEPEvtInterface::G4HEPEvtInterface","Event0201",
                 FatalException, "G4HEPEvtInterface:: cannot open file.");
   }
-  if( inputFile.eof() ) 
-  {
-    G4Exception("G4HEPEvtInterface::GeneratePrimaryVertex", "Event0202",
-                RunMustBeAborted,
-                "End-Of-File: HEPEvt input file -- no more event to read!");
-    return;
-  }
+  if( inputFile.eof() ) return false;
 
   if(vLevel > 0)
   {
@@ -129,6 +161,18 @@ void G4HEPEvtInterface::GeneratePrimaryVertex(G4Event* evt)
     //
     HPlist.push_back( hepParticle );
   }
+  return true;
+}
+
+void G4HEPEvtInterface::GeneratePrimaryVertex(G4Event* evt)
+{
+  if( !ReadEvent(evt->GetEventID()) )
+  {
+    G4Exception("G4HEPEvtInterface::GeneratePrimaryVertex", "Event0202",
+                RunMustBeAborted,
+                "End-Of-File: HEPEvt input file -- no more event to read!");
+    return;
+  }
 
   // Check if there is at least one particle
   //
@@ -0,0 +1,376 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4HEPEvtReader class implementation
+// --------------------------------------------------------------------
+
+#include "G4HEPEvtReader.hh"
+#include "G4AutoLock.hh"
+#include "G4StateManager.hh"
+#include "G4VStateDependent.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+
+namespace
+{
+  G4Mutex readerMutex = G4MUTEX_INITIALIZER;
+  const char binaryMagic[8] = { 'G', '4', 'H', 'E', 'P', 'E', 'V', 'B' };
+}
+
+// --------------------------------------------------------------------
+// Follows the runs of one thread for one reader. It is created by the
+// thread at its first event and deleted by its G4StateManager.
+class G4HEPEvtRunObserver : public G4VStateDependent
+{
+  public:
+
+    explicit G4HEPEvtRunObserver(G4HEPEvtReader* aReader)
+      : reader(aReader)
+    {
+      // created during the event loop: the run has already started
+      inRun = true;
+      reader->BeginOfRun();
+    }
+
+    G4bool Notify(G4ApplicationState requestedState) override
+    {
+      G4ApplicationState previousState
+        = G4StateManager::GetStateManager()->GetPreviousState();
+      if(previousState == G4State_Idle && requestedState == G4State_GeomClosed)
+      {
+        inRun = true;
+        reader->BeginOfRun();
+      }
+      else if(inRun && previousState == G4State_GeomClosed
+              && requestedState == G4State_Idle)
+      {
+        inRun = false;
+        reader->EndOfRun();
+      }
+      return true;
+    }
+
+  private:
+
+    G4HEPEvtReader* reader = nullptr;
+    G4bool inRun = false;
+};
+
+// --------------------------------------------------------------------
+G4HEPEvtReader* G4HEPEvtReader::GetReader(const G4String& fileName,
+                                          std::size_t bufferSize)
+{
+  static std::map<G4String, std::unique_ptr<G4HEPEvtReader>> readers;
+
+  G4AutoLock l(&readerMutex);
+  auto& reader = readers[fileName];
+  if(reader == nullptr)
+  {
+    reader.reset(new G4HEPEvtReader(fileName, bufferSize));
+  }
+  return reader.get();
+}
+
+// --------------------------------------------------------------------
+G4HEPEvtReader::G4HEPEvtReader(const G4String& evfile,
+                               std::size_t bufSize)
+  : fileName(evfile), bufferSize(std::max(bufSize, std::size_t(1)))
+{
+  inputFile.open(fileName, std::ios::in | std::ios::binary);
+  if(!inputFile.is_open())
+  {
+    G4ExceptionDescription ed;
+    ed << "Cannot open file " << fileName;
+    G4Exception("G4HEPEvtReader::G4HEPEvtReader()", "Event0201",
+                FatalException, ed);
+    return;
+  }
+
+  char magic[sizeof(binaryMagic)] = { 0 };
+  inputFile.read(magic, sizeof(magic));
+  binary = inputFile.gcount() == sizeof(magic)
+           && std::memcmp(magic, binaryMagic, sizeof(magic)) == 0;
+  if(!binary)
+  {
+    inputFile.clear();
+    inputFile.seekg(0);
+  }
+
+#ifdef G4MULTITHREADED
+  prefetcher = new G4Thread(&G4HEPEvtReader::Prefetch, this);
+#endif
+}
+
+// --------------------------------------------------------------------
+G4HEPEvtReader::~G4HEPEvtReader()
+{
+  {
+    G4AutoLock l(&bufferMutex);
+    stop = true;
+  }
+  G4CONDITIONBROADCAST(&bufferChanged);
+#ifdef G4MULTITHREADED
+  if(prefetcher != nullptr)
+  {
+    prefetcher->join();
+    delete prefetcher;
+  }
+#endif
+}
+
+// --------------------------------------------------------------------
+G4bool G4HEPEvtReader::ReadEvent(std::vector<Entry>& entries)
+{
+  entries.clear();
+  std::int32_t NHEP = 0;
+  if(binary)
+  {
+    inputFile.read(reinterpret_cast<char*>(&NHEP), sizeof(NHEP));
+    if(!inputFile)
+      return false;
+    if(NHEP < 0)
+    {
+      badEvent = true;
+      return false;
+    }
+    entries.resize(NHEP);
+    inputFile.read(reinterpret_cast<char*>(entries.data()),
+                   NHEP * sizeof(Entry));
+  }
+  else
+  {
+    inputFile >> NHEP;
+    if(!inputFile)
+      return false;
+    if(NHEP < 0)
+    {
+      badEvent = true;
+      return false;
+    }
+    entries.resize(NHEP);
+    for(auto& e : entries)
+    {
+      inputFile >> e.ISTHEP >> e.IDHEP >> e.JDAHEP1 >> e.JDAHEP2
+                >> e.PHEP1 >> e.PHEP2 >> e.PHEP3 >> e.PHEP5;
+    }
+  }
+  if(!inputFile)
+  {
+    badEvent = true;
+    return false;
+  }
+  return true;
+}
+
+// --------------------------------------------------------------------
+void G4HEPEvtReader::Prefetch()
+{
+  // Records are parsed up to bufferSize ahead of the first one not yet
+  // released, or further if a thread asks for it
+  std::vector<Entry> entries;
+  G4AutoLock l(&bufferMutex);
+  while(!stop)
+  {
+    if(first + buffer.size() >= std::max(first + bufferSize, wanted))
+    {
+      G4CONDITIONWAIT(&bufferChanged, &l);
+      continue;
+    }
+    l.unlock();
+    G4bool ok = ReadEvent(entries);
+    l.lock();
+    if(!ok)
+      break;
+    if(buffer.empty() && first < runBase)
+    {
+      // skipped record of a previous run
+      ++first;
+      continue;
+    }
+    buffer.emplace_back();
+    buffer.back().entries.swap(entries);
+    G4CONDITIONBROADCAST(&bufferChanged);
+  }
+  finished = true;
+  G4CONDITIONBROADCAST(&bufferChanged);
+}
+
+// --------------------------------------------------------------------
+void G4HEPEvtReader::BeginOfRun()
+{
+  G4AutoLock l(&bufferMutex);
+  if(nThreadsInRun++ > 0)
+    return;
+
+  // Records of the previous run which were not asked for are skipped
+  runBase = runEnd;
+  while(!buffer.empty() && first < runBase)
+  {
+    buffer.pop_front();
+    ++first;
+  }
+  G4CONDITIONBROADCAST(&bufferChanged);
+}
+
+// --------------------------------------------------------------------
+void G4HEPEvtReader::EndOfRun()
+{
+  G4AutoLock l(&bufferMutex);
+  if(nThreadsInRun > 0)
+    --nThreadsInRun;
+}
+
+// --------------------------------------------------------------------
+G4bool G4HEPEvtReader::NextEvent(G4int eventID, std::vector<Entry>& entries)
+{
+  static G4ThreadLocal std::map<G4HEPEvtReader*, G4HEPEvtRunObserver*>*
+    observers = nullptr;
+  if(observers == nullptr)
+    observers = new std::map<G4HEPEvtReader*, G4HEPEvtRunObserver*>;
+  if(observers->find(this) == observers->end())
+    (*observers)[this] = new G4HEPEvtRunObserver(this);
+
+  G4AutoLock l(&bufferMutex);
+  std::size_t index = runBase + std::size_t(std::max(eventID, 0));
+  runEnd = std::max(runEnd, index + 1);
+  if(index < first)
+  {
+    G4ExceptionDescription ed;
+    ed << "Record " << index << " of " << fileName << " for event "
+       << eventID << " has already been released.";
+    G4Exception("G4HEPEvtReader::NextEvent()", "Event0205",
+                FatalException, ed);
+    return false;
+  }
+
+#ifdef G4MULTITHREADED
+  if(index >= wanted)
+  {
+    wanted = index + 1;
+    G4CONDITIONBROADCAST(&bufferChanged);
+  }
+  auto ready = [this, index]()
+    { return index < first + buffer.size() || finished; };
+  G4CONDITIONWAITLAMBDA(&bufferChanged, &l, ready);
+#else
+  std::vector<Entry> parsed;
+  while(index >= first + buffer.size() && !finished)
+  {
+    if(!ReadEvent(parsed))
+    {
+      finished = true;
+    }
+    else if(buffer.empty() && first < runBase)
+    {
+      // skipped record of a previous run
+      ++first;
+    }
+    else
+    {
+      buffer.emplace_back();
+      buffer.back().entries.swap(parsed);
+    }
+  }
+#endif
+
+  if(index < first + buffer.size())
+  {
+    Record& record = buffer[index - first];
+    if(record.taken)
+    {
+      G4ExceptionDescription ed;
+      ed << "Record " << index << " of " << fileName << " for event "
+         << eventID << " has already been used.";
+      G4Exception("G4HEPEvtReader::NextEvent()", "Event0205",
+                  FatalException, ed);
+      return false;
+    }
+    entries.swap(record.entries);
+    record.entries.clear();
+    record.taken = true;
+    // records are released in order
+    while(!buffer.empty() && buffer.front().taken)
+    {
+      buffer.pop_front();
+      ++first;
+    }
+    G4CONDITIONBROADCAST(&bufferChanged);
+    return true;
+  }
+
+  if(badEvent)
+  {
+    G4ExceptionDescription ed;
+    ed << "Truncated or corrupted event in "
+       << fileName;
+    G4Exception("G4HEPEvtReader::NextEvent()", "Event0203",
+                FatalException, ed);
+  }
+  return false;
+}
+
+// --------------------------------------------------------------------
+G4bool G4HEPEvtReader::ConvertToBinary(const G4String& asciiFile,
+                                       const G4String& binaryFile)
+{
+  std::ifstream in(asciiFile);
+  std::ofstream out(binaryFile, std::ios::out | std::ios::binary);
+  if(!in.is_open() || !out.is_open())
+  {
+    G4ExceptionDescription ed;
+    ed << "Cannot open " << (in.is_open() ? binaryFile : asciiFile);
+    G4Exception("G4HEPEvtReader::ConvertToBinary()", "Event0204",
+                JustWarning, ed);
+    return false;
+  }
+
+  out.write(binaryMagic, sizeof(binaryMagic));
+  std::int32_t NHEP = 0;
+  std::vector<Entry> entries;
+  while(in >> NHEP && NHEP >= 0)
+  {
+    entries.resize(NHEP);
+    for(auto& e : entries)
+    {
+      in >> e.ISTHEP >> e.IDHEP >> e.JDAHEP1 >> e.JDAHEP2
+         >> e.PHEP1 >> e.PHEP2 >> e.PHEP3 >> e.PHEP5;
+    }
+    if(!in)
+    {
+      G4Exception("G4HEPEvtReader::ConvertToBinary()", "Event0203",
+                  JustWarning,
+                  "Unexpected End-Of-File in the middle of an event");
+      return false;
+    }
+    out.write(reinterpret_cast<const char*>(&NHEP), sizeof(NHEP));
+    out.write(reinterpret_cast<const char*>(entries.data()),
+              NHEP * sizeof(Entry));
+  }
+  return bool(out);
+}
@@ -51,3 +51,14 @@ void G4MultiEventAction::EndOfEventAction(const G4Event* evt)
       [evt](G4UserEventActionUPtr& e) { e->EndOfEventAction(evt); }
   );
 }
+
+G4bool G4MultiEventAction::MergeSubEventResults(G4Event* evt,
+                                                const G4Event* subEvt)
+{
+  G4bool merged = false;
+  std::for_each( begin() , end() ,
+      [evt,subEvt,&merged](G4UserEventActionUPtr& e)
+      { merged = e->MergeSubEventResults(evt,subEvt) || merged; }
+  );
+  return merged;
+}
@@ -0,0 +1,117 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4SPSAliasTable class implementation
+// --------------------------------------------------------------------
+
+#include "G4SPSAliasTable.hh"
+
+void G4SPSAliasTable::Build(const G4PhysicsVector& ipdf)
+{
+  Clear();
+  std::size_t n = ipdf.GetVectorLength();
+  if (n == 0) return;
+
+  edges.resize(n);
+  binProb.resize(n);
+  G4double total = 0.;
+  G4double previous = 0.;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    edges[i] = ipdf.Energy(i);
+    G4double p = ipdf(i) - previous;
+    binProb[i] = (p > 0.) ? p : 0.;
+    total += binProb[i];
+    previous = ipdf(i);
+  }
+  if (total <= 0.)
+  {
+    Clear();
+    return;
+  }
+
+  // Vose's algorithm: bins below the mean probability are completed by
+  // an alias bin above the mean
+  prob.resize(n);
+  alias.resize(n);
+  std::vector<G4double> scaled(n);
+  std::vector<std::size_t> small, large;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    binProb[i] /= total;
+    scaled[i] = binProb[i] * n;
+    if (scaled[i] < 1.) { small.push_back(i); }
+    else                { large.push_back(i); }
+  }
+  while (!small.empty() && !large.empty())
+  {
+    std::size_t s = small.back();
+    small.pop_back();
+    std::size_t l = large.back();
+    prob[s] = scaled[s];
+    alias[s] = l;
+    scaled[l] = (scaled[l] + scaled[s]) - 1.;
+    if (scaled[l] < 1.)
+    {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // remaining bins are full up to rounding errors
+  for (auto l : large) { prob[l] = 1.; alias[l] = l; }
+  for (auto s : small) { prob[s] = 1.; alias[s] = s; }
+}
+
+void G4SPSAliasTable::Clear()
+{
+  edges.clear();
+  binProb.clear();
+  prob.clear();
+  alias.clear();
+}
+
+std::size_t G4SPSAliasTable::SampleBin(G4double rndm, G4double& frac) const
+{
+  std::size_t n = prob.size();
+  G4double x = rndm * n;
+  std::size_t i = std::size_t(x);
+  if (i >= n) { i = n - 1; }
+  G4double f = x - i;
+  if (f < prob[i])
+  {
+    frac = f / prob[i];
+    return i;
+  }
+  frac = (f - prob[i]) / (1. - prob[i]);
+  return alias[i];
+}
+
+G4double G4SPSAliasTable::Sample(G4double rndm) const
+{
+  G4double frac = 0.;
+  std::size_t bin = SampleBin(rndm, frac);
+  if (bin == 0) { return edges[0]; }
+  return edges[bin - 1] + frac * (edges[bin] - edges[bin - 1]);
+}
@@ -116,16 +116,19 @@ void G4SPSEneDistribution::SetEnergyDisType(const G4String& DisType)
   {
     UDefEnergyH = IPDFEnergyH = ZeroPhysVector;
     IPDFEnergyExist = false;
+    EnergyAlias.Clear();
   }
   else if (EnergyDisType == "Arb")
   {
     ArbEnergyH = IPDFArbEnergyH = ZeroPhysVector;
     IPDFArbExist = false;
+    ArbEnergyAlias.Clear();
   }
   else if (EnergyDisType == "Epn")
   {
     UDefEnergyH = IPDFEnergyH = ZeroPhysVector;
     IPDFEnergyExist = false;
+    EnergyAlias.Clear();
     EpnEnergyH = ZeroPhysVector;
   }
 }
@@ -572,6 +575,9 @@ void G4SPSEneDistribution::ArbInterpolate(const G4String& IType)
   if (IntType == "Log") LogInterpolation();
   if (IntType == "Exp") ExpInterpolation();
   if (IntType == "Spline") SplineInterpolation();
+
+  // Segments are sampled in constant time with an alias table
+  ArbEnergyAlias.Build(IPDFArbEnergyH);
 }
 
 void G4SPSEneDistribution::LinearInterpolation()  // MT: Lock in caller
@@ -1658,6 +1664,7 @@ void G4SPSEneDistribution::GenUserHistEnergies()
     }
 
     IPDFEnergyExist = true;
+    EnergyAlias.Build(IPDFEnergyH);
     if (verbosityLevel > 1)
     {
       IPDFEnergyH.DumpValues();
@@ -1667,8 +1674,7 @@ void G4SPSEneDistribution::GenUserHistEnergies()
     
   // IPDF has been create so carry on
   //
-  G4double rndm = eneRndm->GenRandEnergy();
-  threadLocalData.Get().particle_energy= IPDFEnergyH.GetEnergy(rndm);
+  threadLocalData.Get().particle_energy = SampleUserHist();
 
   if (verbosityLevel >= 1)
   {
@@ -1676,6 +1682,20 @@ void G4SPSEneDistribution::GenUserHistEnergies()
   }
 }
 
+G4double G4SPSEneDistribution::SampleUserHist()
+{
+  // The alias table samples the same distribution as the linear
+  // interpolation of the IPDF, but the mapping of a biased random number
+  // to the energy must be kept
+  //
+  G4double rndm = eneRndm->GenRandEnergy();
+  if (!eneRndm->IsEnergyBiased() && !EnergyAlias.IsEmpty())
+  {
+    return EnergyAlias.Sample(rndm);
+  }
+  return IPDFEnergyH.GetEnergy(rndm);
+}
+
 G4double G4SPSEneDistribution::GetArbEneWeight(G4double ene)
 {
   auto nbelow = IPDFArbEnergyH.FindBin(ene,(IPDFArbEnergyH.GetVectorLength())/2);
@@ -1719,8 +1739,17 @@ void G4SPSEneDistribution::GenArbPointEnergies()
   //
   G4int nabove = IPDFArbEnergyH.GetVectorLength(), nbelow = 0, middle;
 
-  // Binary search to find bin that rndm is in
+  // Without biasing, rndm is flat and the bin is given by the alias
+  // table. Otherwise the mapping of rndm to energy must be kept, so
+  // binary search to find bin that rndm is in
   //
+  if (!eneRndm->IsEnergyBiased() && !ArbEnergyAlias.IsEmpty())
+  {
+    G4double frac = 0.;
+    std::size_t bin = ArbEnergyAlias.SampleBin(rndm, frac);
+    nbelow = (bin > 0) ? G4int(bin) - 1 : 0;
+    nabove = nbelow + 1;
+  }
   while (nabove - nbelow > 1)
   {
     middle = (nabove + nbelow) / 2;
@@ -1823,14 +1852,13 @@ void G4SPSEneDistribution::GenEpnHistEnergies()
       IPDFEnergyH.InsertValues(bins[ii], vals[ii]);
     }
     IPDFEnergyExist = true;
-       
+    EnergyAlias.Build(IPDFEnergyH);
   }
   l.unlock();
 
   // IPDF has been create so carry on
   //
-  G4double rndm = eneRndm->GenRandEnergy();
-  threadLocalData.Get().particle_energy = IPDFEnergyH.GetEnergy(rndm);
+  threadLocalData.Get().particle_energy = SampleUserHist();
 
   if (verbosityLevel >= 1)
   {
@@ -1918,6 +1946,7 @@ void G4SPSEneDistribution::ReSetHist(const G4String& atype)
   {
     UDefEnergyH = IPDFEnergyH = ZeroPhysVector;
     IPDFEnergyExist = false;
+    EnergyAlias.Clear();
     Emin = 0.;
     Emax = 1e30;
   }
@@ -1925,11 +1954,13 @@ void G4SPSEneDistribution::ReSetHist(const G4String& atype)
   {
     ArbEnergyH = IPDFArbEnergyH = ZeroPhysVector;
     IPDFArbExist = false;
+    ArbEnergyAlias.Clear();
   }
   else if (atype == "epn")
   {
     UDefEnergyH = IPDFEnergyH = ZeroPhysVector;
     IPDFEnergyExist = false;
+    EnergyAlias.Clear();
     EpnEnergyH = ZeroPhysVector;
   }
   else
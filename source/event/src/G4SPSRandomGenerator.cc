@@ -202,46 +202,77 @@ void G4SPSRandomGenerator::ReSetHist(const G4String& atype)
                 IPDFXBias = false;
                 local_IPDFXBias.Get().val = false;
                 XBiasH = IPDFXBiasH = ZeroPhysVector;
+                XBiasAlias.Clear();
         } else if (atype == "biasy") {
                 YBias = false;
                 IPDFYBias = false;
                 local_IPDFYBias.Get().val = false;
                 YBiasH = IPDFYBiasH = ZeroPhysVector;
+                YBiasAlias.Clear();
         } else if (atype == "biasz") {
                 ZBias = false;
                 IPDFZBias = false;
                 local_IPDFZBias.Get().val = false;
                 ZBiasH = IPDFZBiasH = ZeroPhysVector;
+                ZBiasAlias.Clear();
         } else if (atype == "biast") {
                 ThetaBias = false;
                 IPDFThetaBias = false;
                 local_IPDFThetaBias.Get().val = false;
                 ThetaBiasH = IPDFThetaBiasH = ZeroPhysVector;
+                ThetaBiasAlias.Clear();
         } else if (atype == "biasp") {
                 PhiBias = false;
                 IPDFPhiBias = false;
                 local_IPDFPhiBias.Get().val = false;
                 PhiBiasH = IPDFPhiBiasH = ZeroPhysVector;
+                PhiBiasAlias.Clear();
         } else if (atype == "biase") {
                 EnergyBias = false;
                 IPDFEnergyBias = false;
                 local_IPDFEnergyBias.Get().val = false;
                 EnergyBiasH = IPDFEnergyBiasH = ZeroPhysVector;
+                EnergyBiasAlias.Clear();
         } else if (atype == "biaspt") {
                 PosThetaBias = false;
                 IPDFPosThetaBias = false;
                 local_IPDFPosThetaBias.Get().val = false;
                 PosThetaBiasH = IPDFPosThetaBiasH = ZeroPhysVector;
+                PosThetaBiasAlias.Clear();
         } else if (atype == "biaspp") {
                 PosPhiBias = false;
                 IPDFPosPhiBias = false;
                 local_IPDFPosPhiBias.Get().val = false;
                 PosPhiBiasH = IPDFPosPhiBiasH = ZeroPhysVector;
+                PosPhiBiasAlias.Clear();
         } else {
                 G4cout << "Error, histtype not accepted " << G4endl;
   }
 }
 
+G4double G4SPSRandomGenerator::GenBiasedRand(const G4SPSAliasTable& table,
+                                             G4double& weight) const
+{
+  if (table.IsEmpty())
+  {
+    weight = 1.;
+    return G4UniformRand();
+  }
+  G4double frac = 0.;
+  std::size_t bin = table.SampleBin(G4UniformRand(), frac);
+  if (bin == 0)
+  {
+    // point mass at the lowest edge, weighted as the first bin
+    weight = (table.GetHighEdge(1) - table.GetLowEdge(1))
+           / table.GetBinProbability(1);
+    return table.GetLowEdge(0);
+  }
+  G4double xaxisl = table.GetLowEdge(bin);
+  G4double xaxisu = table.GetHighEdge(bin);
+  weight = (xaxisu - xaxisl) / table.GetBinProbability(bin);
+  return xaxisl + frac * (xaxisu - xaxisl);
+}
+
 G4double G4SPSRandomGenerator::GenRandX()
 {
   if (verbosityLevel >= 1)
@@ -294,44 +325,23 @@ G4double G4SPSRandomGenerator::GenRandX()
           IPDFXBiasH.InsertValues(bins[ii], vals[ii]);
         }
         IPDFXBias = true;
+        XBiasAlias.Build(IPDFXBiasH);
       }
     }
     
     // IPDF has been create so carry on
 
-    G4double rndm = G4UniformRand();
-
-    // Calculate the weighting: Find the bin that the determined
-    // rndm is in and the weigthing will be the difference in the
-    // natural probability (from the x-axis) divided by the
-    // difference in the biased probability (the area)
-    //
-    std::size_t numberOfBin = IPDFXBiasH.GetVectorLength();
-    G4int biasn1 = 0;
-    G4int biasn2 = numberOfBin / 2;
-    G4int biasn3 = numberOfBin - 1;
-    while (biasn1 != biasn3 - 1)
-    {
-      if (rndm > IPDFXBiasH(biasn2))
-        { biasn1 = biasn2; }
-      else
-        { biasn3 = biasn2; }
-      biasn2 = biasn1 + (biasn3 - biasn1 + 1) / 2;
-    }
-
-    // Retrieve the areas and then the x-axis values
+    // the bin is sampled with the alias table, the weighting is the
+    // natural probability (width of the bin) divided by the biased
+    // probability (the area)
     //
     bweights_t& w = bweights.Get();
-    w[0] = IPDFXBiasH(biasn2) - IPDFXBiasH(biasn2 - 1);
-    G4double xaxisl = IPDFXBiasH.GetLowEdgeEnergy(std::size_t(biasn2 - 1));
-    G4double xaxisu = IPDFXBiasH.GetLowEdgeEnergy(std::size_t(biasn2));
-    G4double NatProb = xaxisu - xaxisl;
-    w[0] = NatProb / w[0];
+    G4double rndm = GenBiasedRand(XBiasAlias, w[0]);
     if (verbosityLevel >= 1)
     {
       G4cout << "X bin weight " << w[0] << " " << rndm << G4endl;
     }
-    return (IPDFXBiasH.GetEnergy(rndm));
+    return rndm;
   }
 }
 
@@ -376,35 +386,23 @@ G4double G4SPSRandomGenerator::GenRandY()
           IPDFYBiasH.InsertValues(bins[ii], vals[ii]);
         }
         IPDFYBias = true;
+        YBiasAlias.Build(IPDFYBiasH);
       }
     }
 
     // IPDF has been created so carry on
 
-    G4double rndm = G4UniformRand();
-    std::size_t numberOfBin = IPDFYBiasH.GetVectorLength();
-    G4int biasn1 = 0;
-    G4int biasn2 = numberOfBin / 2;
-    G4int biasn3 = numberOfBin - 1;
-    while (biasn1 != biasn3 - 1)
-    {
-      if (rndm > IPDFYBiasH(biasn2))
-        { biasn1 = biasn2; }
-      else
-        { biasn3 = biasn2; }
-      biasn2 = biasn1 + (biasn3 - biasn1 + 1) / 2;
-    }
+    // the bin is sampled with the alias table, the weighting is the
+    // natural probability (width of the bin) divided by the biased
+    // probability (the area)
+    //
     bweights_t& w = bweights.Get();
-    w[1] = IPDFYBiasH(biasn2) - IPDFYBiasH(biasn2 - 1);
-    G4double xaxisl = IPDFYBiasH.GetLowEdgeEnergy(std::size_t(biasn2 - 1));
-    G4double xaxisu = IPDFYBiasH.GetLowEdgeEnergy(std::size_t(biasn2));
-    G4double NatProb = xaxisu - xaxisl;
-    w[1] = NatProb / w[1];
+    G4double rndm = GenBiasedRand(YBiasAlias, w[1]);
     if (verbosityLevel >= 1)
     {
       G4cout << "Y bin weight " << w[1] << " " << rndm << G4endl;
     }
-    return (IPDFYBiasH.GetEnergy(rndm));
+    return rndm;
   }
 }
 
@@ -449,35 +447,23 @@ G4double G4SPSRandomGenerator::GenRandZ()
           IPDFZBiasH.InsertValues(bins[ii], vals[ii]);
         }
         IPDFZBias = true;
+        ZBiasAlias.Build(IPDFZBiasH);
       }
     }
 
     // IPDF has been create so carry on
 
-    G4double rndm = G4UniformRand();
-    std::size_t numberOfBin = IPDFZBiasH.GetVectorLength();
-    G4int biasn1 = 0;
-    G4int biasn2 = numberOfBin / 2;
-    G4int biasn3 = numberOfBin - 1;
-    while (biasn1 != biasn3 - 1)
-    {
-      if (rndm > IPDFZBiasH(biasn2))
-        { biasn1 = biasn2; }
-      else
-        { biasn3 = biasn2; }
-      biasn2 = biasn1 + (biasn3 - biasn1 + 1) / 2;
-    }
+    // the bin is sampled with the alias table, the weighting is the
+    // natural probability (width of the bin) divided by the biased
+    // probability (the area)
+    //
     bweights_t& w = bweights.Get();
-    w[2] = IPDFZBiasH(biasn2) - IPDFZBiasH(biasn2 - 1);
-    G4double xaxisl = IPDFZBiasH.GetLowEdgeEnergy(std::size_t(biasn2 - 1));
-    G4double xaxisu = IPDFZBiasH.GetLowEdgeEnergy(std::size_t(biasn2));
-    G4double NatProb = xaxisu - xaxisl;
-    w[2] = NatProb / w[2];
+    G4double rndm = GenBiasedRand(ZBiasAlias, w[2]);
     if (verbosityLevel >= 1)
     {
       G4cout << "Z bin weight " << w[2] << " " << rndm << G4endl;
     }
-    return (IPDFZBiasH.GetEnergy(rndm));
+    return rndm;
   }
 }
 
@@ -523,35 +509,23 @@ G4double G4SPSRandomGenerator::GenRandTheta()
           IPDFThetaBiasH.InsertValues(bins[ii], vals[ii]);
         }
         IPDFThetaBias = true;
+        ThetaBiasAlias.Build(IPDFThetaBiasH);
       }
     }
 
     // IPDF has been create so carry on
 
-    G4double rndm = G4UniformRand();
-    std::size_t numberOfBin = IPDFThetaBiasH.GetVectorLength();
-    G4int biasn1 = 0;
-    G4int biasn2 = numberOfBin / 2;
-    G4int biasn3 = numberOfBin - 1;
-    while (biasn1 != biasn3 - 1)
-    {
-      if (rndm > IPDFThetaBiasH(biasn2))
-        { biasn1 = biasn2; }
-      else
-        { biasn3 = biasn2; }
-      biasn2 = biasn1 + (biasn3 - biasn1 + 1) / 2;
-    }
+    // the bin is sampled with the alias table, the weighting is the
+    // natural probability (width of the bin) divided by the biased
+    // probability (the area)
+    //
     bweights_t& w = bweights.Get();
-    w[3] = IPDFThetaBiasH(biasn2) - IPDFThetaBiasH(biasn2 - 1);
-    G4double xaxisl = IPDFThetaBiasH.GetLowEdgeEnergy(std::size_t(biasn2 - 1));
-    G4double xaxisu = IPDFThetaBiasH.GetLowEdgeEnergy(std::size_t(biasn2));
-    G4double NatProb = xaxisu - xaxisl;
-    w[3] = NatProb / w[3];
+    G4double rndm = GenBiasedRand(ThetaBiasAlias, w[3]);
     if (verbosityLevel >= 1)
     {
       G4cout << "Theta bin weight " << w[3] << " " << rndm << G4endl;
     }
-    return (IPDFThetaBiasH.GetEnergy(rndm));
+    return rndm;
   }
 }
 
@@ -596,35 +570,23 @@ G4double G4SPSRandomGenerator::GenRandPhi()
           IPDFPhiBiasH.InsertValues(bins[ii], vals[ii]);
         }
         IPDFPhiBias = true;
+        PhiBiasAlias.Build(IPDFPhiBiasH);
       }
     }
 
     // IPDF has been create so carry on
 
-    G4double rndm = G4UniformRand();
-    std::size_t numberOfBin = IPDFPhiBiasH.GetVectorLength();
-    G4int biasn1 = 0;
-    G4int biasn2 = numberOfBin / 2;
-    G4int biasn3 = numberOfBin - 1;
-    while (biasn1 != biasn3 - 1)
-    {
-      if (rndm > IPDFPhiBiasH(biasn2))
-        { biasn1 = biasn2; }
-      else
-        { biasn3 = biasn2; }
-      biasn2 = biasn1 + (biasn3 - biasn1 + 1) / 2;
-    }
+    // the bin is sampled with the alias table, the weighting is the
+    // natural probability (width of the bin) divided by the biased
+    // probability (the area)
+    //
     bweights_t& w = bweights.Get();
-    w[4] = IPDFPhiBiasH(biasn2) - IPDFPhiBiasH(biasn2 - 1);
-    G4double xaxisl = IPDFPhiBiasH.GetLowEdgeEnergy(std::size_t(biasn2 - 1));
-    G4double xaxisu = IPDFPhiBiasH.GetLowEdgeEnergy(std::size_t(biasn2));
-    G4double NatProb = xaxisu - xaxisl;
-    w[4] = NatProb / w[4];
+    G4double rndm = GenBiasedRand(PhiBiasAlias, w[4]);
     if (verbosityLevel >= 1)
     {
       G4cout << "Phi bin weight " << w[4] << " " << rndm << G4endl;
     }
-    return (IPDFPhiBiasH.GetEnergy(rndm));
+    return rndm;
   }
 }
 
@@ -669,35 +631,23 @@ G4double G4SPSRandomGenerator::GenRandEnergy()
           IPDFEnergyBiasH.InsertValues(bins[ii], vals[ii]);
         }
         IPDFEnergyBias = true;
+        EnergyBiasAlias.Build(IPDFEnergyBiasH);
       }
     }
 
     // IPDF has been create so carry on
 
-    G4double rndm = G4UniformRand();
-    std::size_t numberOfBin = IPDFEnergyBiasH.GetVectorLength();
-    G4int biasn1 = 0;
-    G4int biasn2 = numberOfBin / 2;
-    G4int biasn3 = numberOfBin - 1;
-    while (biasn1 != biasn3 - 1)
-    {
-      if (rndm > IPDFEnergyBiasH(biasn2))
-        { biasn1 = biasn2; }
-      else
-        { biasn3 = biasn2; }
-      biasn2 = biasn1 + (biasn3 - biasn1 + 1) / 2;
-    }
+    // the bin is sampled with the alias table, the weighting is the
+    // natural probability (width of the bin) divided by the biased
+    // probability (the area)
+    //
     bweights_t& w = bweights.Get();
-    w[5] = IPDFEnergyBiasH(biasn2) - IPDFEnergyBiasH(biasn2 - 1);
-    G4double xaxisl = IPDFEnergyBiasH.GetLowEdgeEnergy(std::size_t(biasn2 - 1));
-    G4double xaxisu = IPDFEnergyBiasH.GetLowEdgeEnergy(std::size_t(biasn2));
-    G4double NatProb = xaxisu - xaxisl;
-    w[5] = NatProb / w[5];
+    G4double rndm = GenBiasedRand(EnergyBiasAlias, w[5]);
     if (verbosityLevel >= 1)
     {
       G4cout << "Energy bin weight " << w[5] << " " << rndm << G4endl;
     }
-    return (IPDFEnergyBiasH.GetEnergy(rndm));
+    return rndm;
   }
 }
 
@@ -743,35 +693,23 @@ G4double G4SPSRandomGenerator::GenRandPosTheta()
           IPDFPosThetaBiasH.InsertValues(bins[ii], vals[ii]);
         }
         IPDFPosThetaBias = true;
+        PosThetaBiasAlias.Build(IPDFPosThetaBiasH);
       }
     }
 
     // IPDF has been create so carry on
     //
-    G4double rndm = G4UniformRand();
-    std::size_t numberOfBin = IPDFPosThetaBiasH.GetVectorLength();
-    G4int biasn1 = 0;
-    G4int biasn2 = numberOfBin / 2;
-    G4int biasn3 = numberOfBin - 1;
-    while (biasn1 != biasn3 - 1)
-    {
-      if (rndm > IPDFPosThetaBiasH(biasn2))
-        { biasn1 = biasn2; }
-      else
-        { biasn3 = biasn2; }
-      biasn2 = biasn1 + (biasn3 - biasn1 + 1) / 2;
-    }
+    // the bin is sampled with the alias table, the weighting is the
+    // natural probability (width of the bin) divided by the biased
+    // probability (the area)
+    //
     bweights_t& w = bweights.Get();
-    w[6] = IPDFPosThetaBiasH(biasn2) - IPDFPosThetaBiasH(biasn2 - 1);
-    G4double xaxisl = IPDFPosThetaBiasH.GetLowEdgeEnergy(std::size_t(biasn2-1));
-    G4double xaxisu = IPDFPosThetaBiasH.GetLowEdgeEnergy(std::size_t(biasn2));
-    G4double NatProb = xaxisu - xaxisl;
-    w[6] = NatProb / w[6];
+    G4double rndm = GenBiasedRand(PosThetaBiasAlias, w[6]);
     if (verbosityLevel >= 1)
     {
       G4cout << "PosTheta bin weight " << w[6] << " " << rndm << G4endl;
     }
-    return (IPDFPosThetaBiasH.GetEnergy(rndm));
+    return rndm;
   }
 }
 
@@ -816,34 +754,22 @@ G4double G4SPSRandomGenerator::GenRandPosPhi()
           IPDFPosPhiBiasH.InsertValues(bins[ii], vals[ii]);
         }
         IPDFPosPhiBias = true;
+        PosPhiBiasAlias.Build(IPDFPosPhiBiasH);
       }
     }
 
     // IPDF has been create so carry on
 
-    G4double rndm = G4UniformRand();
-    std::size_t numberOfBin = IPDFPosPhiBiasH.GetVectorLength();
-    G4int biasn1 = 0;
-    G4int biasn2 = numberOfBin / 2;
-    G4int biasn3 = numberOfBin - 1;
-    while (biasn1 != biasn3 - 1)
-    {
-      if (rndm > IPDFPosPhiBiasH(biasn2))
-        { biasn1 = biasn2; }
-      else
-        { biasn3 = biasn2; }
-      biasn2 = biasn1 + (biasn3 - biasn1 + 1) / 2;
-    }
+    // the bin is sampled with the alias table, the weighting is the
+    // natural probability (width of the bin) divided by the biased
+    // probability (the area)
+    //
     bweights_t& w = bweights.Get();
-    w[7] = IPDFPosPhiBiasH(biasn2) - IPDFPosPhiBiasH(biasn2 - 1);
-    G4double xaxisl = IPDFPosPhiBiasH.GetLowEdgeEnergy(std::size_t(biasn2 - 1));
-    G4double xaxisu = IPDFPosPhiBiasH.GetLowEdgeEnergy(std::size_t(biasn2));
-    G4double NatProb = xaxisu - xaxisl;
-    w[7] = NatProb / w[7];
+    G4double rndm = GenBiasedRand(PosPhiBiasAlias, w[7]);
     if (verbosityLevel >= 1)
     {
       G4cout << "PosPhi bin weight " << w[7] << " " << rndm << G4endl;
     }
-    return (IPDFPosPhiBiasH.GetEnergy(rndm));
+    return rndm;
   }
 }
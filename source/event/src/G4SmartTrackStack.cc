@@ -139,6 +139,14 @@ void G4SmartTrackStack::PushToStack( const G4StackedTrack& aStackedTrack )
   if (nTracks > maxNTracks) maxNTracks = nTracks;
 }
 
+void G4SmartTrackStack::SetSpillThreshold(std::size_t n, const G4String& dir)
+{
+  for (G4int i = 0; i < nTurn; ++i)
+  {
+    stacks[i]->SetSpillThreshold(n, dir);
+  }
+}
+
 void G4SmartTrackStack::clear()
 {
   for (G4int i = 0; i < nTurn; ++i)
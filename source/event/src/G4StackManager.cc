@@ -30,6 +30,7 @@
 
 #include "G4StackManager.hh"
 #include "G4StackingMessenger.hh"
+#include "G4EventManager.hh"
 #include "G4VTrajectory.hh"
 #include "G4ios.hh"
 
@@ -65,10 +66,12 @@ G4StackManager::~G4StackManager()
   {
     G4cout << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << G4endl;
     G4cout << " Maximum number of tracks in the urgent stack : " << urgentStack->GetMaxNTrack() << G4endl;
+    if(bucketedStack != nullptr) { bucketedStack->DumpStatistics(); }
     G4cout << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << G4endl;
   }
 #endif
   delete urgentStack;
+  delete bucketedStack;
   delete waitingStack;
   delete postponeStack;
   delete theMessenger;
@@ -79,6 +82,10 @@ G4StackManager::~G4StackManager()
       delete additionalWaitingStacks[i];
     }
   }
+  for(auto subEventStack : subEventStacks)
+  {
+    delete subEventStack;
+  }
 }
 
 G4int G4StackManager::
@@ -138,7 +145,7 @@ PushOneTrack(G4Track* newTrack, G4VTrajectory* newTrajectory)
     switch (classification)
     {
       case fUrgent:
-        urgentStack->PushToStack( newStackedTrack );
+        PushToUrgentStack( newStackedTrack );
         break;
       case fWaiting:
         waitingStack->PushToStack( newStackedTrack );
@@ -147,6 +154,12 @@ PushOneTrack(G4Track* newTrack, G4VTrajectory* newTrajectory)
         postponeStack->PushToStack( newStackedTrack );
         break;
       default:
+        if(classification >= fSubEvent_0)
+        {
+          PushToSubEventStack(classification, newStackedTrack,
+                              "G4StackManager::PushOneTrack");
+          break;
+        }
         G4int i = classification - 10;
         if(i<1 || i>numberOfAdditionalWaitingStacks)
         {
@@ -185,7 +198,7 @@ G4Track* G4StackManager::PopNextTrack(G4VTrajectory** newTrajectory)
              << " waiting tracks are re-classified to" << G4endl;
     }
 #endif
-    waitingStack->TransferTo(urgentStack);
+    TransferToUrgentStack(waitingStack);
     if(numberOfAdditionalWaitingStacks>0)
     {
       for(G4int i=0; i<numberOfAdditionalWaitingStacks; ++i)
@@ -215,7 +228,7 @@ G4Track* G4StackManager::PopNextTrack(G4VTrajectory** newTrajectory)
       return 0;
   }
 
-  G4StackedTrack selectedStackedTrack = urgentStack->PopFromStack();
+  G4StackedTrack selectedStackedTrack = PopFromUrgentStack();
   G4Track * selectedTrack = selectedStackedTrack.GetTrack();
   *newTrajectory = selectedStackedTrack.GetTrajectory();
 
@@ -241,7 +254,7 @@ void G4StackManager::ReClassify()
   if( userStackingAction == nullptr ) return;
   if( GetNUrgentTrack() == 0 ) return;
   
-  urgentStack->TransferTo(&tmpStack);
+  TransferFromUrgentStack(&tmpStack);
   while( tmpStack.GetNTrack() > 0 )
   {
     aStackedTrack=tmpStack.PopFromStack();
@@ -254,7 +267,7 @@ void G4StackManager::ReClassify()
         delete aStackedTrack.GetTrajectory();
         break;
       case fUrgent:
-        urgentStack->PushToStack( aStackedTrack );
+        PushToUrgentStack( aStackedTrack );
         break;
       case fWaiting:
         waitingStack->PushToStack( aStackedTrack );
@@ -263,6 +276,12 @@ void G4StackManager::ReClassify()
         postponeStack->PushToStack( aStackedTrack );
         break;
       default:
+        if(classification >= fSubEvent_0)
+        {
+          PushToSubEventStack(classification, aStackedTrack,
+                              "G4StackManager::ReClassify");
+          break;
+        }
         G4int i = classification - 10;
         if(i<1||i>numberOfAdditionalWaitingStacks)
         {
@@ -290,7 +309,7 @@ G4int G4StackManager::PrepareNewEvent()
   // Set the urgentStack in a defined state. Not doing it would
   // affect reproducibility
   //
-  urgentStack->clearAndDestroy();
+  ClearAndDestroyUrgentStack();
   
   G4int n_passedFromPrevious = 0;
   
@@ -335,7 +354,7 @@ G4int G4StackManager::PrepareNewEvent()
         switch (classification)
         {
           case fUrgent:
-            urgentStack->PushToStack( aStackedTrack );
+            PushToUrgentStack( aStackedTrack );
             break;
           case fWaiting:
             waitingStack->PushToStack( aStackedTrack );
@@ -344,6 +363,12 @@ G4int G4StackManager::PrepareNewEvent()
             postponeStack->PushToStack( aStackedTrack );
             break;
           default:
+            if(classification >= fSubEvent_0)
+            {
+              PushToSubEventStack(classification, aStackedTrack,
+                                  "G4StackManager::PrepareNewEvent");
+              break;
+            }
             G4int i = classification - 10;
             if(i<1||i>numberOfAdditionalWaitingStacks)
             {
@@ -371,6 +396,7 @@ void G4StackManager::SetNumberOfAdditionalWaitingStacks(G4int iAdd)
     for(G4int i=numberOfAdditionalWaitingStacks; i<iAdd; ++i)
     {
       G4TrackStack* newStack = new G4TrackStack;
+      newStack->SetSpillThreshold(spillThreshold, spillDir);
       additionalWaitingStacks.push_back(newStack);
     }
     numberOfAdditionalWaitingStacks = iAdd;
@@ -384,6 +410,144 @@ void G4StackManager::SetNumberOfAdditionalWaitingStacks(G4int iAdd)
   }
 }
 
+void G4StackManager::SetBucketing(G4int mode)
+{
+  if(GetNUrgentTrack() > 0)
+  {
+    G4Exception("G4StackManager::SetBucketing", "Event0056", JustWarning,
+                "The urgent stack is not empty. Policy is not changed.");
+    return;
+  }
+  if(mode == GetBucketing()) return;
+
+  delete bucketedStack;
+  bucketedStack = nullptr;
+  if(mode > 0)
+  {
+    bucketedStack = new G4BucketedTrackStack(mode > 1);
+    bucketedStack->SetSpillThreshold(spillThreshold, spillDir);
+  }
+}
+
+G4int G4StackManager::GetBucketing() const
+{
+  if(bucketedStack == nullptr) { return 0; }
+  return bucketedStack->IsPerRegion() ? 2 : 1;
+}
+
+void G4StackManager::DumpBucketStatistics() const
+{
+  if(bucketedStack != nullptr) { bucketedStack->DumpStatistics(); }
+}
+
+void G4StackManager::SetSpillThreshold(G4int nTrack, const G4String& dir)
+{
+  spillThreshold = (nTrack > 0) ? nTrack : 0;
+  spillDir = dir;
+  urgentStack->SetSpillThreshold(spillThreshold, spillDir);
+  if(bucketedStack != nullptr)
+  {
+    bucketedStack->SetSpillThreshold(spillThreshold, spillDir);
+  }
+  waitingStack->SetSpillThreshold(spillThreshold, spillDir);
+  for(auto additionalStack : additionalWaitingStacks)
+  {
+    additionalStack->SetSpillThreshold(spillThreshold, spillDir);
+  }
+}
+
+G4int G4StackManager::GetNSpilledTrack() const
+{
+  G4int n = G4int(waitingStack->GetNSpilledTrack());
+  for(auto additionalStack : additionalWaitingStacks)
+  {
+    n += G4int(additionalStack->GetNSpilledTrack());
+  }
+#ifndef G4_USESMARTSTACK
+  if(bucketedStack == nullptr)
+  {
+    n += G4int(urgentStack->GetNSpilledTrack());
+  }
+#endif
+  return n;
+}
+
+void G4StackManager::RegisterSubEventType(G4int ty, G4int maxEnt)
+{
+  if(ty < 0 || ty > fSubEvent_9 - fSubEvent_0 || maxEnt < 1)
+  {
+    G4ExceptionDescription ED;
+    ED << "Invalid sub-event type " << ty << " or maximum number of entries "
+       << maxEnt << ". Sub-event type must be 0 to "
+       << fSubEvent_9 - fSubEvent_0 << ".";
+    G4Exception("G4StackManager::RegisterSubEventType", "Event0055",
+                JustWarning, ED);
+    return;
+  }
+  if(G4int(subEventStacks.size()) <= ty)
+  {
+    subEventStacks.resize(ty+1, nullptr);
+    subEventMaxEntries.resize(ty+1, 0);
+  }
+  if(subEventStacks[ty] == nullptr)
+  {
+    subEventStacks[ty] = new G4TrackStack(maxEnt);
+  }
+  subEventMaxEntries[ty] = maxEnt;
+}
+
+void G4StackManager::
+PushToSubEventStack(G4ClassificationOfNewTrack classification,
+                    const G4StackedTrack& aStackedTrack, const char* origin)
+{
+  if(subEventProcessing)
+  {
+    PushToUrgentStack( aStackedTrack );
+    return;
+  }
+
+  G4int ty = classification - fSubEvent_0;
+  if(ty > fSubEvent_9 - fSubEvent_0 || ty >= G4int(subEventStacks.size())
+     || subEventStacks[ty] == nullptr)
+  {
+    G4ExceptionDescription ED;
+    ED << "invalid classification " << classification
+       << " : sub-event type " << ty << " is not registered." << G4endl;
+    G4Exception(origin, "Event0054", FatalException, ED);
+    return;
+  }
+
+  subEventStacks[ty]->PushToStack( aStackedTrack );
+  if(G4int(subEventStacks[ty]->GetNTrack()) >= subEventMaxEntries[ty])
+  {
+    ReleaseSubEvent(ty);
+  }
+}
+
+void G4StackManager::ReleaseSubEvent(G4int ty)
+{
+#ifdef G4VERBOSE
+  if( verboseLevel > 1 )
+  {
+    G4cout << "### " << subEventStacks[ty]->GetNTrack()
+           << " tracks are detached as a sub-event of type " << ty
+           << G4endl;
+  }
+#endif
+  G4EventManager::GetEventManager()->SpawnSubEvent(ty, subEventStacks[ty]);
+}
+
+void G4StackManager::ReleaseSubEvents()
+{
+  for(G4int ty=0; ty<G4int(subEventStacks.size()); ++ty)
+  {
+    if(subEventStacks[ty] != nullptr && subEventStacks[ty]->GetNTrack() > 0)
+    {
+      ReleaseSubEvent(ty);
+    }
+  }
+}
+
 void G4StackManager::
 TransferStackedTracks(G4ClassificationOfNewTrack origin,
                       G4ClassificationOfNewTrack destination)
@@ -419,7 +583,7 @@ TransferStackedTracks(G4ClassificationOfNewTrack origin,
     }
     else
     {
-      urgentStack->clearAndDestroy();
+      ClearAndDestroyUrgentStack();
     }
   }
   else
@@ -452,12 +616,12 @@ TransferStackedTracks(G4ClassificationOfNewTrack origin,
       }
       else
       {
-        originStack->TransferTo(urgentStack);
+        TransferToUrgentStack(originStack);
       }
     }
     else
     {
-      urgentStack->TransferTo(targetStack);
+      TransferFromUrgentStack(targetStack);
     }
   }
   return;
@@ -499,9 +663,9 @@ TransferOneStackedTrack(G4ClassificationOfNewTrack origin,
       delete aStackedTrack.GetTrack();
       delete aStackedTrack.GetTrajectory();
     }
-    else if (urgentStack->GetNTrack() )
+    else if (GetNUrgentTrack() > 0)
     {
-      aStackedTrack = urgentStack->PopFromStack();
+      aStackedTrack = PopFromUrgentStack();
       delete aStackedTrack.GetTrack();
       delete aStackedTrack.GetTrajectory();
     }
@@ -532,13 +696,13 @@ TransferOneStackedTrack(G4ClassificationOfNewTrack origin,
     {
       aStackedTrack = originStack->PopFromStack();
       if(targetStack) { targetStack->PushToStack(aStackedTrack); }
-      else            { urgentStack->PushToStack(aStackedTrack); }
+      else            { PushToUrgentStack(aStackedTrack); }
     }
-    else if(urgentStack->GetNTrack())
+    else if(GetNUrgentTrack() > 0)
     {
-      aStackedTrack = urgentStack->PopFromStack();
+      aStackedTrack = PopFromUrgentStack();
       if(targetStack) { targetStack->PushToStack(aStackedTrack); }
-      else            { urgentStack->PushToStack(aStackedTrack); }
+      else            { PushToUrgentStack(aStackedTrack); }
     }
   }
   return;
@@ -552,11 +716,15 @@ void G4StackManager::clear()
   {
     ClearWaitingStack(i);
   }
+  for(auto subEventStack : subEventStacks)
+  {
+    if(subEventStack != nullptr) { subEventStack->clearAndDestroy(); }
+  }
 }
 
 void G4StackManager::ClearUrgentStack()
 {
-  urgentStack->clearAndDestroy();
+  ClearAndDestroyUrgentStack();
 }
 
 void G4StackManager::ClearWaitingStack(G4int i)
@@ -581,18 +749,20 @@ void G4StackManager::ClearPostponeStack()
 
 G4int G4StackManager::GetNTotalTrack() const
 {
-  G4int n = urgentStack->GetNTrack()
+  G4int n = GetNUrgentTrack()
           + waitingStack->GetNTrack()
           + postponeStack->GetNTrack();
   for(G4int i=1; i<=numberOfAdditionalWaitingStacks; ++i)
   {
     n += additionalWaitingStacks[i-1]->GetNTrack();
   }
+  n += GetNSubEventTrack();
   return n;
 }
 
 G4int G4StackManager::GetNUrgentTrack() const
 {
+  if(bucketedStack != nullptr) { return bucketedStack->GetNTrack(); }
   return urgentStack->GetNTrack();
 }
 
@@ -617,6 +787,16 @@ G4int G4StackManager::GetNPostponedTrack() const
   return postponeStack->GetNTrack();
 }
 
+G4int G4StackManager::GetNSubEventTrack() const
+{
+  G4int n = 0;
+  for(auto subEventStack : subEventStacks)
+  {
+    if(subEventStack != nullptr) { n += subEventStack->GetNTrack(); }
+  }
+  return n;
+}
+
 void G4StackManager::SetVerboseLevel( G4int const value )
 {
   verboseLevel = value;
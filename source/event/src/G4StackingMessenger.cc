@@ -33,6 +33,9 @@
 #include "G4UIdirectory.hh"
 #include "G4UIcmdWithoutParameter.hh"
 #include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4Tokenizer.hh"
 #include "G4ios.hh"
 
 G4StackingMessenger::G4StackingMessenger(G4StackManager* fCont)
@@ -62,6 +65,52 @@ G4StackingMessenger::G4StackingMessenger(G4StackManager* fCont)
   verboseCmd->SetGuidance(" 1 : Minimum statistics");
   verboseCmd->SetGuidance(" 2 : Detailed reports");
   verboseCmd->SetGuidance("Note - this value is overwritten by /event/verbose command.");
+
+  subEvtCmd = new G4UIcommand("/event/stack/registerSubEvent",this);
+  subEvtCmd->SetGuidance("Register a sub-event type.");
+  subEvtCmd->SetGuidance("Tracks classified as fSubEvent_<type> by the user stacking");
+  subEvtCmd->SetGuidance("action are stored in a dedicated stack and are handed to");
+  subEvtCmd->SetGuidance("another worker thread as a sub-event when <maxEntries>");
+  subEvtCmd->SetGuidance("tracks are accumulated or at the end of the event.");
+  subEvtCmd->SetGuidance("Sub-events are processed by other threads only with");
+  subEvtCmd->SetGuidance("G4TaskRunManager, otherwise they are processed in place.");
+  auto typeParam = new G4UIparameter("type",'i',false);
+  typeParam->SetParameterRange("type>=0&&type<10");
+  subEvtCmd->SetParameter(typeParam);
+  auto maxParam = new G4UIparameter("maxEntries",'i',true);
+  maxParam->SetDefaultValue(1000);
+  maxParam->SetParameterRange("maxEntries>0");
+  subEvtCmd->SetParameter(maxParam);
+  subEvtCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  bucketCmd = new G4UIcmdWithAnInteger("/event/stack/bucketing",this);
+  bucketCmd->SetGuidance("Set the policy of the urgent stack.");
+  bucketCmd->SetGuidance(" 0 : ordinary LIFO stack (default)");
+  bucketCmd->SetGuidance(" 1 : urgent tracks are grouped by particle type and");
+  bucketCmd->SetGuidance("     one group is processed at a time");
+  bucketCmd->SetGuidance(" 2 : as 1, tracks being grouped by particle type and");
+  bucketCmd->SetGuidance("     region of their current volume");
+  bucketCmd->SetGuidance("Statistics are shown by /event/stack/status.");
+  bucketCmd->SetParameterName("mode",true);
+  bucketCmd->SetDefaultValue(1);
+  bucketCmd->SetRange("mode>=0&&mode<=2");
+  bucketCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  spillCmd = new G4UIcommand("/event/stack/spillThreshold",this);
+  spillCmd->SetGuidance("Set the maximum number of tracks kept in memory by");
+  spillCmd->SetGuidance("each urgent and waiting stack. Beyond it, the oldest");
+  spillCmd->SetGuidance("tracks are written to a temporary file and read back");
+  spillCmd->SetGuidance("when the tracks in memory are exhausted.");
+  spillCmd->SetGuidance("Each thread uses its own files, created in <directory>");
+  spillCmd->SetGuidance("or in the default temporary directory if omitted.");
+  spillCmd->SetGuidance("Zero (default) disables spilling.");
+  auto nTrackParam = new G4UIparameter("nTrack",'i',false);
+  nTrackParam->SetParameterRange("nTrack>=0");
+  spillCmd->SetParameter(nTrackParam);
+  auto dirParam = new G4UIparameter("directory",'s',true);
+  dirParam->SetDefaultValue("");
+  spillCmd->SetParameter(dirParam);
+  spillCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
 }
 
 G4StackingMessenger::~G4StackingMessenger()
@@ -69,6 +118,9 @@ G4StackingMessenger::~G4StackingMessenger()
   delete statusCmd;
   delete clearCmd;
   delete verboseCmd;
+  delete subEvtCmd;
+  delete bucketCmd;
+  delete spillCmd;
   delete stackDir;
 }
 
@@ -86,6 +138,14 @@ void G4StackingMessenger::SetNewValue(G4UIcommand* command, G4String newValues)
            << G4endl;
     G4cout << "    Postponed stack : " << fContainer->GetNPostponedTrack()
            << G4endl;
+    G4cout << "    Sub-event stacks: " << fContainer->GetNSubEventTrack()
+           << G4endl;
+    if(fContainer->GetSpillThreshold() > 0)
+    {
+      G4cout << "    Spilled to disk : " << fContainer->GetNSpilledTrack()
+             << G4endl;
+    }
+    fContainer->DumpBucketStatistics();
   }
   else if( command==clearCmd )
   {
@@ -113,4 +173,22 @@ void G4StackingMessenger::SetNewValue(G4UIcommand* command, G4String newValues)
   {
     fContainer->SetVerboseLevel(verboseCmd->GetNewIntValue(newValues));
   }
+  else if( command==subEvtCmd )
+  {
+    G4Tokenizer next(newValues);
+    G4int ty = StoI(next());
+    G4int maxEnt = StoI(next());
+    fContainer->RegisterSubEventType(ty,maxEnt);
+  }
+  else if( command==bucketCmd )
+  {
+    fContainer->SetBucketing(bucketCmd->GetNewIntValue(newValues));
+  }
+  else if( command==spillCmd )
+  {
+    G4Tokenizer next(newValues);
+    G4int nTrack = StoI(next());
+    G4String dir = next();
+    fContainer->SetSpillThreshold(nTrack,dir);
+  }
 }
@@ -0,0 +1,215 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4SubEvent class implementation
+// --------------------------------------------------------------------
+
+#include "G4SubEvent.hh"
+#include "G4AutoLock.hh"
+#include "G4Event.hh"
+#include "G4Track.hh"
+#include "G4DynamicParticle.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4VProcess.hh"
+
+#include <unordered_map>
+
+namespace
+{
+  using G4SharedProcessMap
+    = std::unordered_map<const G4VProcess*, const G4VProcess*>;
+
+  G4SharedProcessMap*& sharedProcessMap()
+  {
+    G4ThreadLocalStatic G4SharedProcessMap* _instance = nullptr;
+    return _instance;
+  }
+}
+
+G4SubEvent::G4SubEvent(G4int evID, G4int subEvtType, G4long s1, G4long s2,
+                       G4int idOffset)
+  : eventID(evID), subEventType(subEvtType), seed1(s1), seed2(s2),
+    trackIDOffset(idOffset)
+{
+}
+
+G4SubEvent::~G4SubEvent()
+{
+  for(auto& st : tracks)
+  {
+    delete st.userInfo;
+  }
+}
+
+void G4SubEvent::StoreTrack(const G4Track* aTrack)
+{
+  const G4DynamicParticle* dp = aTrack->GetDynamicParticle();
+  StoredTrack st;
+  st.particle = dp->GetParticleDefinition();
+  st.momentumDirection = dp->GetMomentumDirection();
+  st.polarization = dp->GetPolarization();
+  st.kineticEnergy = dp->GetKineticEnergy();
+  st.mass = dp->GetMass();
+  st.charge = dp->GetCharge();
+  st.magneticMoment = dp->GetMagneticMoment();
+  st.dynamicProperTime = dp->GetProperTime();
+  st.primaryParticle = dp->GetPrimaryParticle();
+  st.pdgCode = dp->GetPDGcode();
+
+  st.position = aTrack->GetPosition();
+  st.globalTime = aTrack->GetGlobalTime();
+  st.localTime = aTrack->GetLocalTime();
+  st.properTime = aTrack->GetProperTime();
+  st.weight = aTrack->GetWeight();
+  st.trackID = aTrack->GetTrackID();
+  st.parentID = aTrack->GetParentID();
+  st.creatorProcess = GetSharedProcess(aTrack->GetCreatorProcess());
+  st.creatorModelID = aTrack->GetCreatorModelID();
+  st.vertexPosition = aTrack->GetVertexPosition();
+  st.vertexMomentumDirection = aTrack->GetVertexMomentumDirection();
+  st.vertexKineticEnergy = aTrack->GetVertexKineticEnergy();
+  st.vertexVolume = aTrack->GetLogicalVolumeAtVertex();
+  st.userInfo = aTrack->GetUserInformation();
+  aTrack->SetUserInformation(nullptr);
+
+  tracks.push_back(st);
+}
+
+G4TrackVector* G4SubEvent::GimmeTracks()
+{
+  auto trackVector = new G4TrackVector;
+  trackVector->reserve(tracks.size());
+  for(auto& st : tracks)
+  {
+    auto dp = new G4DynamicParticle(st.particle, st.momentumDirection,
+                                    st.kineticEnergy);
+    dp->SetPolarization(st.polarization);
+    dp->SetMass(st.mass);
+    dp->SetCharge(st.charge);
+    dp->SetMagneticMoment(st.magneticMoment);
+    dp->SetProperTime(st.dynamicProperTime);
+    dp->SetPrimaryParticle(st.primaryParticle);
+    dp->SetPDGcode(st.pdgCode);
+
+    auto aTrack = new G4Track(dp, st.globalTime, st.position);
+    aTrack->SetLocalTime(st.localTime);
+    aTrack->SetProperTime(st.properTime);
+    aTrack->SetWeight(st.weight);
+    aTrack->SetTrackID(st.trackID);
+    aTrack->SetParentID(st.parentID);
+    aTrack->SetCreatorProcess(GetLocalProcess(st.creatorProcess));
+    aTrack->SetCreatorModelID(st.creatorModelID);
+    aTrack->SetVertexPosition(st.vertexPosition);
+    aTrack->SetVertexMomentumDirection(st.vertexMomentumDirection);
+    aTrack->SetVertexKineticEnergy(st.vertexKineticEnergy);
+    aTrack->SetLogicalVolumeAtVertex(st.vertexVolume);
+    aTrack->SetUserInformation(st.userInfo);
+    st.userInfo = nullptr;
+    trackVector->push_back(aTrack);
+  }
+  return trackVector;
+}
+
+G4bool G4SubEvent::Claim()
+{
+  G4int expected = fPending;
+  return status.compare_exchange_strong(expected, fProcessing);
+}
+
+G4bool G4SubEvent::Reclaim()
+{
+  G4int expected = fPending;
+  return status.compare_exchange_strong(expected, fReclaimed);
+}
+
+void G4SubEvent::SetProcessed(G4Event* aResult)
+{
+  G4AutoLock l(&resultMutex);
+  result = aResult;
+  status = fProcessed;
+  G4CONDITIONBROADCAST(&resultReady);
+}
+
+G4Event* G4SubEvent::WaitForResult()
+{
+  if(status == fReclaimed) return nullptr;
+  G4AutoLock l(&resultMutex);
+  G4CONDITIONWAITLAMBDA(&resultReady, &l,
+                        [this]() { return status == fProcessed; });
+  return result;
+}
+
+void G4SubEvent::Release()
+{
+  if(--refCount == 0)
+  {
+    delete this;
+  }
+}
+
+const G4VProcess* G4SubEvent::GetSharedProcess(const G4VProcess* proc)
+{
+  if(proc == nullptr) return nullptr;
+  const G4VProcess* masterProc = proc->GetMasterProcess();
+  return (masterProc != nullptr) ? masterProc : proc;
+}
+
+const G4VProcess* G4SubEvent::GetLocalProcess(const G4VProcess* sharedProc)
+{
+  if(sharedProc == nullptr) return nullptr;
+  G4SharedProcessMap*& procMap = sharedProcessMap();
+  if(procMap == nullptr) procMap = new G4SharedProcessMap;
+  auto itr = procMap->find(sharedProc);
+  if(itr == procMap->end())
+  {
+    // The process may have been added since the map was last filled
+    // (e.g. physics modified between runs): refill it
+    procMap->clear();
+    auto pItr = G4ParticleTable::GetParticleTable()->GetIterator();
+    pItr->reset();
+    while((*pItr)())
+    {
+      G4ProcessManager* pm = pItr->value()->GetProcessManager();
+      if(pm == nullptr) continue;
+      G4ProcessVector* procs = pm->GetProcessList();
+      for(G4int i = 0; i < (G4int)procs->size(); ++i)
+      {
+        const G4VProcess* localProc = (*procs)[i];
+        (*procMap)[GetSharedProcess(localProc)] = localProc;
+      }
+    }
+    itr = procMap->find(sharedProc);
+    if(itr == procMap->end())
+    {
+      // Not a registered process (e.g. sequential mode): use it as it is
+      (*procMap)[sharedProc] = sharedProc;
+      return sharedProc;
+    }
+  }
+  return itr->second;
+}
@@ -30,16 +30,156 @@
 
 #include "G4TrackStack.hh"
 #include "G4SmartTrackStack.hh"
+#include "G4BucketedTrackStack.hh"
 #include "G4VTrajectory.hh"
 #include "G4Track.hh"
+#include "G4DynamicParticle.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+
+#if !defined(WIN32)
+#  include <cstdlib>
+#  include <unistd.h>
+#endif
+
+namespace
+{
+  // Compact image of a G4Track, made of plain data only. Particles,
+  // processes and volumes are indices to the pointer table of the stack,
+  // -1 for none.
+  struct SpilledTrack
+  {
+    G4int particle;
+    G4ThreeVector momentumDirection;
+    G4ThreeVector polarization;
+    G4double kineticEnergy;
+    G4double mass;
+    G4double charge;
+    G4double magneticMoment;
+    G4double dynamicProperTime;
+    G4int pdgCode;
+
+    G4ThreeVector position;
+    G4double globalTime;
+    G4double localTime;
+    G4double weight;
+    G4int trackID;
+    G4int parentID;
+    G4int trackStatus;
+    G4bool belowThreshold;
+    G4bool goodForTracking;
+    G4int creatorProcess;
+    G4int creatorModelID;
+    G4ThreeVector vertexPosition;
+    G4ThreeVector vertexMomentumDirection;
+    G4double vertexKineticEnergy;
+    G4int vertexVolume;
+  };
+
+  G4bool IsSpillable(const G4Track* aTrack)
+  {
+    // Tracks which already made steps and states which cannot be
+    // represented in SpilledTrack are kept in memory
+    const G4DynamicParticle* dp = aTrack->GetDynamicParticle();
+    return aTrack->GetCurrentStepNumber() == 0
+        && aTrack->GetAuxiliaryTrackInformationMap() == nullptr
+        && !aTrack->UseGivenVelocity()
+        && dp->GetElectronOccupancy() == nullptr
+        && dp->GetPreAssignedDecayProducts() == nullptr
+        && dp->GetPreAssignedDecayProperTime() < 0.;
+  }
+
+  void Store(const G4Track* aTrack, SpilledTrack& st)
+  {
+    const G4DynamicParticle* dp = aTrack->GetDynamicParticle();
+    st.momentumDirection = dp->GetMomentumDirection();
+    st.polarization = dp->GetPolarization();
+    st.kineticEnergy = dp->GetKineticEnergy();
+    st.mass = dp->GetMass();
+    st.charge = dp->GetCharge();
+    st.magneticMoment = dp->GetMagneticMoment();
+    st.dynamicProperTime = dp->GetProperTime();
+    st.pdgCode = dp->GetPDGcode();
+
+    st.position = aTrack->GetPosition();
+    st.globalTime = aTrack->GetGlobalTime();
+    st.localTime = aTrack->GetLocalTime();
+    st.weight = aTrack->GetWeight();
+    st.trackID = aTrack->GetTrackID();
+    st.parentID = aTrack->GetParentID();
+    st.trackStatus = aTrack->GetTrackStatus();
+    st.belowThreshold = aTrack->IsBelowThreshold();
+    st.goodForTracking = aTrack->IsGoodForTracking();
+    st.creatorModelID = aTrack->GetCreatorModelID();
+    st.vertexPosition = aTrack->GetVertexPosition();
+    st.vertexMomentumDirection = aTrack->GetVertexMomentumDirection();
+    st.vertexKineticEnergy = aTrack->GetVertexKineticEnergy();
+  }
+
+  G4Track* Restore(const SpilledTrack& st,
+                   const std::vector<const void*>& pointers)
+  {
+    auto pointer = [&pointers](G4int i)
+      { return i < 0 ? nullptr : pointers[i]; };
+
+    auto dp = new G4DynamicParticle(
+      static_cast<const G4ParticleDefinition*>(pointer(st.particle)),
+      st.momentumDirection, st.kineticEnergy);
+    dp->SetPolarization(st.polarization);
+    dp->SetMass(st.mass);
+    dp->SetCharge(st.charge);
+    dp->SetMagneticMoment(st.magneticMoment);
+    dp->SetProperTime(st.dynamicProperTime);
+    dp->SetPDGcode(st.pdgCode);
+
+    // the touchable is not kept: the track is located again by the
+    // navigator when its tracking starts
+    auto aTrack = new G4Track(dp, st.globalTime, st.position);
+    aTrack->SetLocalTime(st.localTime);
+    aTrack->SetWeight(st.weight);
+    aTrack->SetTrackID(st.trackID);
+    aTrack->SetParentID(st.parentID);
+    aTrack->SetTrackStatus(G4TrackStatus(st.trackStatus));
+    aTrack->SetBelowThresholdFlag(st.belowThreshold);
+    aTrack->SetGoodForTrackingFlag(st.goodForTracking);
+    aTrack->SetCreatorProcess(
+      static_cast<const G4VProcess*>(pointer(st.creatorProcess)));
+    aTrack->SetCreatorModelID(st.creatorModelID);
+    aTrack->SetVertexPosition(st.vertexPosition);
+    aTrack->SetVertexMomentumDirection(st.vertexMomentumDirection);
+    aTrack->SetVertexKineticEnergy(st.vertexKineticEnergy);
+    aTrack->SetLogicalVolumeAtVertex(
+      static_cast<const G4LogicalVolume*>(pointer(st.vertexVolume)));
+    return aTrack;
+  }
+}
 
 G4TrackStack::~G4TrackStack()
 {
   clearAndDestroy();
+  if(spillFile != nullptr) { std::fclose(spillFile); }
+}
+
+void G4TrackStack::clear()
+{
+  std::vector<G4StackedTrack>::clear();
+  DiscardSpilledTracks();
 }
 
 void G4TrackStack::clearAndDestroy()
 {
+  // trajectories of spilled tracks are still owned by this stack
+  std::vector<G4StackedTrack> spilled;
+  for(std::size_t iBlock = 0; iBlock < spilledBlocks.size(); ++iBlock)
+  {
+    ReadBlock(iBlock, spilled);
+  }
+  for(auto& st : spilled)
+  {
+    delete st.GetTrack();
+    delete st.GetTrajectory();
+  }
   for( auto i = begin(); i != end(); ++i )
   {
     delete (*i).GetTrack();
@@ -50,21 +190,243 @@ void G4TrackStack::clearAndDestroy()
 
 void G4TrackStack::TransferTo(G4TrackStack* aStack)
 {
+  std::vector<G4StackedTrack> spilled;
+  for(std::size_t iBlock = 0; iBlock < spilledBlocks.size(); ++iBlock)
+  {
+    spilled.clear();
+    ReadBlock(iBlock, spilled);
+    for(auto& st : spilled)
+    {
+      aStack->PushToStack(st);
+    }
+  }
   for(auto i = begin(); i != end(); ++i)
   {
-    aStack->push_back(*i);
+    aStack->PushToStack(*i);
   }
   clear();
 }
 
 void G4TrackStack::TransferTo(G4SmartTrackStack* aStack)
 {
-  while (size())
+  while (GetNTrack() > 0)
   {
     aStack->PushToStack(PopFromStack());
   }
 }
 
+void G4TrackStack::TransferTo(G4BucketedTrackStack* aStack)
+{
+  std::vector<G4StackedTrack> spilled;
+  for(std::size_t iBlock = 0; iBlock < spilledBlocks.size(); ++iBlock)
+  {
+    spilled.clear();
+    ReadBlock(iBlock, spilled);
+    for(auto& st : spilled)
+    {
+      aStack->PushToStack(st);
+    }
+  }
+  for(auto i = begin(); i != end(); ++i)
+  {
+    aStack->PushToStack(*i);
+  }
+  clear();
+}
+
+void G4TrackStack::SetSpillThreshold(std::size_t n, const G4String& dir)
+{
+  // tracks already spilled stay in the current file
+  spillThreshold = (n > 0 && n < 2) ? 2 : n;
+  spillMark = spillThreshold;
+  if(spilledBlocks.empty() && spillFile != nullptr && dir != spillDir)
+  {
+    std::fclose(spillFile);
+    spillFile = nullptr;
+  }
+  spillDir = dir;
+}
+
+void G4TrackStack::SpillToFile()
+{
+  if(spillFile == nullptr)
+  {
+#if !defined(WIN32)
+    if(!spillDir.empty())
+    {
+      G4String fileName = spillDir + "/G4TrackStack_XXXXXX";
+      G4int fd = mkstemp(&fileName[0]);
+      if(fd >= 0)
+      {
+        // the file is removed from the directory right away, and from
+        // the disk when it is closed
+        unlink(fileName.c_str());
+        spillFile = fdopen(fd, "w+b");
+      }
+    }
+    else
+#endif
+    {
+      spillFile = std::tmpfile();
+    }
+    if(spillFile == nullptr)
+    {
+      G4ExceptionDescription ED;
+      ED << "Cannot create a temporary file in <"
+         << (spillDir.empty() ? G4String("default directory") : spillDir)
+         << ">. Tracks are kept in memory.";
+      G4Exception("G4TrackStack::SpillToFile", "Event0057", JustWarning, ED);
+      spillThreshold = 0;
+      spillMark = 0;
+      return;
+    }
+  }
+
+  // the oldest half of the tracks is spilled
+  std::size_t nCandidate = size() / 2;
+  SpilledBlock spilled{ 0, 0, 0., {}, {} };
+  std::vector<SpilledTrack> block;
+  block.reserve(nCandidate);
+  for(std::size_t i = 0; i < nCandidate; ++i)
+  {
+    const G4StackedTrack& aStackedTrack = (*this)[i];
+    const G4Track* aTrack = aStackedTrack.GetTrack();
+    spilled.energy += aTrack->GetDynamicParticle()->GetTotalEnergy();
+    if(!IsSpillable(aTrack))
+    {
+      spilled.kept.emplace_back(i, aStackedTrack);
+      continue;
+    }
+    SpilledTrack st;
+    Store(aTrack, st);
+    const G4DynamicParticle* dp = aTrack->GetDynamicParticle();
+    st.particle = GetSpilledPointerIndex(dp->GetParticleDefinition());
+    st.creatorProcess = GetSpilledPointerIndex(aTrack->GetCreatorProcess());
+    st.vertexVolume
+      = GetSpilledPointerIndex(aTrack->GetLogicalVolumeAtVertex());
+    block.push_back(st);
+
+    SpilledTrackRefs refs{ dp->GetPrimaryParticle(),
+                           aTrack->GetUserInformation(),
+                           aStackedTrack.GetTrajectory() };
+    if(refs.primaryParticle != nullptr || refs.userInfo != nullptr
+       || refs.trajectory != nullptr)
+    {
+      spilled.refs[i] = refs;
+    }
+  }
+
+  if(!block.empty())
+  {
+    if(!spilledBlocks.empty())
+    {
+      const SpilledBlock& last = spilledBlocks.back();
+      spilled.offset = last.offset + long(last.nTrack * sizeof(SpilledTrack));
+    }
+    if(std::fseek(spillFile, spilled.offset, SEEK_SET) != 0
+       || std::fwrite(block.data(), sizeof(SpilledTrack), block.size(),
+                      spillFile) != block.size())
+    {
+      G4Exception("G4TrackStack::SpillToFile", "Event0058", JustWarning,
+                  "Cannot write spilled tracks. Tracks are kept in memory.");
+      spillThreshold = 0;
+      spillMark = 0;
+      return;
+    }
+    spilled.nTrack = block.size();
+    nSpilled += nCandidate;
+
+    for(std::size_t i = 0; i < nCandidate; ++i)
+    {
+      G4Track* aTrack = (*this)[i].GetTrack();
+      if(IsSpillable(aTrack))
+      {
+        // user information and trajectory are kept in the block
+        aTrack->SetUserInformation(nullptr);
+        delete aTrack;
+      }
+    }
+    erase(begin(), begin() + nCandidate);
+    spilledBlocks.push_back(std::move(spilled));
+  }
+
+  spillMark = std::max(spillThreshold, size() + spillThreshold / 2);
+}
+
+void G4TrackStack::ReadBlock(std::size_t iBlock,
+                             std::vector<G4StackedTrack>& tracks)
+{
+  const SpilledBlock& spilled = spilledBlocks[iBlock];
+  std::vector<SpilledTrack> block(spilled.nTrack);
+  if(std::fseek(spillFile, spilled.offset, SEEK_SET) != 0
+     || std::fread(block.data(), sizeof(SpilledTrack), block.size(),
+                   spillFile) != block.size())
+  {
+    G4ExceptionDescription ED;
+    ED << "Cannot read back " << spilled.nTrack << " spilled tracks.";
+    G4Exception("G4TrackStack::ReadBlock", "Event0059", FatalException, ED);
+    return;
+  }
+
+  // tracks kept in memory are put back at their original position
+  auto kept = spilled.kept.cbegin();
+  auto st = block.cbegin();
+  std::size_t n = spilled.nTrack + spilled.kept.size();
+  for(std::size_t i = 0; i < n; ++i)
+  {
+    if(kept != spilled.kept.cend() && kept->first == i)
+    {
+      tracks.push_back((kept++)->second);
+      continue;
+    }
+    G4Track* aTrack = Restore(*st, spilledPointers);
+    G4VTrajectory* trajectory = nullptr;
+    auto refs = spilled.refs.find(i);
+    if(refs != spilled.refs.cend())
+    {
+      auto dp = const_cast<G4DynamicParticle*>(aTrack->GetDynamicParticle());
+      dp->SetPrimaryParticle(refs->second.primaryParticle);
+      aTrack->SetUserInformation(refs->second.userInfo);
+      trajectory = refs->second.trajectory;
+    }
+    tracks.emplace_back(aTrack, trajectory);
+    ++st;
+  }
+}
+
+void G4TrackStack::RestoreFromFile()
+{
+  // the most recent block is on the top of the spilled tracks
+  std::vector<G4StackedTrack> tracks;
+  tracks.reserve(spilledBlocks.back().nTrack);
+  ReadBlock(spilledBlocks.size() - 1, tracks);
+  nSpilled -= tracks.size();
+  spilledBlocks.pop_back();
+  insert(begin(), tracks.begin(), tracks.end());
+  if(spilledBlocks.empty()) { DiscardSpilledTracks(); }
+}
+
+void G4TrackStack::DiscardSpilledTracks()
+{
+  // the file is kept open and overwritten by the next spill
+  spilledBlocks.clear();
+  nSpilled = 0;
+  spillMark = spillThreshold;
+  spilledPointers.clear();
+  spilledPointerIndex.clear();
+}
+
+G4int G4TrackStack::GetSpilledPointerIndex(const void* ptr)
+{
+  if(ptr == nullptr) { return -1; }
+  auto itr = spilledPointerIndex.find(ptr);
+  if(itr != spilledPointerIndex.cend()) { return itr->second; }
+  auto index = G4int(spilledPointers.size());
+  spilledPointers.push_back(ptr);
+  spilledPointerIndex[ptr] = index;
+  return index;
+}
+
 G4double G4TrackStack::getTotalEnergy(void) const
 {
   G4double totalEnergy = 0.0;
@@ -72,5 +434,9 @@ G4double G4TrackStack::getTotalEnergy(void) const
   {
     totalEnergy += (*i).GetTrack()->GetDynamicParticle()->GetTotalEnergy();
   }
+  for ( const auto& spilled : spilledBlocks )
+  {
+    totalEnergy += spilled.energy;
+  }
   return totalEnergy;
 }
@@ -64,3 +64,7 @@ void G4UserEventAction::BeginOfEventAction(const G4Event*)
 void G4UserEventAction::EndOfEventAction(const G4Event*)
 {;}
 
+G4bool G4UserEventAction::MergeSubEventResults(G4Event*, const G4Event*)
+{
+  return false;
+}
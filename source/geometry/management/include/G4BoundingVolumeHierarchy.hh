@@ -0,0 +1,146 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4BoundingVolumeHierarchy
+//
+// Class description:
+//
+// Binary tree of axis-aligned bounding boxes over a set of items, each
+// given by the extent of its box. Used for fast searches among many
+// objects irregularly placed in space, where G4SmartVoxelHeader slicing
+// along one axis at a time is not effective (e.g. by G4BVHNavigation for
+// daughters of a logical volume).
+// The tree is built once with a binned surface area heuristic; the nodes
+// are stored contiguously, the two children of a node being adjacent.
+// Traversals are templated on the visitor, called with the index of the
+// item as given to Build(). Tests are made on the boxes of the leaves: by
+// default a leaf holds a single item, except for items with coincident
+// centres, so that the leaf box is the box of the item.
+//
+//   TraverseRay(p, v, tMax, visit)
+//     - visits, nearest first, the items whose box is crossed by the
+//       segment p + t*v, 0 <= t <= tMax; visit(i) may reduce tMax
+//   TraverseRayLeaves(p, v, tMax, visit)
+//     - as TraverseRay, but visit(first, count) is called once per leaf
+//       with the positions of its items in GetItems(), so that data laid
+//       out in that order can be tested a leaf at a time
+//   TraverseDistance(p, dMax, visit)
+//     - visits, nearest first, the items whose box is closer than dMax
+//       to p; visit(i) may reduce dMax
+//   TraversePoint(p, visit)
+//     - visits the items whose box contains p, until visit(i) returns true
+//
+// The boxes are lower bounds of the distances to the items, so searches
+// pruned on them are exact as long as each box contains its item.
+
+// --------------------------------------------------------------------
+#ifndef G4BOUNDINGVOLUMEHIERARCHY_HH
+#define G4BOUNDINGVOLUMEHIERARCHY_HH 1
+
+#include <vector>
+
+#include "G4Types.hh"
+#include "G4ThreeVector.hh"
+
+class G4BoundingVolumeHierarchy
+{
+  public:
+
+    G4BoundingVolumeHierarchy() = default;
+    ~G4BoundingVolumeHierarchy() = default;
+
+    void Build(const std::vector<G4ThreeVector>& pMin,
+               const std::vector<G4ThreeVector>& pMax,
+               G4int maxLeafSize = 1);
+      // Build the tree for the boxes [pMin[i],pMax[i]], replacing
+      // any previous content.
+
+    inline G4bool IsEmpty() const;
+    inline std::size_t GetNumberOfItems() const;
+    inline std::size_t GetNumberOfNodes() const;
+    inline G4int GetDepth() const;
+    inline const std::vector<G4int>& GetItems() const;
+    inline std::size_t AllocatedMemory() const;
+    void GetExtent(G4ThreeVector& pMin, G4ThreeVector& pMax) const;
+      // Statistics and extent of the whole tree. GetItems() gives the
+      // items in leaf order, those of a leaf being contiguous.
+      // AllocatedMemory() is the size in bytes of nodes and items
+
+    template <class Visitor>
+    inline void TraverseRay(const G4ThreeVector& p, const G4ThreeVector& v,
+                            G4double& tMax, Visitor&& visit) const;
+    template <class LeafVisitor>
+    inline void TraverseRayLeaves(const G4ThreeVector& p,
+                                  const G4ThreeVector& v, G4double& tMax,
+                                  LeafVisitor&& visit) const;
+    template <class Visitor>
+    inline void TraverseDistance(const G4ThreeVector& p, G4double& dMax,
+                                 Visitor&& visit) const;
+    template <class Visitor>
+    inline G4bool TraversePoint(const G4ThreeVector& p,
+                                Visitor&& visit) const;
+      // Searches, see the class description
+
+  private:
+
+    struct Node
+    {
+      G4double fMin[3];
+      G4double fMax[3];
+      G4int fFirst;   // first item of a leaf, or first of the two children
+      G4int fCount;   // number of items of a leaf, 0 for internal nodes
+    };
+
+    struct StackEntry
+    {
+      G4int fNode;
+      G4double fKey;
+    };
+
+    void BuildNode(G4int node, G4int begin, G4int end, G4int depth,
+                   const std::vector<G4ThreeVector>& pMin,
+                   const std::vector<G4ThreeVector>& pMax,
+                   std::vector<G4ThreeVector>& centres, G4int maxLeafSize);
+
+    inline G4double EntryDistance(const Node& node, const G4double p[3],
+                                  const G4double v[3], const G4double inv[3],
+                                  G4double tMax) const;
+    inline G4double SquaredDistance(const Node& node,
+                                    const G4double p[3]) const;
+    inline G4bool Contains(const Node& node, const G4double p[3]) const;
+
+  private:
+
+    static constexpr G4int kMaxDepth = 60;
+      // Deeper nodes are made leaves; bounds the traversal stacks
+
+    std::vector<Node> fNodes;
+    std::vector<G4int> fItems;
+    G4int fDepth = 0;
+};
+
+#include "G4BoundingVolumeHierarchy.icc"
+
+#endif
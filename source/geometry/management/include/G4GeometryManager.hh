@@ -45,9 +45,11 @@
 #include <vector>
 
 #include "G4Types.hh"
+#include "G4String.hh"
 #include "G4SmartVoxelStat.hh"
 
 class G4VPhysicalVolume;
+class G4LogicalVolume;
 
 class G4GeometryManager
 {
@@ -78,6 +80,23 @@ class G4GeometryManager
     static G4GeometryManager* GetInstanceIfExist();
       // Return ptr to singleton instance.
 
+    void SetNumberOfBuildThreads(G4int nThreads);
+    G4int GetNumberOfBuildThreads() const;
+      // Set/get the number of threads used for building the voxels of
+      // volumes whose daughters are all placements. A value smaller than 2
+      // (default) builds all voxels sequentially. Effective only in
+      // multi-threaded builds. The solids of the daughters are then asked
+      // for their extent concurrently: their CalculateExtent() must be
+      // thread-safe, as for all solids provided by Geant4.
+
+    void SetVoxelCacheFile(const G4String& fileName);
+    const G4String& GetVoxelCacheFile() const;
+      // Set/get the file used as persistent cache of the voxels. If set,
+      // the voxels of the volumes unchanged since the file was written are
+      // reloaded from it when closing the geometry, instead of being built,
+      // and the file is updated if any voxels had to be built. An empty
+      // name (default) disables the cache.
+
   public:
 
    ~G4GeometryManager();
@@ -94,8 +113,22 @@ class G4GeometryManager
     void BuildOptimisations(G4bool allOpt, G4VPhysicalVolume* vol);
     void DeleteOptimisations();
     void DeleteOptimisations(G4VPhysicalVolume* vol);
+    static G4bool BuildBVH(G4LogicalVolume* volume);
+      // Build the hierarchy of daughter extents in place of voxels, if
+      // requested for the volume and applicable. Return true if built.
+    static void DeleteOptimisation(G4LogicalVolume* volume);
+      // Delete voxels and hierarchy of daughters of the volume, if any.
+    void BuildVoxelsInParallel(const std::vector<G4LogicalVolume*>& volumes,
+                               std::vector<G4SmartVoxelStat>& stats,
+                               G4bool verbose);
+      // Build the voxels of the given volumes concurrently. The volumes
+      // must have placed daughters only, since replicas and parameterised
+      // volumes modify shared state while being voxelised, and the solids
+      // of the daughters must compute their extent in a thread-safe way.
     static void ReportVoxelStats( std::vector<G4SmartVoxelStat>& stats,
                                   G4double totalCpuTime );
+    G4int fNumberOfBuildThreads = 1;
+    G4String fVoxelCacheFile;
     static G4ThreadLocal G4GeometryManager* fgInstance;
     static G4ThreadLocal G4bool fIsClosed;
 };
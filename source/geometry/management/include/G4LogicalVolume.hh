@@ -69,6 +69,9 @@
 //    - Pointer (possibly 0) to user Step limit object for this node.
 //    G4SmartVoxelHeader* fVoxel
 //    - Pointer (possibly 0) to optimisation info objects.
+//    G4BoundingVolumeHierarchy* fBVH
+//    - Pointer (possibly 0) to the hierarchy of daughter extents, built
+//      in place of voxels if fBVHNavigation is set.
 //    G4bool fOptimise
 //    - Flag to identify if optimisation should be applied or not.
 //    G4bool fRootRegion
@@ -120,6 +123,7 @@ class G4VSensitiveDetector;
 class G4VSolid;
 class G4UserLimits;
 class G4SmartVoxelHeader;
+class G4BoundingVolumeHierarchy;
 class G4VisAttributes;
 class G4FastSimulationManager;
 class G4MaterialCutsCouple;
@@ -289,6 +293,16 @@ class G4LogicalVolume
     inline G4SmartVoxelHeader* GetVoxelHeader() const;
     inline void SetVoxelHeader(G4SmartVoxelHeader *pVoxel);
       // Gets and sets current VoxelHeader.
+
+    inline G4BoundingVolumeHierarchy* GetBVH() const;
+    inline void SetBVH(G4BoundingVolumeHierarchy* pBVH);
+      // Gets and sets current bounding volume hierarchy of the daughters.
+    inline G4bool IsBVHNavigation() const;
+    inline void SetBVHNavigation(G4bool val);
+      // Specifies if navigation among the daughters is to use a bounding
+      // volume hierarchy of their extents (G4BVHNavigation) instead of
+      // voxels. Only applies to volumes whose daughters are all placements;
+      // it is effective at the next closure of the geometry.
     
     inline G4double GetSmartless() const;
     inline void SetSmartless(G4double s);
@@ -402,6 +416,8 @@ class G4LogicalVolume
       // Pointer (possibly nullptr) to user Step limit object for this node.
     G4SmartVoxelHeader* fVoxel = nullptr;
       // Pointer (possibly nullptr) to optimisation info objects.
+    G4BoundingVolumeHierarchy* fBVH = nullptr;
+      // Pointer (possibly nullptr) to hierarchy of daughter extents.
     G4double fSmartless = 2.0;
       // Quality for optimisation, average number of voxels to be spent
       // per content.
@@ -427,6 +443,8 @@ class G4LogicalVolume
       // Are contents of volume placements, replica, parameterised or external?
     G4bool fOptimise = true;
       // Flag to identify if optimisation should be applied or not.
+    G4bool fBVHNavigation = false;
+      // Flag to identify if a hierarchy of daughters is to replace voxels.
     G4bool fRootRegion = false;
       // Flag to identify if the logical volume is a root region.
     G4bool fLock = false;
@@ -0,0 +1,144 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4SmartVoxelCache
+//
+// Class description:
+//
+// Persistent store of smart voxels in a binary file, allowing voxels built
+// in a previous job to be reloaded instead of rebuilt when closing the
+// geometry. The voxels of each logical volume are keyed by a hash of all
+// the volume's properties they depend upon: the solid of the volume, the
+// solids, transformations and replication data of its daughters and its
+// smartless value. A volume whose voxels are not found in the cache, or
+// whose geometry changed, has its voxels built as usual.
+// Volumes with parameterised daughters are not cached, since their
+// placements are known only to the user's parameterisation.
+// The file is written in the native binary representation and is not
+// portable across platforms.
+
+// --------------------------------------------------------------------
+#ifndef G4SMARTVOXELCACHE_HH
+#define G4SMARTVOXELCACHE_HH 1
+
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <vector>
+
+#include "G4Types.hh"
+#include "G4String.hh"
+
+class G4LogicalVolume;
+class G4SmartVoxelHeader;
+
+class G4SmartVoxelCache
+{
+  public:
+
+    using Key = std::uint64_t;
+
+    G4SmartVoxelCache(const G4String& fileName);
+      // Constructor, taking the name of the cache file. Nothing is read.
+
+   ~G4SmartVoxelCache();
+      // Destructor. Deletes the loaded voxels which were not retrieved.
+
+    G4SmartVoxelCache(const G4SmartVoxelCache&) = delete;
+    G4SmartVoxelCache& operator=(const G4SmartVoxelCache&) = delete;
+
+    G4bool Load();
+      // Read all the voxels stored in the file. Return false if the file
+      // does not exist or is not a valid cache; nothing is loaded then.
+
+    G4SmartVoxelHeader* Retrieve(const G4LogicalVolume* pVolume, Key key);
+      // Return the loaded voxels of the volume with the given key, or null
+      // if none. Voxels whose number of contents differs from that of the
+      // volume are rejected. Ownership of the voxels is passed to the caller.
+
+    void Insert(const G4LogicalVolume* pVolume, Key key,
+                const G4SmartVoxelHeader* head);
+      // Record the voxels of a volume for the next Save(). Ownership
+      // remains with the volume, which must not delete them before.
+
+    G4bool Save();
+      // Write all the recorded voxels to the file, replacing its content.
+      // Return false if the file cannot be written.
+
+    inline const G4String& GetFileName() const;
+    inline std::size_t GetNumberOfLoaded() const;
+    inline std::size_t GetNumberOfRetrieved() const;
+
+    static G4bool IsCacheable(const G4LogicalVolume* pVolume);
+      // Return true if the voxels of the volume can be cached.
+
+    static Key ComputeKey(const G4LogicalVolume* pVolume);
+      // Return the hash of the properties of the volume which determine
+      // its voxels.
+
+  private:
+
+    struct Entry
+    {
+      std::size_t nContents = 0;
+      const G4SmartVoxelHeader* head = nullptr;
+    };
+
+    static std::size_t GetNoContents(const G4LogicalVolume* pVolume);
+      // Return the number of volumes the nodes of the voxels refer to:
+      // the number of replicas for a replicated daughter, the number of
+      // daughters otherwise.
+
+    static void WriteHeader(std::ostream& out, const G4SmartVoxelHeader* head);
+    static G4SmartVoxelHeader* ReadHeader(std::istream& in,
+                                          std::size_t nContents);
+      // Write/read voxels recursively. ReadHeader() returns null in case
+      // of error, or if a node refers to a volume beyond "nContents".
+
+  private:
+
+    G4String fFileName;
+    std::multimap<Key, Entry> fLoaded;
+    std::vector<std::pair<Key, Entry>> fRecorded;
+    std::size_t fNumberOfLoaded = 0;
+    std::size_t fNumberOfRetrieved = 0;
+};
+
+inline const G4String& G4SmartVoxelCache::GetFileName() const
+{
+  return fFileName;
+}
+
+inline std::size_t G4SmartVoxelCache::GetNumberOfLoaded() const
+{
+  return fNumberOfLoaded;
+}
+
+inline std::size_t G4SmartVoxelCache::GetNumberOfRetrieved() const
+{
+  return fNumberOfRetrieved;
+}
+
+#endif
@@ -126,6 +126,14 @@ class G4SmartVoxelHeader
       // and min equivalent slice nos for the header - they apply to the level
       // of the header, not its nodes.
 
+  private:
+
+    friend class G4SmartVoxelCache;
+
+    G4SmartVoxelHeader() = default;
+      // Constructor for an empty header, filled in by G4SmartVoxelCache
+      // when reloading voxels from file.
+
   protected:
 
     //  `Worker' / operation functions:
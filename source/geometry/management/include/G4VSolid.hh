@@ -157,6 +157,27 @@ class G4VSolid
       // Calculate the distance to the nearest surface of a shape from an
       // inside point. The distance can be an underestimate.
 
+    virtual void DistanceToInVec(G4int n,
+                                 const G4double* px, const G4double* py,
+                                 const G4double* pz, const G4double* vx,
+                                 const G4double* vy, const G4double* vz,
+                                       G4double* dist) const;
+      // Compute DistanceToIn(p,v) for n points and normalised directions,
+      // given as separate arrays of their components, and store the
+      // results in dist. The default implementation calls the scalar
+      // method for each point. Solids may override it with a vectorisable
+      // implementation, returning the same values as the scalar method;
+      // G4Box, G4Orb and G4Trd do so. The navigators do not use these
+      // methods, which are meant for user code computing many rays
+      // against one solid (e.g. fast simulation or ray casting).
+
+    virtual void DistanceToOutVec(G4int n,
+                                  const G4double* px, const G4double* py,
+                                  const G4double* pz, const G4double* vx,
+                                  const G4double* vy, const G4double* vz,
+                                        G4double* dist) const;
+      // As above for DistanceToOut(p,v). No normal is computed.
+
 
     virtual void ComputeDimensions(G4VPVParameterisation* p,
 	                           const G4int n,
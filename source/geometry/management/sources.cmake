@@ -13,6 +13,8 @@ geant4_add_module(G4geometrymng
     G4BlockingList.hh
     G4BlockingList.icc
     G4BoundingEnvelope.hh
+    G4BoundingVolumeHierarchy.hh
+    G4BoundingVolumeHierarchy.icc
     G4ErrorCylSurfaceTarget.hh
     G4ErrorPlaneSurfaceTarget.hh
     G4ErrorSurfaceTarget.hh
@@ -36,6 +38,7 @@ geant4_add_module(G4geometrymng
     G4RegionStore.hh
     G4ScaleTransform.hh
     G4ScaleTransform.icc
+    G4SmartVoxelCache.hh
     G4SmartVoxelHeader.hh
     G4SmartVoxelHeader.icc
     G4SmartVoxelNode.hh
@@ -67,6 +70,7 @@ geant4_add_module(G4geometrymng
   SOURCES
     G4BlockingList.cc
     G4BoundingEnvelope.cc
+    G4BoundingVolumeHierarchy.cc
     G4ErrorCylSurfaceTarget.cc
     G4ErrorPlaneSurfaceTarget.cc
     G4ErrorSurfaceTarget.cc
@@ -83,6 +87,7 @@ geant4_add_module(G4geometrymng
     G4ReflectedSolid.cc
     G4Region.cc
     G4RegionStore.cc
+    G4SmartVoxelCache.cc
     G4SmartVoxelHeader.cc
     G4SmartVoxelNode.cc
     G4SmartVoxelProxy.cc
@@ -0,0 +1,236 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4BoundingVolumeHierarchy implementation
+//
+// --------------------------------------------------------------------
+
+#include <algorithm>
+#include <numeric>
+
+#include "G4BoundingVolumeHierarchy.hh"
+
+namespace
+{
+  // Surface area, up to a factor 2, of the box [bmin,bmax]
+  //
+  inline G4double HalfArea(const G4double bmin[3], const G4double bmax[3])
+  {
+    const G4double dx = bmax[0] - bmin[0];
+    const G4double dy = bmax[1] - bmin[1];
+    const G4double dz = bmax[2] - bmin[2];
+    return dx*dy + dy*dz + dz*dx;
+  }
+
+  struct Bin
+  {
+    G4double fMin[3] = {  DBL_MAX,  DBL_MAX,  DBL_MAX };
+    G4double fMax[3] = { -DBL_MAX, -DBL_MAX, -DBL_MAX };
+    G4int fCount = 0;
+
+    inline void Grow(const G4double bmin[3], const G4double bmax[3])
+    {
+      for (G4int k=0; k<3; ++k)
+      {
+        fMin[k] = std::min(fMin[k], bmin[k]);
+        fMax[k] = std::max(fMax[k], bmax[k]);
+      }
+    }
+  };
+}
+
+// --------------------------------------------------------------------
+// Build
+//
+void G4BoundingVolumeHierarchy::Build(const std::vector<G4ThreeVector>& pMin,
+                                      const std::vector<G4ThreeVector>& pMax,
+                                      G4int maxLeafSize)
+{
+  fNodes.clear();
+  fItems.clear();
+  fDepth = 0;
+
+  const G4int nItems = G4int(std::min(pMin.size(), pMax.size()));
+  if (nItems == 0) { return; }
+  if (maxLeafSize < 1) { maxLeafSize = 1; }
+
+  fItems.resize(nItems);
+  std::iota(fItems.begin(), fItems.end(), 0);
+  std::vector<G4ThreeVector> centres(nItems);
+  for (G4int i=0; i<nItems; ++i)
+  {
+    centres[i] = 0.5*(pMin[i] + pMax[i]);
+  }
+  fNodes.reserve(2*nItems);
+  fNodes.push_back(Node());
+  BuildNode(0, 0, nItems, 1, pMin, pMax, centres, maxLeafSize);
+  fNodes.shrink_to_fit();
+}
+
+// --------------------------------------------------------------------
+// BuildNode
+//
+// Fill the node for items [begin,end) of fItems and split it, choosing
+// the plane with the lowest surface area cost among equally spaced
+// candidates along the axis of largest extent of the item centres.
+//
+void G4BoundingVolumeHierarchy::
+BuildNode(G4int node, G4int begin, G4int end, G4int depth,
+          const std::vector<G4ThreeVector>& pMin,
+          const std::vector<G4ThreeVector>& pMax,
+          std::vector<G4ThreeVector>& centres, G4int maxLeafSize)
+{
+  static const G4int nBins = 16;
+
+  if (depth > fDepth) { fDepth = depth; }
+
+  // Bounds of the node and of the item centres
+  //
+  Bin bounds, cbounds;
+  for (G4int i=begin; i<end; ++i)
+  {
+    const G4int item = fItems[i];
+    const G4double bmin[3] = { pMin[item].x(), pMin[item].y(), pMin[item].z() };
+    const G4double bmax[3] = { pMax[item].x(), pMax[item].y(), pMax[item].z() };
+    const G4double c[3] = { centres[item].x(), centres[item].y(),
+                            centres[item].z() };
+    bounds.Grow(bmin, bmax);
+    cbounds.Grow(c, c);
+  }
+  for (G4int k=0; k<3; ++k)
+  {
+    fNodes[node].fMin[k] = bounds.fMin[k];
+    fNodes[node].fMax[k] = bounds.fMax[k];
+  }
+  fNodes[node].fFirst = begin;
+  fNodes[node].fCount = end - begin;
+
+  const G4int count = end - begin;
+  if (count <= maxLeafSize || depth >= kMaxDepth) { return; }
+
+  G4int axis = 0;
+  G4double extent = cbounds.fMax[0] - cbounds.fMin[0];
+  for (G4int k=1; k<3; ++k)
+  {
+    if (cbounds.fMax[k] - cbounds.fMin[k] > extent)
+    {
+      axis = k;
+      extent = cbounds.fMax[k] - cbounds.fMin[k];
+    }
+  }
+  if (extent <= 0.0) { return; }  // All centres coincide: keep a leaf
+
+  // Bin the items along the axis
+  //
+  Bin bins[nBins];
+  const G4double scale = nBins/extent;
+  auto binOf = [&](G4int item)
+  {
+    G4int b = G4int((centres[item][axis] - cbounds.fMin[axis])*scale);
+    return std::min(std::max(b, 0), nBins - 1);
+  };
+  for (G4int i=begin; i<end; ++i)
+  {
+    const G4int item = fItems[i];
+    const G4double bmin[3] = { pMin[item].x(), pMin[item].y(), pMin[item].z() };
+    const G4double bmax[3] = { pMax[item].x(), pMax[item].y(), pMax[item].z() };
+    Bin& bin = bins[binOf(item)];
+    bin.Grow(bmin, bmax);
+    ++bin.fCount;
+  }
+
+  // Cost of each of the nBins-1 planes: sweep from the left, then
+  // from the right
+  //
+  G4double leftArea[nBins-1];
+  G4int leftCount[nBins-1];
+  Bin acc;
+  G4int n = 0;
+  for (G4int b=0; b<nBins-1; ++b)
+  {
+    if (bins[b].fCount > 0) { acc.Grow(bins[b].fMin, bins[b].fMax); }
+    n += bins[b].fCount;
+    leftCount[b] = n;
+    leftArea[b] = (n > 0) ? HalfArea(acc.fMin, acc.fMax) : 0.0;
+  }
+  G4int bestPlane = -1;
+  G4double bestCost = DBL_MAX;
+  acc = Bin();
+  n = 0;
+  for (G4int b=nBins-1; b>0; --b)
+  {
+    if (bins[b].fCount > 0) { acc.Grow(bins[b].fMin, bins[b].fMax); }
+    n += bins[b].fCount;
+    const G4int nLeft = leftCount[b-1];
+    if (nLeft == 0 || n == 0) { continue; }
+    const G4double cost = nLeft*leftArea[b-1] + n*HalfArea(acc.fMin, acc.fMax);
+    if (cost < bestCost)
+    {
+      bestCost = cost;
+      bestPlane = b;
+    }
+  }
+
+  // Partition; fall back to a median split if binning did not separate
+  //
+  G4int mid = begin;
+  if (bestPlane > 0)
+  {
+    auto it = std::partition(fItems.begin() + begin, fItems.begin() + end,
+                             [&](G4int item) { return binOf(item) < bestPlane; });
+    mid = G4int(it - fItems.begin());
+  }
+  if (mid == begin || mid == end)
+  {
+    mid = begin + count/2;
+    std::nth_element(fItems.begin() + begin, fItems.begin() + mid,
+                     fItems.begin() + end, [&](G4int a, G4int b)
+                     { return centres[a][axis] < centres[b][axis]; });
+  }
+
+  const G4int left = G4int(fNodes.size());
+  fNodes.push_back(Node());
+  fNodes.push_back(Node());
+  fNodes[node].fFirst = left;
+  fNodes[node].fCount = 0;
+  BuildNode(left, begin, mid, depth + 1, pMin, pMax, centres, maxLeafSize);
+  BuildNode(left + 1, mid, end, depth + 1, pMin, pMax, centres, maxLeafSize);
+}
+
+// --------------------------------------------------------------------
+// GetExtent
+//
+void G4BoundingVolumeHierarchy::GetExtent(G4ThreeVector& pMin,
+                                          G4ThreeVector& pMax) const
+{
+  if (fNodes.empty())
+  {
+    pMin = pMax = G4ThreeVector(0., 0., 0.);
+    return;
+  }
+  const Node& root = fNodes[0];
+  pMin.set(root.fMin[0], root.fMin[1], root.fMin[2]);
+  pMax.set(root.fMax[0], root.fMax[1], root.fMax[2]);
+}
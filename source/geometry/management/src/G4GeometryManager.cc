@@ -29,6 +29,7 @@
 // --------------------------------------------------------------------
 
 #include <iomanip>
+#include <memory>
 
 #include "G4Timer.hh"
 #include "G4GeometryManager.hh"
@@ -43,8 +44,27 @@
 #include "G4LogicalVolumeStore.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4SmartVoxelHeader.hh"
+#include "G4SmartVoxelCache.hh"
+#include "G4BoundingVolumeHierarchy.hh"
+#include "G4AffineTransform.hh"
+#include "G4SmartVoxelNode.hh"
+#include "G4SmartVoxelProxy.hh"
 #include "voxeldefs.hh"
 
+// Needed for building voxels in parallel
+//
+#ifdef G4MULTITHREADED
+#include <atomic>
+#include <chrono>
+#include "G4AutoLock.hh"
+#include "G4Threading.hh"
+
+namespace
+{
+  G4Mutex buildVoxelsMutex = G4MUTEX_INITIALIZER;
+}
+#endif
+
 // Needed for setting the extent for tolerance value
 //
 #include "G4GeometryTolerance.hh"
@@ -147,6 +167,34 @@ G4GeometryManager* G4GeometryManager::GetInstanceIfExist()
   return fgInstance;
 }
 
+// ***************************************************************************
+// Sets/returns the number of threads for building the voxels.
+// ***************************************************************************
+//
+void G4GeometryManager::SetNumberOfBuildThreads(G4int nThreads)
+{
+  fNumberOfBuildThreads = (nThreads > 1) ? nThreads : 1;
+}
+
+G4int G4GeometryManager::GetNumberOfBuildThreads() const
+{
+  return fNumberOfBuildThreads;
+}
+
+// ***************************************************************************
+// Sets/returns the name of the file for caching the voxels.
+// ***************************************************************************
+//
+void G4GeometryManager::SetVoxelCacheFile(const G4String& fileName)
+{
+  fVoxelCacheFile = fileName;
+}
+
+const G4String& G4GeometryManager::GetVoxelCacheFile() const
+{
+  return fVoxelCacheFile;
+}
+
 // ***************************************************************************
 // Creates optimisation info. Builds all voxels if allOpts=true
 // otherwise it builds voxels only for replicated volumes.
@@ -162,6 +210,19 @@ void G4GeometryManager::BuildOptimisations(G4bool allOpts, G4bool verbose)
    G4LogicalVolumeStore* Store = G4LogicalVolumeStore::GetInstance();
    G4LogicalVolume* volume;
    G4SmartVoxelHeader* head;
+   std::vector<G4LogicalVolume*> parallelVolumes;
+
+   // Voxels previously saved to file, if caching is enabled
+   //
+   std::unique_ptr<G4SmartVoxelCache> cache;
+   using CachedVolume = std::pair<G4LogicalVolume*, G4SmartVoxelCache::Key>;
+   std::vector<CachedVolume> cachedVolumes;
+   G4bool updateCache = false;
+   if (!fVoxelCacheFile.empty())
+   {
+     cache.reset(new G4SmartVoxelCache(fVoxelCacheFile));
+     updateCache = !cache->Load();
+   }
  
    for (size_t n=0; n<Store->size(); ++n)
    {
@@ -170,10 +231,22 @@ void G4GeometryManager::BuildOptimisations(G4bool allOpts, G4bool verbose)
      // For safety, check if there are any existing voxels and
      // delete before replacement
      //
-     head = volume->GetVoxelHeader();
-     delete head;
-     volume->SetVoxelHeader(nullptr);
-     if (    ( (volume->IsToOptimise())
+     DeleteOptimisation(volume);
+     if (BuildBVH(volume))
+     {
+       if (verbose)
+       {
+         timer.Stop();
+         const G4BoundingVolumeHierarchy* bvh = volume->GetBVH();
+         G4cout << "G4GeometryManager::BuildOptimisations() - BVH for "
+                << volume->GetName() << ": " << bvh->GetNumberOfItems()
+                << " daughters, " << bvh->GetNumberOfNodes() << " nodes, depth "
+                << bvh->GetDepth() << ", "
+                << timer.GetSystemElapsed() + timer.GetUserElapsed()
+                << " s" << G4endl;
+       }
+     }
+     else if ( ( (volume->IsToOptimise())
             && (volume->GetNoDaughters()>=kMinVoxelVolumesLevel1&&allOpts) )
           || ( (volume->GetNoDaughters()==1)
             && (volume->GetDaughter(0)->IsReplicated()==true)
@@ -183,6 +256,36 @@ void G4GeometryManager::BuildOptimisations(G4bool allOpts, G4bool verbose)
        G4cout << "**** G4GeometryManager::BuildOptimisations" << G4endl
               << "     Examining logical volume name = "
               << volume->GetName() << G4endl;
+#endif
+       if (cache && G4SmartVoxelCache::IsCacheable(volume))
+       {
+         G4SmartVoxelCache::Key key = G4SmartVoxelCache::ComputeKey(volume);
+         cachedVolumes.push_back(std::make_pair(volume, key));
+         head = cache->Retrieve(volume, key);
+         if (head != nullptr)
+         {
+           volume->SetVoxelHeader(head);
+           if (verbose)
+           {
+             timer.Stop();
+             stats.push_back( G4SmartVoxelStat( volume, head,
+                                                timer.GetSystemElapsed(),
+                                                timer.GetUserElapsed() ) );
+           }
+           continue;
+         }
+         updateCache = true;
+       }
+#ifdef G4MULTITHREADED
+       // Volumes with placed daughters only are deferred and built
+       // concurrently once all other volumes are done
+       //
+       if ( (fNumberOfBuildThreads > 1)
+         && (volume->CharacteriseDaughters() == kNormal) )
+       {
+         parallelVolumes.push_back(volume);
+         continue;
+       }
 #endif
        head = new G4SmartVoxelHeader(volume);
        if (head != nullptr)
@@ -216,6 +319,30 @@ void G4GeometryManager::BuildOptimisations(G4bool allOpts, G4bool verbose)
 #endif
      }
   }
+  if (!parallelVolumes.empty())
+  {
+     BuildVoxelsInParallel(parallelVolumes, stats, verbose);
+  }
+  if (cache)
+  {
+     if (verbose)
+     {
+       G4cout << "G4GeometryManager::BuildOptimisations() - Voxels of "
+              << cache->GetNumberOfRetrieved() << " out of "
+              << cachedVolumes.size() << " volumes reloaded from "
+              << fVoxelCacheFile << G4endl;
+     }
+     if (updateCache
+      || (cache->GetNumberOfRetrieved() != cache->GetNumberOfLoaded()))
+     {
+       for (const auto& entry : cachedVolumes)
+       {
+         cache->Insert(entry.first, entry.second,
+                       entry.first->GetVoxelHeader());
+       }
+       cache->Save();
+     }
+  }
   if (verbose)
   {
      allTimer.Stop();
@@ -224,6 +351,144 @@ void G4GeometryManager::BuildOptimisations(G4bool allOpts, G4bool verbose)
   }
 }
 
+// ***************************************************************************
+// Builds the voxels of the given volumes on a set of threads. Each helper
+// thread works on a private copy of the master's split-class data (placement
+// transformations, solids) and allocates voxel nodes and proxies from an
+// allocator of its own. Once the helpers are joined, the storage of their
+// allocators is taken over by the allocators of the calling thread, which
+// uses and deletes the voxels; the helper allocators are left empty, to be
+// reused at the next closing of the geometry.
+// The solids are asked for their extent concurrently: CalculateExtent()
+// must not modify shared state.
+// In verbose mode the time reported for each volume is the real time spent
+// in building its voxels.
+// ***************************************************************************
+//
+void
+G4GeometryManager::BuildVoxelsInParallel(
+                     const std::vector<G4LogicalVolume*>& volumes,
+                           std::vector<G4SmartVoxelStat>& stats,
+                           G4bool verbose)
+{
+#ifdef G4MULTITHREADED
+  const std::size_t nVolumes = volumes.size();
+  std::vector<G4SmartVoxelHeader*> heads(nVolumes, nullptr);
+  std::vector<G4double> times(nVolumes, 0.);
+  std::atomic<std::size_t> next(0);
+
+  auto buildVoxels = [&]()
+  {
+    for (std::size_t i = next++; i < nVolumes; i = next++)
+    {
+      auto start = std::chrono::steady_clock::now();
+      heads[i] = new G4SmartVoxelHeader(volumes[i]);
+      times[i] = std::chrono::duration<G4double>(
+                   std::chrono::steady_clock::now() - start).count();
+    }
+  };
+
+  // Allocators of the helper threads, created and registered by this
+  // thread, which takes over their storage after each build
+  //
+  static G4ThreadLocal std::vector<G4Allocator<G4SmartVoxelNode>*>*
+    nodeAllocators = nullptr;
+  static G4ThreadLocal std::vector<G4Allocator<G4SmartVoxelProxy>*>*
+    proxyAllocators = nullptr;
+
+  G4int nHelpers = std::min(fNumberOfBuildThreads, G4int(nVolumes)) - 1;
+  if (aNodeAllocator() == nullptr)
+  {
+    aNodeAllocator() = new G4Allocator<G4SmartVoxelNode>;
+  }
+  if (aProxyAllocator() == nullptr)
+  {
+    aProxyAllocator() = new G4Allocator<G4SmartVoxelProxy>;
+  }
+  if (nodeAllocators == nullptr)
+  {
+    nodeAllocators = new std::vector<G4Allocator<G4SmartVoxelNode>*>;
+    proxyAllocators = new std::vector<G4Allocator<G4SmartVoxelProxy>*>;
+  }
+  auto& nodeAllocs = *nodeAllocators;
+  auto& proxyAllocs = *proxyAllocators;
+  while (G4int(nodeAllocs.size()) < nHelpers)
+  {
+    nodeAllocs.push_back(new G4Allocator<G4SmartVoxelNode>);
+    proxyAllocs.push_back(new G4Allocator<G4SmartVoxelProxy>);
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<G4Thread> helpers;
+  for (G4int n=0; n<nHelpers; ++n)
+  {
+    helpers.emplace_back([&, n]()
+    {
+      auto& lvManager = const_cast<G4LVManager&>(
+                          G4LogicalVolume::GetSubInstanceManager());
+      auto& pvManager = const_cast<G4PVManager&>(
+                          G4VPhysicalVolume::GetSubInstanceManager());
+      lvManager.SlaveCopySubInstanceArray();
+      pvManager.SlaveCopySubInstanceArray();
+      aNodeAllocator() = nodeAllocs[n];
+      aProxyAllocator() = proxyAllocs[n];
+
+      buildVoxels();
+
+      aNodeAllocator() = nullptr;
+      aProxyAllocator() = nullptr;
+
+      G4AutoLock l(&buildVoxelsMutex);
+      lvManager.FreeSlave();
+      pvManager.FreeSlave();
+    });
+  }
+  buildVoxels();  // The calling thread takes its share of the volumes
+  for (auto& helper : helpers)  { helper.join(); }
+
+  // The nodes and proxies built by the helpers are now owned, and will be
+  // freed, by the allocators of this thread
+  //
+  for (G4int n=0; n<nHelpers; ++n)
+  {
+    aNodeAllocator()->TakeOverStorage(*nodeAllocs[n]);
+    aProxyAllocator()->TakeOverStorage(*proxyAllocs[n]);
+  }
+  G4double elapsed = std::chrono::duration<G4double>(
+                       std::chrono::steady_clock::now() - start).count();
+
+  for (std::size_t i=0; i<nVolumes; ++i)
+  {
+    volumes[i]->SetVoxelHeader(heads[i]);
+    if (verbose)
+    {
+      stats.push_back( G4SmartVoxelStat( volumes[i], heads[i], 0., times[i] ) );
+    }
+  }
+  if (verbose)
+  {
+    G4cout << "G4GeometryManager::BuildOptimisations() - Voxels of "
+           << nVolumes << " volumes built on " << nHelpers+1
+           << " threads in " << elapsed << " s (real time)" << G4endl;
+  }
+#else
+  for (auto volume : volumes)
+  {
+    G4Timer timer;
+    if (verbose)  { timer.Start(); }
+    G4SmartVoxelHeader* head = new G4SmartVoxelHeader(volume);
+    volume->SetVoxelHeader(head);
+    if (verbose)
+    {
+      timer.Stop();
+      stats.push_back( G4SmartVoxelStat( volume, head,
+                                         timer.GetSystemElapsed(),
+                                         timer.GetUserElapsed() ) );
+    }
+  }
+#endif
+}
+
 // ***************************************************************************
 // Creates optimisation info for the specified volumes subtree.
 // ***************************************************************************
@@ -239,10 +504,13 @@ void G4GeometryManager::BuildOptimisations(G4bool allOpts,
    G4LogicalVolume* tVolume = pVolume->GetMotherLogical();
    if (tVolume == nullptr) { return BuildOptimisations(allOpts, false); }
 
-   G4SmartVoxelHeader* head = tVolume->GetVoxelHeader();
-   delete head;
-   tVolume->SetVoxelHeader(nullptr);
-   if (    ( (tVolume->IsToOptimise())
+   G4SmartVoxelHeader* head = nullptr;
+   DeleteOptimisation(tVolume);
+   if (BuildBVH(tVolume))
+   {
+     // Navigation among the daughters uses the hierarchy, no voxels
+   }
+   else if ( ( (tVolume->IsToOptimise())
           && (tVolume->GetNoDaughters()>=kMinVoxelVolumesLevel1&&allOpts) )
         || ( (tVolume->GetNoDaughters()==1)
           && (tVolume->GetDaughter(0)->IsReplicated()==true) ) ) 
@@ -281,6 +549,66 @@ void G4GeometryManager::BuildOptimisations(G4bool allOpts,
   }
 }
 
+// ***************************************************************************
+// Builds the bounding volume hierarchy of the daughters of a volume, if
+// requested and if the daughters are all placements. The extent of each
+// daughter is its bounding box transformed to the frame of the mother,
+// enlarged by the surface tolerance.
+// ***************************************************************************
+//
+G4bool G4GeometryManager::BuildBVH(G4LogicalVolume* volume)
+{
+  const std::size_t nDaughters = volume->GetNoDaughters();
+  if (!volume->IsBVHNavigation() || nDaughters == 0
+   || volume->CharacteriseDaughters() != kNormal)
+  {
+    return false;
+  }
+
+  const G4double tol = G4GeometryTolerance::GetInstance()
+                     ->GetSurfaceTolerance();
+  std::vector<G4ThreeVector> pMin(nDaughters), pMax(nDaughters);
+  for (std::size_t i=0; i<nDaughters; ++i)
+  {
+    const G4VPhysicalVolume* pv = volume->GetDaughter(i);
+    G4ThreeVector bmin, bmax;
+    pv->GetLogicalVolume()->GetSolid()->BoundingLimits(bmin, bmax);
+    const G4AffineTransform tf(pv->GetRotation(), pv->GetTranslation());
+    G4ThreeVector emin(kInfinity, kInfinity, kInfinity);
+    G4ThreeVector emax(-kInfinity, -kInfinity, -kInfinity);
+    for (G4int k=0; k<8; ++k)
+    {
+      const G4ThreeVector corner((k & 1) ? bmax.x() : bmin.x(),
+                                 (k & 2) ? bmax.y() : bmin.y(),
+                                 (k & 4) ? bmax.z() : bmin.z());
+      const G4ThreeVector p = tf.TransformPoint(corner);
+      emin.set(std::min(emin.x(), p.x()), std::min(emin.y(), p.y()),
+               std::min(emin.z(), p.z()));
+      emax.set(std::max(emax.x(), p.x()), std::max(emax.y(), p.y()),
+               std::max(emax.z(), p.z()));
+    }
+    pMin[i] = emin - G4ThreeVector(tol, tol, tol);
+    pMax[i] = emax + G4ThreeVector(tol, tol, tol);
+  }
+
+  auto bvh = new G4BoundingVolumeHierarchy;
+  bvh->Build(pMin, pMax);
+  volume->SetBVH(bvh);
+  return true;
+}
+
+// ***************************************************************************
+// Removes optimisation info of a single volume.
+// ***************************************************************************
+//
+void G4GeometryManager::DeleteOptimisation(G4LogicalVolume* volume)
+{
+  delete volume->GetVoxelHeader();
+  volume->SetVoxelHeader(nullptr);
+  delete volume->GetBVH();
+  volume->SetBVH(nullptr);
+}
+
 // ***************************************************************************
 // Removes all optimisation info.
 // Loops over all logical volumes, deleting non-null voxels pointers,
@@ -293,8 +621,7 @@ void G4GeometryManager::DeleteOptimisations()
   for (size_t n=0; n<Store->size(); ++n)
   {
     tVolume=(*Store)[n];
-    delete tVolume->GetVoxelHeader();
-    tVolume->SetVoxelHeader(nullptr);
+    DeleteOptimisation(tVolume);
   }
 }
 
@@ -312,8 +639,7 @@ void G4GeometryManager::DeleteOptimisations(G4VPhysicalVolume* pVolume)
   //
   G4LogicalVolume* tVolume = pVolume->GetMotherLogical();
   if (tVolume == nullptr) { return DeleteOptimisations(); }
-  delete tVolume->GetVoxelHeader();
-  tVolume->SetVoxelHeader(nullptr);
+  DeleteOptimisation(tVolume);
 
   // Scan recursively the associated logical volume tree
   //
@@ -0,0 +1,459 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4SmartVoxelCache implementation
+//
+// --------------------------------------------------------------------
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "G4SmartVoxelCache.hh"
+#include "G4SmartVoxelHeader.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VSolid.hh"
+#include "voxeldefs.hh"
+#include "globals.hh"
+
+namespace
+{
+  // File identification; the version must be incremented whenever the
+  // format or the voxelisation algorithm changes
+  //
+  const char kMagic[8] = { 'G', '4', 'V', 'O', 'X', 'E', 'L', 'S' };
+  const std::uint32_t kVersion = 2;
+
+  // Codes for the slices of a header
+  //
+  enum SliceCode : std::uint8_t
+  {
+    kSameProxy = 0,     // Same proxy as the previous slice
+    kNewNode = 1,       // New proxy to a new node
+    kNewHeader = 2,     // New proxy to a new header
+    kSharedNode = 3,    // New proxy to the node of the previous slice
+    kSharedHeader = 4   // New proxy to the header of the previous slice
+  };
+
+  template <typename T>
+  inline void Write(std::ostream& out, const T& value)
+  {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  template <typename T>
+  inline G4bool Read(std::istream& in, T& value)
+  {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return !in.fail();
+  }
+
+  void DescribeSolid(std::ostream& os, const G4VSolid* solid)
+  {
+    os << solid->GetEntityType() << '\n';
+    solid->StreamInfo(os);
+  }
+}
+
+// ***************************************************************************
+// Constructor & destructor
+// ***************************************************************************
+//
+G4SmartVoxelCache::G4SmartVoxelCache(const G4String& fileName)
+  : fFileName(fileName)
+{
+}
+
+G4SmartVoxelCache::~G4SmartVoxelCache()
+{
+  for (auto& entry : fLoaded)  { delete entry.second.head; }
+}
+
+// ***************************************************************************
+// Returns true if the volume has no parameterised daughters.
+// ***************************************************************************
+//
+G4bool G4SmartVoxelCache::IsCacheable(const G4LogicalVolume* pVolume)
+{
+  for (std::size_t i=0; i<pVolume->GetNoDaughters(); ++i)
+  {
+    if (pVolume->GetDaughter(i)->IsParameterised())  { return false; }
+  }
+  return true;
+}
+
+// ***************************************************************************
+// Returns the number of volumes referred to by the nodes of the voxels:
+// consumed nodes of a replicated daughter hold replica numbers.
+// ***************************************************************************
+//
+std::size_t G4SmartVoxelCache::GetNoContents(const G4LogicalVolume* pVolume)
+{
+  if ( (pVolume->GetNoDaughters() == 1)
+    && pVolume->GetDaughter(0)->IsReplicated() )
+  {
+    EAxis axis;
+    G4int nReplicas;
+    G4double width, offset;
+    G4bool consuming;
+    pVolume->GetDaughter(0)->GetReplicationData(axis, nReplicas, width,
+                                                offset, consuming);
+    return std::size_t(nReplicas);
+  }
+  return pVolume->GetNoDaughters();
+}
+
+// ***************************************************************************
+// Computes the 64-bit FNV-1a hash of a full description of the volume:
+// the solids (through their StreamInfo()), placements and replication data
+// used by G4SmartVoxelHeader when building the voxels.
+// ***************************************************************************
+//
+G4SmartVoxelCache::Key
+G4SmartVoxelCache::ComputeKey(const G4LogicalVolume* pVolume)
+{
+  std::ostringstream os;
+  os << std::setprecision(17);
+  os << kVersion << ' ' << kMaxVoxelNodes << ' ' << kMinVoxelVolumesLevel1
+     << ' ' << kMinVoxelVolumesLevel2 << ' ' << kMinVoxelVolumesLevel3 << '\n';
+  DescribeSolid(os, pVolume->GetSolid());
+  os << pVolume->GetSmartless() << ' ' << pVolume->GetNoDaughters() << '\n';
+
+  for (std::size_t i=0; i<pVolume->GetNoDaughters(); ++i)
+  {
+    const G4VPhysicalVolume* pDaughter = pVolume->GetDaughter(i);
+    DescribeSolid(os, pDaughter->GetLogicalVolume()->GetSolid());
+    const G4RotationMatrix* rot = pDaughter->GetRotation();
+    if (rot != nullptr)
+    {
+      os << rot->xx() << ' ' << rot->xy() << ' ' << rot->xz() << ' '
+         << rot->yx() << ' ' << rot->yy() << ' ' << rot->yz() << ' '
+         << rot->zx() << ' ' << rot->zy() << ' ' << rot->zz() << '\n';
+    }
+    const G4ThreeVector& tlate = pDaughter->GetTranslation();
+    os << tlate.x() << ' ' << tlate.y() << ' ' << tlate.z() << '\n';
+    if (pDaughter->IsReplicated())
+    {
+      EAxis axis;
+      G4int nReplicas;
+      G4double width, offset;
+      G4bool consuming;
+      pDaughter->GetReplicationData(axis, nReplicas, width, offset, consuming);
+      os << axis << ' ' << nReplicas << ' ' << width << ' ' << offset << ' '
+         << consuming << ' ' << pDaughter->GetRegularStructureId() << '\n';
+    }
+  }
+
+  const std::string& desc = os.str();
+  Key hash = 14695981039346656037ULL;
+  for (unsigned char c : desc)
+  {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+// ***************************************************************************
+// Reads all the voxels from file.
+// ***************************************************************************
+//
+G4bool G4SmartVoxelCache::Load()
+{
+  std::ifstream in(fFileName, std::ios::binary);
+  if (!in)  { return false; }
+
+  char magic[sizeof(kMagic)];
+  std::uint32_t version = 0, doubleSize = 0;
+  std::uint64_t nEntries = 0;
+  in.read(magic, sizeof(magic));
+  if ( !in || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0
+    || !Read(in, version) || version != kVersion
+    || !Read(in, doubleSize) || doubleSize != sizeof(G4double)
+    || !Read(in, nEntries) )
+  {
+    std::ostringstream message;
+    message << "File " << fFileName << " is not a valid voxel cache"
+            << G4endl << "        for this version or platform. Ignored.";
+    G4Exception("G4SmartVoxelCache::Load()", "GeomMgt1002",
+                JustWarning, message);
+    return false;
+  }
+
+  std::multimap<Key, Entry> loaded;
+  for (std::uint64_t n=0; n<nEntries; ++n)
+  {
+    Key key;
+    std::uint64_t nContents;
+    G4SmartVoxelHeader* head = nullptr;
+    if (Read(in, key) && Read(in, nContents))
+    {
+      head = ReadHeader(in, nContents);
+    }
+    if (head == nullptr)
+    {
+      for (auto& entry : loaded)  { delete entry.second.head; }
+      std::ostringstream message;
+      message << "Voxel cache file " << fFileName << " is corrupted."
+              << G4endl << "        Voxels will be rebuilt.";
+      G4Exception("G4SmartVoxelCache::Load()", "GeomMgt1002",
+                  JustWarning, message);
+      return false;
+    }
+    loaded.insert(std::make_pair(key, Entry{nContents, head}));
+  }
+  fNumberOfLoaded += loaded.size();
+  fLoaded.insert(loaded.cbegin(), loaded.cend());
+  return true;
+}
+
+// ***************************************************************************
+// Passes the voxels with the given key to the caller, once checked that
+// they were built for as many daughters or replicas as the volume has.
+// ***************************************************************************
+//
+G4SmartVoxelHeader*
+G4SmartVoxelCache::Retrieve(const G4LogicalVolume* pVolume, Key key)
+{
+  auto pos = fLoaded.find(key);
+  if (pos == fLoaded.end())  { return nullptr; }
+  auto head = const_cast<G4SmartVoxelHeader*>(pos->second.head);
+  const std::size_t nContents = pos->second.nContents;
+  fLoaded.erase(pos);
+  if (nContents != GetNoContents(pVolume))
+  {
+    delete head;
+    std::ostringstream message;
+    message << "Cached voxels of volume " << pVolume->GetName()
+            << " refer to " << nContents << " daughters or replicas,"
+            << G4endl << "        while the volume has "
+            << GetNoContents(pVolume) << ". Voxels will be rebuilt.";
+    G4Exception("G4SmartVoxelCache::Retrieve()", "GeomMgt1002",
+                JustWarning, message);
+    return nullptr;
+  }
+  ++fNumberOfRetrieved;
+  return head;
+}
+
+// ***************************************************************************
+// Records the voxels to be saved.
+// ***************************************************************************
+//
+void G4SmartVoxelCache::Insert(const G4LogicalVolume* pVolume, Key key,
+                               const G4SmartVoxelHeader* head)
+{
+  fRecorded.push_back(std::make_pair(key, Entry{GetNoContents(pVolume),
+                                                head}));
+}
+
+// ***************************************************************************
+// Writes the recorded voxels to file.
+// ***************************************************************************
+//
+G4bool G4SmartVoxelCache::Save()
+{
+  std::ofstream out(fFileName, std::ios::binary | std::ios::trunc);
+  if (out)
+  {
+    out.write(kMagic, sizeof(kMagic));
+    Write(out, kVersion);
+    Write(out, std::uint32_t(sizeof(G4double)));
+    Write(out, std::uint64_t(fRecorded.size()));
+    for (const auto& entry : fRecorded)
+    {
+      Write(out, entry.first);
+      Write(out, std::uint64_t(entry.second.nContents));
+      WriteHeader(out, entry.second.head);
+    }
+    out.close();
+  }
+  if (!out)
+  {
+    std::ostringstream message;
+    message << "Cannot write voxel cache file " << fFileName << ".";
+    G4Exception("G4SmartVoxelCache::Save()", "GeomMgt1002",
+                JustWarning, message);
+    return false;
+  }
+  return true;
+}
+
+// ***************************************************************************
+// Writes a header and its slices. Nodes and headers shared by consecutive
+// slices, as collected by G4SmartVoxelHeader, are written only once.
+// ***************************************************************************
+//
+void G4SmartVoxelCache::WriteHeader(std::ostream& out,
+                                    const G4SmartVoxelHeader* head)
+{
+  Write(out, std::int32_t(head->faxis));
+  Write(out, std::int32_t(head->fparamAxis));
+  Write(out, head->fminExtent);
+  Write(out, head->fmaxExtent);
+  Write(out, std::int32_t(head->fminEquivalent));
+  Write(out, std::int32_t(head->fmaxEquivalent));
+  Write(out, std::uint64_t(head->fslices.size()));
+
+  const G4SmartVoxelProxy* prev = nullptr;
+  for (const auto proxy : head->fslices)
+  {
+    if (proxy == prev)
+    {
+      Write(out, std::uint8_t(kSameProxy));
+    }
+    else if (proxy->IsNode())
+    {
+      const G4SmartVoxelNode* node = proxy->GetNode();
+      if (prev != nullptr && prev->IsNode() && prev->GetNode() == node)
+      {
+        Write(out, std::uint8_t(kSharedNode));
+      }
+      else
+      {
+        Write(out, std::uint8_t(kNewNode));
+        Write(out, std::int32_t(node->GetMinEquivalentSliceNo()));
+        Write(out, std::int32_t(node->GetMaxEquivalentSliceNo()));
+        const std::size_t nContained = node->GetNoContained();
+        Write(out, std::uint64_t(nContained));
+        for (std::size_t i=0; i<nContained; ++i)
+        {
+          Write(out, std::int32_t(node->GetVolume(i)));
+        }
+      }
+    }
+    else
+    {
+      const G4SmartVoxelHeader* subHead = proxy->GetHeader();
+      if (prev != nullptr && prev->IsHeader() && prev->GetHeader() == subHead)
+      {
+        Write(out, std::uint8_t(kSharedHeader));
+      }
+      else
+      {
+        Write(out, std::uint8_t(kNewHeader));
+        WriteHeader(out, subHead);
+      }
+    }
+    prev = proxy;
+  }
+}
+
+// ***************************************************************************
+// Reads a header and its slices, recreating the sharing of proxies, nodes
+// and headers between consecutive slices. In case of error, including
+// nodes with more volumes than "nContents" or with volume numbers out of
+// range, the partially read header is deleted and null is returned.
+// ***************************************************************************
+//
+G4SmartVoxelHeader* G4SmartVoxelCache::ReadHeader(std::istream& in,
+                                                  std::size_t nContents)
+{
+  std::int32_t axis, paramAxis, minEquivalent, maxEquivalent;
+  G4double minExtent, maxExtent;
+  std::uint64_t nSlices;
+  if ( !Read(in, axis) || !Read(in, paramAxis)
+    || !Read(in, minExtent) || !Read(in, maxExtent)
+    || !Read(in, minEquivalent) || !Read(in, maxEquivalent)
+    || !Read(in, nSlices) )
+  {
+    return nullptr;
+  }
+
+  auto head = new G4SmartVoxelHeader;
+  head->faxis = EAxis(axis);
+  head->fparamAxis = EAxis(paramAxis);
+  head->fminExtent = minExtent;
+  head->fmaxExtent = maxExtent;
+  head->fminEquivalent = minEquivalent;
+  head->fmaxEquivalent = maxEquivalent;
+
+  G4bool ok = true;
+  for (std::uint64_t n=0; ok && n<nSlices; ++n)
+  {
+    std::uint8_t code;
+    if (!Read(in, code))  { ok = false; break; }
+    G4SmartVoxelProxy* prev = head->fslices.empty()
+                            ? nullptr : head->fslices.back();
+    switch (code)
+    {
+      case kSameProxy:
+        ok = (prev != nullptr);
+        if (ok)  { head->fslices.push_back(prev); }
+        break;
+      case kSharedNode:
+        ok = (prev != nullptr && prev->IsNode());
+        if (ok)
+        {
+          head->fslices.push_back(new G4SmartVoxelProxy(prev->GetNode()));
+        }
+        break;
+      case kSharedHeader:
+        ok = (prev != nullptr && prev->IsHeader());
+        if (ok)
+        {
+          head->fslices.push_back(new G4SmartVoxelProxy(prev->GetHeader()));
+        }
+        break;
+      case kNewNode:
+      {
+        std::int32_t minEq, maxEq, volume;
+        std::uint64_t nContained;
+        ok = Read(in, minEq) && Read(in, maxEq) && Read(in, nContained)
+          && (nContained <= nContents);
+        if (!ok)  { break; }
+        auto node = new G4SmartVoxelNode;
+        node->SetMinEquivalentSliceNo(minEq);
+        node->SetMaxEquivalentSliceNo(maxEq);
+        for (std::uint64_t i=0; ok && i<nContained; ++i)
+        {
+          ok = Read(in, volume)
+            && (volume >= 0) && (std::size_t(volume) < nContents);
+          if (ok)  { node->Insert(volume); }
+        }
+        if (!ok)  { delete node; break; }
+        head->fslices.push_back(new G4SmartVoxelProxy(node));
+        break;
+      }
+      case kNewHeader:
+      {
+        G4SmartVoxelHeader* subHead = ReadHeader(in, nContents);
+        ok = (subHead != nullptr);
+        if (ok)  { head->fslices.push_back(new G4SmartVoxelProxy(subHead)); }
+        break;
+      }
+      default:
+        ok = false;
+    }
+  }
+  if (!ok)
+  {
+    delete head;
+    return nullptr;
+  }
+  return head;
+}
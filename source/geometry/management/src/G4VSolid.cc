@@ -145,6 +145,37 @@ void G4VSolid::ComputeDimensions(G4VPVParameterisation*,
                 FatalException, message);
 }
 
+//////////////////////////////////////////////////////////////////////////
+//
+// Compute distances for arrays of points and directions, by calling the
+// scalar methods
+
+void G4VSolid::DistanceToInVec(G4int n,
+                               const G4double* px, const G4double* py,
+                               const G4double* pz, const G4double* vx,
+                               const G4double* vy, const G4double* vz,
+                                     G4double* dist) const
+{
+  for (G4int i=0; i<n; ++i)
+  {
+    dist[i] = DistanceToIn(G4ThreeVector(px[i], py[i], pz[i]),
+                           G4ThreeVector(vx[i], vy[i], vz[i]));
+  }
+}
+
+void G4VSolid::DistanceToOutVec(G4int n,
+                                const G4double* px, const G4double* py,
+                                const G4double* pz, const G4double* vx,
+                                const G4double* vy, const G4double* vz,
+                                      G4double* dist) const
+{
+  for (G4int i=0; i<n; ++i)
+  {
+    dist[i] = DistanceToOut(G4ThreeVector(px[i], py[i], pz[i]),
+                            G4ThreeVector(vx[i], vy[i], vz[i]));
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 //
 // Throw exception (warning) for solids not implementing the method
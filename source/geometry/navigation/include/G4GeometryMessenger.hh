@@ -45,6 +45,7 @@ class G4UIcmdWithoutParameter;
 class G4UIcmdWithABool;
 class G4UIcmdWithAnInteger;
 class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAString;
 class G4TransportationManager;
 class G4GeomTestVolume;
 
@@ -73,7 +74,9 @@ class G4GeometryMessenger : public G4UImessenger
     G4UIcmdWithABool          *chkCmd, *pchkCmd, *verCmd;
     G4UIcmdWithoutParameter   *recCmd, *resCmd;
     G4UIcmdWithADoubleAndUnit *tolCmd;
-    G4UIcmdWithAnInteger      *verbCmd, *rslCmd, *rcsCmd, *rcdCmd, *errCmd;
+    G4UIcmdWithAString        *cacheCmd;
+    G4UIcmdWithAnInteger      *verbCmd, *rslCmd, *rcsCmd, *rcdCmd, *errCmd,
+                              *thrCmd;
 
     G4double tol = 0.0;
     G4int recLevel = 0, recDepth = -1;
@@ -56,6 +56,7 @@
 
 #include "G4NavigationHistory.hh"
 #include "G4NormalNavigation.hh"
+#include "G4BVHNavigation.hh"
 #include "G4VoxelNavigation.hh"
 #include "G4ParameterisedNavigation.hh"
 #include "G4ReplicaNavigation.hh"
@@ -521,6 +522,7 @@ private:
   // Helpers/Utility classes
   //
   G4NormalNavigation fnormalNav;
+  G4BVHNavigation fbvhNav;
 #ifdef ALTERNATIVE_VOXEL_NAV
   G4VoxelNavigation* fpvoxelNav;
 #else
@@ -6,6 +6,7 @@ geant4_add_module(G4navigation
     G4AuxiliaryNavServices.hh
     G4AuxiliaryNavServices.icc
     G4BrentLocator.hh
+    G4BVHNavigation.hh
     G4DrawVoxels.hh
     G4ErrorPropagationNavigator.hh
     G4GeomTestVolume.hh
@@ -45,6 +46,7 @@ geant4_add_module(G4navigation
   SOURCES
     G4AuxiliaryNavServices.cc
     G4BrentLocator.cc
+    G4BVHNavigation.cc
     G4DrawVoxels.cc
     G4ErrorPropagationNavigator.cc
     G4GeomTestVolume.cc
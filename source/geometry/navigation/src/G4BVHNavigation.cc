@@ -0,0 +1,374 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// class G4BVHNavigation Implementation
+//
+// --------------------------------------------------------------------
+
+#include <algorithm>
+#include <functional>
+
+#include "G4BVHNavigation.hh"
+#include "G4BoundingVolumeHierarchy.hh"
+#include "G4NavigationLogger.hh"
+#include "G4AffineTransform.hh"
+
+// ********************************************************************
+// Constructor
+// ********************************************************************
+//
+G4BVHNavigation::G4BVHNavigation()
+{
+  fLogger = new G4NavigationLogger("G4BVHNavigation");
+}
+
+// ********************************************************************
+// Destructor
+// ********************************************************************
+//
+G4BVHNavigation::~G4BVHNavigation()
+{
+  delete fLogger;
+}
+
+// ********************************************************************
+// LevelLocate
+// ********************************************************************
+//
+G4bool
+G4BVHNavigation::LevelLocate( G4NavigationHistory& history,
+                        const G4VPhysicalVolume* blockedVol,
+                        const G4int,
+                        const G4ThreeVector& globalPoint,
+                        const G4ThreeVector* globalDirection,
+                        const G4bool pLocatedOnEdge, 
+                              G4ThreeVector& localPoint )
+{
+  G4LogicalVolume* targetLogical = history.GetTopVolume()->GetLogicalVolume();
+  const G4BoundingVolumeHierarchy* bvh = targetLogical->GetBVH();
+
+  // Daughters whose extent contains the point, tried in the same order
+  // as G4NormalNavigation so that points on shared surfaces are
+  // assigned identically
+  //
+  fCandidates.clear();
+  bvh->TraversePoint(localPoint, [this](G4int i)
+  {
+    fCandidates.push_back(i);
+    return false;
+  });
+  std::sort(fCandidates.begin(), fCandidates.end(), std::greater<G4int>());
+
+  for (auto sampleNo : fCandidates)
+  {
+    G4VPhysicalVolume* samplePhysical = targetLogical->GetDaughter(sampleNo);
+    if ( samplePhysical!=blockedVol )
+    {
+      // Setup history
+      //
+      history.NewLevel(samplePhysical, kNormal, samplePhysical->GetCopyNo());
+      G4VSolid* sampleSolid = samplePhysical->GetLogicalVolume()->GetSolid();
+      G4ThreeVector samplePoint =
+        history.GetTopTransform().TransformPoint(globalPoint);
+      if( G4AuxiliaryNavServices::
+          CheckPointOnSurface(sampleSolid, samplePoint, globalDirection, 
+                              history.GetTopTransform(), pLocatedOnEdge) )
+      {
+        // Enter this daughter
+        //
+        localPoint = samplePoint;
+        return true;
+      }
+      history.BackLevel();
+    }
+  }
+  return false;
+}
+
+// ********************************************************************
+// ComputeStep
+// ********************************************************************
+//
+//  On entry
+//    exitNormal, validExitNormal:  for previous exited volume (daughter)
+// 
+//  On exit
+//    exitNormal, validExitNormal:  for mother, if exiting it (else unchanged)
+G4double
+G4BVHNavigation::ComputeStep(const G4ThreeVector& localPoint,
+                             const G4ThreeVector& localDirection,
+                             const G4double currentProposedStepLength,
+                                   G4double& newSafety,
+                                   G4NavigationHistory& history,
+                                   G4bool& validExitNormal,
+                                   G4ThreeVector& exitNormal,
+                                   G4bool& exiting,
+                                   G4bool& entering,
+                                   G4VPhysicalVolume* (*pBlockedPhysical),
+                                   G4int& blockedReplicaNo)
+{
+  G4VPhysicalVolume* blockedExitedVol = nullptr;
+  G4double ourStep = currentProposedStepLength, ourSafety;
+  G4double motherSafety, motherStep = DBL_MAX;
+  G4bool motherValidExitNormal = false;
+  G4ThreeVector motherExitNormal; 
+
+  G4VPhysicalVolume* motherPhysical = history.GetTopVolume();
+  G4LogicalVolume* motherLogical = motherPhysical->GetLogicalVolume();
+  G4VSolid* motherSolid = motherLogical->GetSolid();
+  const G4BoundingVolumeHierarchy* bvh = motherLogical->GetBVH();
+
+  // Compute mother safety
+  //
+  motherSafety = motherSolid->DistanceToOut(localPoint);
+  ourSafety = motherSafety; // Working isotropic safety
+
+#ifdef G4VERBOSE
+  if ( fCheck )
+  {
+    fLogger->PreComputeStepLog(motherPhysical, motherSafety, localPoint);
+  }
+#endif
+
+  // Exiting normal optimisation
+  //
+  if ( exiting && validExitNormal )
+  {
+    if ( localDirection.dot(exitNormal)>=kMinExitingNormalCosine )
+    {
+      // Block exited daughter volume
+      //
+      blockedExitedVol = (*pBlockedPhysical);
+      ourSafety = 0;
+    }
+  }
+  exiting  = false;
+  entering = false;
+
+  // Daughter safeties: only daughters whose extent is closer than the
+  // current estimate may lower it
+  //
+  bvh->TraverseDistance(localPoint, ourSafety, [&](G4int sampleNo)
+  {
+    const G4VPhysicalVolume* samplePhysical =
+      motherLogical->GetDaughter(sampleNo);
+    if ( samplePhysical==blockedExitedVol ) { return; }
+    G4AffineTransform sampleTf(samplePhysical->GetRotation(),
+                               samplePhysical->GetTranslation());
+    sampleTf.Invert();
+    const G4ThreeVector samplePoint = sampleTf.TransformPoint(localPoint);
+    const G4VSolid* sampleSolid =
+      samplePhysical->GetLogicalVolume()->GetSolid();
+    const G4double sampleSafety = sampleSolid->DistanceToIn(samplePoint);
+    if ( sampleSafety<ourSafety )
+    {
+      ourSafety = sampleSafety;
+    }
+  });
+
+  // Daughter intersections: only daughters whose extent is crossed
+  // within the current step
+  //
+  bvh->TraverseRay(localPoint, localDirection, ourStep, [&](G4int sampleNo)
+  {
+    G4VPhysicalVolume* samplePhysical = motherLogical->GetDaughter(sampleNo);
+    if ( samplePhysical==blockedExitedVol ) { return; }
+    G4AffineTransform sampleTf(samplePhysical->GetRotation(),
+                               samplePhysical->GetTranslation());
+    sampleTf.Invert();
+    const G4ThreeVector samplePoint = sampleTf.TransformPoint(localPoint);
+    const G4ThreeVector sampleDirection = sampleTf.TransformAxis(localDirection);
+    const G4VSolid* sampleSolid =
+      samplePhysical->GetLogicalVolume()->GetSolid();
+    const G4double sampleStep =
+      sampleSolid->DistanceToIn(samplePoint, sampleDirection);
+#ifdef G4VERBOSE
+    if ( fCheck )
+    {
+      fLogger->PrintDaughterLog(sampleSolid, samplePoint,
+                                sampleSolid->DistanceToIn(samplePoint), true,
+                                sampleDirection, sampleStep);
+    }
+#endif
+    if ( sampleStep<=ourStep )
+    {
+      ourStep  = sampleStep;
+      entering = true;
+      exiting  = false;
+      *pBlockedPhysical = samplePhysical;
+      blockedReplicaNo  = -1;
+    }
+  });
+
+  if ( currentProposedStepLength<ourSafety )
+  {
+    // Guaranteed physics limited
+    //
+    entering = false;
+    exiting  = false;
+    *pBlockedPhysical = nullptr;
+    ourStep = kInfinity;
+  }
+  else
+  {
+    // Consider intersection with mother solid
+    //
+    if ( motherSafety<=ourStep )
+    {
+      motherStep = motherSolid->DistanceToOut(localPoint,
+                                              localDirection,
+                                              true,
+                                             &motherValidExitNormal,
+                                             &motherExitNormal);
+#ifdef G4VERBOSE
+      if ( fCheck )
+      {
+        fLogger->PostComputeStepLog(motherSolid, localPoint, localDirection,
+                                    motherStep, motherSafety);
+        if( motherValidExitNormal )
+        {
+          fLogger->CheckAndReportBadNormal(motherExitNormal,
+                                           localPoint,
+                                           localDirection,
+                                           motherStep,
+                                           motherSolid,
+                                           "From motherSolid::DistanceToOut" );
+        }
+      }
+#endif
+      if( (motherStep >= kInfinity) || (motherStep < 0.0) )
+      {
+#ifdef G4VERBOSE
+        if( fCheck )  // Clearly outside the mother solid!
+        {
+          fLogger->ReportOutsideMother(localPoint, localDirection,
+                                       motherPhysical);
+        }
+#endif
+        ourStep = motherStep = 0.0;
+        exiting = true;
+        entering = false;
+        validExitNormal = false;
+        *pBlockedPhysical = nullptr;
+        blockedReplicaNo = 0;
+        newSafety = 0.0;
+        return ourStep;
+      }
+
+      if ( motherStep<=ourStep )
+      {
+        ourStep  = motherStep;
+        exiting  = true;
+        entering = false;
+        validExitNormal = motherValidExitNormal;
+        exitNormal = motherExitNormal;
+        
+        if ( motherValidExitNormal )
+        {
+          const G4RotationMatrix* rot = motherPhysical->GetRotation();
+          if (rot != nullptr)
+          {
+            exitNormal *= rot->inverse();
+          }
+        }
+      }
+      else
+      {
+        validExitNormal = false;
+      }
+    }
+  }
+  newSafety = ourSafety;
+  return ourStep;
+}
+
+// ********************************************************************
+// ComputeSafety
+// ********************************************************************
+//
+G4double G4BVHNavigation::ComputeSafety(const G4ThreeVector& localPoint,
+                                        const G4NavigationHistory& history,
+                                        const G4double)
+{
+  G4LogicalVolume* motherLogical = history.GetTopVolume()->GetLogicalVolume();
+  G4VSolid* motherSolid = motherLogical->GetSolid();
+
+  // Compute mother safety
+  //
+  G4double ourSafety = motherSolid->DistanceToOut(localPoint);
+
+#ifdef G4VERBOSE
+  if( fCheck )
+  {
+    fLogger->ComputeSafetyLog(motherSolid,localPoint,ourSafety,true,true);
+  }
+#endif
+
+  // Compute safeties of the daughters closer than the current estimate
+  //
+  motherLogical->GetBVH()->TraverseDistance(localPoint, ourSafety,
+    [&](G4int sampleNo)
+  {
+    const G4VPhysicalVolume* samplePhysical =
+      motherLogical->GetDaughter(sampleNo);
+    G4AffineTransform sampleTf(samplePhysical->GetRotation(),
+                               samplePhysical->GetTranslation());
+    sampleTf.Invert();
+    const G4ThreeVector samplePoint = sampleTf.TransformPoint(localPoint);
+    const G4VSolid* sampleSolid =
+      samplePhysical->GetLogicalVolume()->GetSolid();
+    const G4double sampleSafety = sampleSolid->DistanceToIn(samplePoint);
+    if ( sampleSafety<ourSafety )
+    {
+      ourSafety = sampleSafety;
+    }
+#ifdef G4VERBOSE
+    if(fCheck)
+    {
+      fLogger->ComputeSafetyLog(sampleSolid, samplePoint,
+                                sampleSafety, false, false);
+    }
+#endif
+  });
+  return ourSafety;
+}
+
+// ********************************************************************
+// GetVerboseLevel
+// ********************************************************************
+//
+G4int G4BVHNavigation::GetVerboseLevel() const
+{
+  return fLogger->GetVerboseLevel();
+}
+
+// ********************************************************************
+// SetVerboseLevel
+// ********************************************************************
+//
+void G4BVHNavigation::SetVerboseLevel(G4int level)
+{
+  fLogger->SetVerboseLevel(level);
+}
@@ -44,6 +44,7 @@
 #include "G4UIcmdWithABool.hh"
 #include "G4UIcmdWithAnInteger.hh"
 #include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
 
 #include "G4GeomTestVolume.hh"
 
@@ -105,6 +106,31 @@ G4GeometryMessenger::G4GeometryMessenger(G4TransportationManager* tman)
   pchkCmd->SetDefaultValue(true);
   pchkCmd->AvailableForStates(G4State_Idle);
 
+  thrCmd = new G4UIcmdWithAnInteger( "/geometry/navigator/build_threads", this );
+  thrCmd->SetGuidance( "Set the number of threads for building the voxels." );
+  thrCmd->SetGuidance( "The voxels of volumes whose daughters are all" );
+  thrCmd->SetGuidance( "placements are built concurrently when closing the" );
+  thrCmd->SetGuidance( "geometry. A value smaller than 2 disables it (default)." );
+  thrCmd->SetGuidance( "User-defined solids must compute their extent in a" );
+  thrCmd->SetGuidance( "thread-safe way (CalculateExtent())." );
+  thrCmd->SetGuidance( "NOTE: this command has effect -only- if Geant4 has" );
+  thrCmd->SetGuidance( "      been installed in multi-threaded mode!" );
+  thrCmd->SetParameterName("nThreads",true);
+  thrCmd->SetDefaultValue(1);
+  thrCmd->SetRange("nThreads >=0");
+  thrCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  cacheCmd = new G4UIcmdWithAString( "/geometry/navigator/voxel_cache", this );
+  cacheCmd->SetGuidance( "Set the file used as persistent cache of the voxels." );
+  cacheCmd->SetGuidance( "When closing the geometry, the voxels of volumes" );
+  cacheCmd->SetGuidance( "unchanged since the file was written are reloaded" );
+  cacheCmd->SetGuidance( "from it; the file is updated if any voxels had to" );
+  cacheCmd->SetGuidance( "be built. Volumes with parameterised daughters are" );
+  cacheCmd->SetGuidance( "not cached. An empty name disables the cache." );
+  cacheCmd->SetParameterName("fileName",true);
+  cacheCmd->SetDefaultValue("");
+  cacheCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
   //
   // Geometry verification test commands
   //
@@ -175,7 +201,8 @@ G4GeometryMessenger::~G4GeometryMessenger()
   delete verCmd; delete recCmd; delete rslCmd;
   delete resCmd; delete rcsCmd; delete rcdCmd; delete errCmd;
   delete tolCmd;
-  delete verbCmd; delete pchkCmd; delete chkCmd;
+  delete verbCmd; delete pchkCmd; delete chkCmd; delete thrCmd;
+  delete cacheCmd;
   delete geodir; delete navdir; delete testdir;
   delete tvolume;
 }
@@ -219,6 +246,13 @@ G4GeometryMessenger::SetNewValue( G4UIcommand* command, G4String newValues )
   else if (command == pchkCmd) {
     SetPushFlag( newValues );
   }
+  else if (command == cacheCmd) {
+    G4GeometryManager::GetInstance()->SetVoxelCacheFile( newValues );
+  }
+  else if (command == thrCmd) {
+    G4GeometryManager::GetInstance()
+      ->SetNumberOfBuildThreads(thrCmd->GetNewIntValue( newValues ));
+  }
   else if (command == tolCmd) {
     Init();
     tol = tolCmd->GetNewDoubleValue( newValues )
@@ -262,6 +296,15 @@ G4GeometryMessenger::GetCurrentValue( G4UIcommand* command )
   {
     cv = tolCmd->ConvertToString( tol, "mm" );
   }
+  else if (command == cacheCmd)
+  {
+    cv = G4GeometryManager::GetInstance()->GetVoxelCacheFile();
+  }
+  else if (command == thrCmd)
+  {
+    cv = thrCmd->ConvertToString(
+           G4GeometryManager::GetInstance()->GetNumberOfBuildThreads() );
+  }
   return cv;
 }
 
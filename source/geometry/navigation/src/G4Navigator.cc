@@ -463,7 +463,17 @@ G4Navigator::LocateGlobalPointAndSetup( const G4ThreeVector& globalPoint,
     switch( CharacteriseDaughters(targetLogical) )
     {
       case kNormal:
-        if ( targetLogical->GetVoxelHeader() )  // use optimised navigation
+        if ( targetLogical->GetBVH() )  // use hierarchy of daughters
+        {
+          noResult = fbvhNav.LevelLocate(fHistory,
+                                         fBlockedPhysicalVolume,
+                                         fBlockedReplicaNo,
+                                         globalPoint,
+                                         pGlobalDirection,
+                                         considerDirection,
+                                         localPoint);
+        }
+        else if ( targetLogical->GetVoxelHeader() )  // use optimised navigation
         {
           noResult = GetVoxelNavigator().LevelLocate(fHistory,
                                            fBlockedPhysicalVolume,
@@ -839,7 +849,21 @@ G4double G4Navigator::ComputeStep( const G4ThreeVector& pGlobalpoint,
     switch( CharacteriseDaughters(motherLogical) )
     {
       case kNormal:
-        if ( motherLogical->GetVoxelHeader() )
+        if ( motherLogical->GetBVH() )
+        {
+          Step = fbvhNav.ComputeStep(fLastLocatedPointLocal,
+                                     localDirection,
+                                     pCurrentProposedStepLength,
+                                     pNewSafety,
+                                     fHistory,
+                                     fValidExitNormal,
+                                     fExitNormal,
+                                     fExiting,
+                                     fEntering,
+                                     &fBlockedPhysicalVolume,
+                                     fBlockedReplicaNo);
+        }
+        else if ( motherLogical->GetVoxelHeader() )
         {
           Step = GetVoxelNavigator().ComputeStep(fLastLocatedPointLocal,
                                        localDirection,
@@ -1885,7 +1909,11 @@ G4double G4Navigator::ComputeSafety( const G4ThreeVector& pGlobalpoint,
       switch(CharacteriseDaughters(motherLogical))
       {
         case kNormal:
-          if ( pVoxelHeader )
+          if ( motherLogical->GetBVH() )
+          {
+            newSafety = fbvhNav.ComputeSafety(localPoint, fHistory, pMaxLength);
+          }
+          else if ( pVoxelHeader )
           {
             newSafety = fpVoxelSafety->ComputeSafety(localPoint,
                                              *motherPhysical, pMaxLength);
@@ -127,6 +127,19 @@ class G4Trd : public G4CSGSolid
 
     G4double DistanceToOut( const G4ThreeVector& p ) const;
 
+    void DistanceToInVec(G4int n,
+                         const G4double* px, const G4double* py,
+                         const G4double* pz, const G4double* vx,
+                         const G4double* vy, const G4double* vz,
+                               G4double* dist) const;
+    void DistanceToOutVec(G4int n,
+                          const G4double* px, const G4double* py,
+                          const G4double* pz, const G4double* vx,
+                          const G4double* vy, const G4double* vz,
+                                G4double* dist) const;
+      // Branch-free versions of DistanceToIn(p,v) and DistanceToOut(p,v)
+      // for arrays of points and directions, suitable for vectorisation.
+
     G4GeometryType GetEntityType() const;
 
     G4ThreeVector GetPointOnSurface() const;
@@ -464,6 +464,90 @@ G4double G4Box::DistanceToOut(const G4ThreeVector& p) const
   return (dist > 0) ? dist : 0.;
 }
 
+//////////////////////////////////////////////////////////////////////////
+//
+// Calculate distances to box from outside for arrays of points and
+// directions. Same algorithm as the scalar method, written without
+// branches; divisions by zero are avoided for unused values
+
+void G4Box::DistanceToInVec(G4int n,
+                            const G4double* px, const G4double* py,
+                            const G4double* pz, const G4double* vx,
+                            const G4double* vy, const G4double* vz,
+                                  G4double* dist) const
+{
+  const G4double hx = fDx, hy = fDy, hz = fDz, tol = delta;
+  for (G4int i=0; i<n; ++i)
+  {
+    G4double x = px[i], y = py[i], z = pz[i];
+    G4double ux = vx[i], uy = vy[i], uz = vz[i];
+
+    // Check if point is on the surface and traveling away
+    //
+    G4bool away = (((std::abs(x) - hx) >= -tol) & (x*ux >= 0))
+                | (((std::abs(y) - hy) >= -tol) & (y*uy >= 0))
+                | (((std::abs(z) - hz) >= -tol) & (z*uz >= 0));
+
+    // Find intersection
+    //
+    G4double invx = (ux == 0) ? DBL_MAX : -1./((ux == 0) ? 1. : ux);
+    G4double dx = std::copysign(hx,invx);
+    G4double txmin = (x - dx)*invx;
+    G4double txmax = (x + dx)*invx;
+
+    G4double invy = (uy == 0) ? DBL_MAX : -1./((uy == 0) ? 1. : uy);
+    G4double dy = std::copysign(hy,invy);
+    G4double tymin = std::max(txmin,(y - dy)*invy);
+    G4double tymax = std::min(txmax,(y + dy)*invy);
+
+    G4double invz = (uz == 0) ? DBL_MAX : -1./((uz == 0) ? 1. : uz);
+    G4double dz = std::copysign(hz,invz);
+    G4double tmin = std::max(tymin,(z - dz)*invz);
+    G4double tmax = std::min(tymax,(z + dz)*invz);
+
+    G4double tin = (tmin < tol) ? 0. : tmin;
+    dist[i] = (away | (tmax <= tmin + tol)) ? kInfinity : tin;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Calculate distances to surface of box from inside for arrays of points
+// and directions, without normals
+
+void G4Box::DistanceToOutVec(G4int n,
+                             const G4double* px, const G4double* py,
+                             const G4double* pz, const G4double* vx,
+                             const G4double* vy, const G4double* vz,
+                                   G4double* dist) const
+{
+  const G4double hx = fDx, hy = fDy, hz = fDz, tol = delta;
+  for (G4int i=0; i<n; ++i)
+  {
+    G4double x = px[i], y = py[i], z = pz[i];
+    G4double ux = vx[i], uy = vy[i], uz = vz[i];
+
+    // Check if point is on the surface and traveling away
+    //
+    G4bool away = (((std::abs(x) - hx) >= -tol) & (x*ux > 0))
+                | (((std::abs(y) - hy) >= -tol) & (y*uy > 0))
+                | (((std::abs(z) - hz) >= -tol) & (z*uz > 0));
+
+    // Find intersection
+    //
+    G4double tx = (ux == 0)
+                ? DBL_MAX : (std::copysign(hx,ux) - x)/((ux == 0) ? 1. : ux);
+    G4double ty = (uy == 0)
+                ? tx : (std::copysign(hy,uy) - y)/((uy == 0) ? 1. : uy);
+    G4double txy = std::min(tx,ty);
+    G4double tz = (uz == 0)
+                ? txy : (std::copysign(hz,uz) - z)/((uz == 0) ? 1. : uz);
+    G4double tmax = std::min(txy,tz);
+
+    dist[i] = away ? 0. : tmax;
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 //
 // GetEntityType
@@ -399,6 +399,74 @@ G4double G4Orb::DistanceToOut( const G4ThreeVector& p ) const
   return (dist > 0) ? dist : 0.;
 }
 
+//////////////////////////////////////////////////////////////////////////
+//
+// Calculate distances to orb from outside for arrays of points and
+// directions. Same algorithm as the scalar method, written without
+// branches; the rare distant points, for which the scalar method
+// recomputes the distance closer to the orb, are handled in a second pass
+
+void G4Orb::DistanceToInVec(G4int n,
+                            const G4double* px, const G4double* py,
+                            const G4double* pz, const G4double* vx,
+                            const G4double* vy, const G4double* vz,
+                                  G4double* dist) const
+{
+  const G4double rmax = fRmax, sqrRmaxTol = sqrRmaxMinusTol;
+  const G4double tol = halfRmaxTol, Dmax = 32*fRmax;
+  for (G4int i=0; i<n; ++i)
+  {
+    G4double rr = px[i]*px[i] + py[i]*py[i] + pz[i]*pz[i];
+    G4double pv = px[i]*vx[i] + py[i]*vy[i] + pz[i]*vz[i];
+    G4bool away = (rr >= sqrRmaxTol) & (pv >= 0);
+
+    G4double D  = pv*pv - rr + rmax*rmax;
+    G4double sqrtD = std::sqrt(std::max(D, 0.));
+    G4double tmin = -pv - sqrtD;
+    G4bool miss = away | (D < 0);
+    G4bool far = !miss & (tmin > Dmax);
+
+    G4double tin = (tmin < tol) ? 0. : tmin;
+    tin = (sqrtD*2 <= tol) ? kInfinity : tin;
+    dist[i] = miss ? kInfinity : (far ? -1. : tin);
+  }
+
+  for (G4int i=0; i<n; ++i)
+  {
+    if (dist[i] < 0)
+    {
+      dist[i] = DistanceToIn(G4ThreeVector(px[i], py[i], pz[i]),
+                             G4ThreeVector(vx[i], vy[i], vz[i]));
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Calculate distances to surface of orb from inside for arrays of points
+// and directions, without normals
+
+void G4Orb::DistanceToOutVec(G4int n,
+                             const G4double* px, const G4double* py,
+                             const G4double* pz, const G4double* vx,
+                             const G4double* vy, const G4double* vz,
+                                   G4double* dist) const
+{
+  const G4double rmax = fRmax, sqrRmaxTol = sqrRmaxMinusTol;
+  const G4double tol = halfRmaxTol;
+  for (G4int i=0; i<n; ++i)
+  {
+    G4double rr = px[i]*px[i] + py[i]*py[i] + pz[i]*pz[i];
+    G4double pv = px[i]*vx[i] + py[i]*vy[i] + pz[i]*vz[i];
+    G4bool away = (rr >= sqrRmaxTol) & (pv > 0);
+
+    G4double D  = pv*pv - rr + rmax*rmax;
+    G4double tmax = (D <= 0) ? 0. : std::sqrt(std::max(D, 0.)) - pv;
+    tmax = (tmax < tol) ? 0. : tmax;
+    dist[i] = away ? 0. : tmax;
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 //
 // G4EntityType
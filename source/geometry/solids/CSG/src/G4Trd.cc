@@ -670,6 +670,99 @@ G4double G4Trd::DistanceToOut( const G4ThreeVector& p ) const
   return (dist < 0) ? -dist : 0.;
 }
 
+//////////////////////////////////////////////////////////////////////////
+//
+// Calculate distances to trd from outside for arrays of points and
+// directions. Same algorithm as the scalar method, written without
+// branches; divisions by zero are avoided for unused values
+
+void G4Trd::DistanceToInVec(G4int n,
+                            const G4double* px, const G4double* py,
+                            const G4double* pz, const G4double* vx,
+                            const G4double* vy, const G4double* vz,
+                                  G4double* dist) const
+{
+  const G4double hz = fDz, tol = halfCarTolerance;
+  const G4double by = fPlanes[0].b, cy = fPlanes[0].c, dy = fPlanes[0].d;
+  const G4double ax = fPlanes[2].a, cx = fPlanes[2].c, dx = fPlanes[2].d;
+  for (G4int i=0; i<n; ++i)
+  {
+    G4double x = px[i], y = py[i], z = pz[i];
+    G4double ux = vx[i], uy = vy[i], uz = vz[i];
+
+    // Z intersections
+    //
+    G4bool miss = ((std::abs(z) - hz) >= -tol) & (z*uz >= 0);
+    G4double invz = (-uz == 0) ? DBL_MAX : -1./((uz == 0) ? 1. : uz);
+    G4double dz = (invz < 0) ? hz : -hz;
+    G4double tmin = (z + dz)*invz;
+    G4double tmax = (z - dz)*invz;
+
+    // Y and X intersections, same sequence of updates as the scalar method
+    //
+    G4double ya = by*uy, yb = cy*uz, yc = by*y, yd = cy*z + dy;
+    G4double xa = ax*ux, xb = cx*uz, xc = ax*x, xd = cx*z + dx;
+    const G4double cosa[4] = { yb + ya, yb - ya, xb + xa, xb - xa };
+    const G4double dis[4]  = { yd + yc, yd - yc, xd + xc, xd - xc };
+    for (G4int k=0; k<4; ++k)
+    {
+      G4bool out = dis[k] >= -tol;
+      miss |= out & (cosa[k] >= 0);
+      G4double tmp = -dis[k]/((cosa[k] == 0) ? 1. : cosa[k]);
+      tmin = (out & (cosa[k] < 0) & (tmin < tmp)) ? tmp : tmin;
+      tmax = (!out & (cosa[k] > 0) & (tmax > tmp)) ? tmp : tmax;
+    }
+
+    // Find distance
+    //
+    G4double tin = (tmin < tol) ? 0. : tmin;
+    dist[i] = (miss | (tmax <= tmin + tol)) ? kInfinity : tin;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Calculate distances to surface of trd from inside for arrays of points
+// and directions, without normals
+
+void G4Trd::DistanceToOutVec(G4int n,
+                             const G4double* px, const G4double* py,
+                             const G4double* pz, const G4double* vx,
+                             const G4double* vy, const G4double* vz,
+                                   G4double* dist) const
+{
+  const G4double hz = fDz, tol = halfCarTolerance;
+  G4double pa[4], pb[4], pc[4], pd[4];
+  for (G4int k=0; k<4; ++k)
+  {
+    pa[k] = fPlanes[k].a; pb[k] = fPlanes[k].b;
+    pc[k] = fPlanes[k].c; pd[k] = fPlanes[k].d;
+  }
+  for (G4int i=0; i<n; ++i)
+  {
+    G4double x = px[i], y = py[i], z = pz[i];
+    G4double ux = vx[i], uy = vy[i], uz = vz[i];
+
+    // Z intersections
+    //
+    G4bool away = ((std::abs(z) - hz) >= -tol) & (z*uz > 0);
+    G4double tmax = (uz == 0)
+                  ? DBL_MAX : (std::copysign(hz,uz) - z)/((uz == 0) ? 1. : uz);
+
+    // Y and X intersections
+    //
+    for (G4int k=0; k<4; ++k)
+    {
+      G4double cosa = pa[k]*ux + pb[k]*uy + pc[k]*uz;
+      G4double d = pa[k]*x + pb[k]*y + pc[k]*z + pd[k];
+      away |= (cosa > 0) & (d >= -tol);
+      G4double tmp = -d/((cosa > 0) ? cosa : 1.);
+      tmax = ((cosa > 0) & (tmax > tmp)) ? tmp : tmax;
+    }
+    dist[i] = away ? 0. : tmax;
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 //
 // GetEntityType
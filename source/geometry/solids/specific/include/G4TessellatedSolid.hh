@@ -81,6 +81,14 @@
 //    Finally declare the solid is complete:
 //
 //      solidTarget->SetSolidClosed(true);
+//
+//    For meshes of very many facets, a bounding volume hierarchy of the
+//    facets can be used in place of the voxelization, by calling
+//    SetBVHAcceleration(true) before closing the solid. The hierarchy is
+//    faster to build and smaller than the voxels; the data of triangular
+//    facets are in addition packed in the order of its leaves, so that the
+//    facets crossed by a ray are screened a leaf at a time before the
+//    exact intersection.
 
 // 31.10.2004, P R Truscott, QinetiQ Ltd, UK - Created.
 // 12.10.2012, M Gayer, CERN - New implementation with voxelization of surfaces.
@@ -109,6 +117,8 @@
 #include "G4Voxelizer.hh"
 #include "G4VFacet.hh"
 
+class G4BoundingVolumeHierarchy;
+
 struct G4VertexInfo
 {
   G4int id;
@@ -183,6 +193,11 @@ class G4TessellatedSolid : public G4VSolid
 
     inline G4Voxelizer& GetVoxels();
 
+    inline void SetBVHAcceleration(G4bool val);
+    inline G4bool IsBVHAcceleration() const;
+      // Use a bounding volume hierarchy of the facets instead of voxels.
+      // To be set before SetSolidClosed(true)
+
     virtual G4bool CalculateExtent(const EAxis pAxis,
                                    const G4VoxelLimits& pVoxelLimit,
                                    const G4AffineTransform& pTransform,
@@ -234,6 +249,21 @@ class G4TessellatedSolid : public G4VSolid
 
     void Voxelize();
 
+    void BuildBVH();
+    G4int SelectCandidates(G4int first, G4int count,
+                           const G4ThreeVector& p, const G4ThreeVector& v,
+                           G4bool outgoing, G4bool ingoing,
+                           G4int* candidates) const;
+    G4double DistanceToInBVH(const G4ThreeVector& p,
+                             const G4ThreeVector& v) const;
+    G4double DistanceToOutBVH(const G4ThreeVector& p,
+                              const G4ThreeVector& v,
+                                    G4ThreeVector& aNormalVector,
+                                    G4bool& aConvex) const;
+    EInside InsideBVH(const G4ThreeVector& p) const;
+    G4double MinDistanceFacetBVH(const G4ThreeVector& p,
+                                       G4int& minCandidate) const;
+
     void CreateVertexList();
 
     void PrecalculateInsides();
@@ -295,6 +325,10 @@ class G4TessellatedSolid : public G4VSolid
     G4Voxelizer fVoxels;  // Pointer to the voxelized solid
 
     G4SurfBits fInsides;
+
+    G4bool fUseBVH = false;
+    G4BoundingVolumeHierarchy* fBVH = nullptr;
+    std::vector<G4double> fPackedFacets;  // Triangles in BVH leaf order
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -316,6 +350,16 @@ inline G4Voxelizer &G4TessellatedSolid::GetVoxels()
   return fVoxels;
 }
 
+inline void G4TessellatedSolid::SetBVHAcceleration(G4bool val)
+{
+  fUseBVH = val;
+}
+
+inline G4bool G4TessellatedSolid::IsBVHAcceleration() const
+{
+  return fUseBVH;
+}
+
 inline G4bool G4TessellatedSolid::OutsideOfExtent(const G4ThreeVector& p,
                                                   G4double tolerance) const
 {
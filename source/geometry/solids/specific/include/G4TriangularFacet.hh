@@ -107,6 +107,9 @@ class G4TriangularFacet : public G4VFacet
 
   private:
 
+    friend class G4TessellatedSolid;
+      // Packs the data of Intersect() for its BVH acceleration
+
     void CopyFrom(const G4TriangularFacet& rhs);
     void MoveFrom(G4TriangularFacet& rhs);
 
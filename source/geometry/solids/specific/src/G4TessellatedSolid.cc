@@ -66,6 +66,8 @@
 #include "G4VoxelLimits.hh"
 #include "G4AffineTransform.hh"
 #include "G4BoundingEnvelope.hh"
+#include "G4BoundingVolumeHierarchy.hh"
+#include "G4TriangularFacet.hh"
 
 #include "G4PolyhedronArbitrary.hh"
 #include "G4VGraphicsScene.hh"
@@ -76,6 +78,14 @@
 namespace
 {
   G4Mutex polyhedronMutex = G4MUTEX_INITIALIZER;
+
+  // Layout of fPackedFacets: one array per field, each over the facets
+  // in the leaf order of the BVH
+  //
+  enum { kNx, kNy, kNz, kX0, kY0, kZ0, kE1x, kE1y, kE1z,
+         kE2x, kE2y, kE2z, kNumberOfPackedFields };
+
+  const G4int kBVHLeafSize = 4;
 }
 
 using namespace std;
@@ -178,6 +188,8 @@ void G4TessellatedSolid::DeleteObjects()
   for (G4int i = 0; i < size; ++i)  { delete fFacets[i]; }
   fFacets.clear();
   delete fpPolyhedron; fpPolyhedron = nullptr;
+  delete fBVH; fBVH = nullptr;
+  fPackedFacets.clear();
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -190,6 +202,7 @@ void G4TessellatedSolid::CopyObjects (const G4TessellatedSolid &ts)
     fVoxels.SetMaxVoxels(reductionRatio);
   else
     fVoxels.SetMaxVoxels(fmaxVoxels);
+  fUseBVH = ts.fUseBVH;
 
   G4int n = ts.GetNumberOfFacets();
   for (G4int i = 0; i < n; ++i)
@@ -384,6 +397,296 @@ void G4TessellatedSolid::Voxelize ()
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// Build the bounding volume hierarchy of the facets, used in place of the
+// voxels. The boxes of the facets are enlarged as in G4Voxelizer, so that
+// they bound the distances and intersections computed by the facets.
+// The data used by G4TriangularFacet::Intersect() are then copied to
+// fPackedFacets, in the order of the leaves; other facets are left zero
+// and are never screened out.
+//
+void G4TessellatedSolid::BuildBVH()
+{
+  delete fBVH;
+  fBVH = new G4BoundingVolumeHierarchy;
+
+  G4int size = fFacets.size();
+  vector<G4ThreeVector> pMin(size), pMax(size);
+  G4ThreeVector toleranceVector(10*kCarTolerance, 10*kCarTolerance,
+                                10*kCarTolerance);
+  G4ThreeVector x(1,0,0), y(0,1,0), z(0,0,1);
+  for (G4int i = 0; i < size; ++i)
+  {
+    G4VFacet& facet = *fFacets[i];
+    pMax[i].set(facet.Extent(x), facet.Extent(y), facet.Extent(z));
+    pMin[i].set(-facet.Extent(-x), -facet.Extent(-y), -facet.Extent(-z));
+    pMin[i] -= toleranceVector;
+    pMax[i] += toleranceVector;
+  }
+  fBVH->Build(pMin, pMax, kBVHLeafSize);
+
+  const vector<G4int>& items = fBVH->GetItems();
+  fPackedFacets.assign(kNumberOfPackedFields*size, 0.0);
+  for (G4int j = 0; j < size; ++j)
+  {
+    auto facet = dynamic_cast<G4TriangularFacet*>(fFacets[items[j]]);
+    if (facet == nullptr || !facet->IsDefined()) continue;
+
+    const G4ThreeVector& n = facet->fSurfaceNormal;
+    G4ThreeVector p0 = facet->GetVertex(0);
+    const G4ThreeVector& e1 = facet->fE1;
+    const G4ThreeVector& e2 = facet->fE2;
+    G4double* data = &fPackedFacets[j];
+    for (G4int k = 0; k < 3; ++k)
+    {
+      data[(kNx+k)*size]  = n[k];
+      data[(kX0+k)*size]  = p0[k];
+      data[(kE1x+k)*size] = e1[k];
+      data[(kE2x+k)*size] = e2[k];
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Screen the facets at positions [first,first+count) of the BVH leaf order
+// against the ray p + t*v, and store the indices of those which may be
+// crossed leaving the solid (if outgoing) or entering it (if ingoing).
+// The tests are the rejections of G4TriangularFacet::Intersect(), made on
+// the packed data with twice its tolerances, so that a facet is discarded
+// only if Intersect() would return false. They are written without branches
+// for the loop over the facets of a leaf to be vectorised.
+// Return the number of candidates; count must not exceed kBVHLeafSize.
+//
+G4int G4TessellatedSolid::SelectCandidates(G4int first, G4int count,
+                                           const G4ThreeVector& p,
+                                           const G4ThreeVector& v,
+                                           G4bool outgoing, G4bool ingoing,
+                                           G4int* candidates) const
+{
+  const G4double dirTolerance = 2.0E-14;
+  const G4double tolerance = 2*kCarTolerance;
+
+  const G4int size = fFacets.size();
+  const G4double* data = fPackedFacets.data() + first;
+  const G4double* nx  = data + kNx*size;
+  const G4double* ny  = data + kNy*size;
+  const G4double* nz  = data + kNz*size;
+  const G4double* x0  = data + kX0*size;
+  const G4double* y0  = data + kY0*size;
+  const G4double* z0  = data + kZ0*size;
+  const G4double* e1x = data + kE1x*size;
+  const G4double* e1y = data + kE1y*size;
+  const G4double* e1z = data + kE1z*size;
+  const G4double* e2x = data + kE2x*size;
+  const G4double* e2y = data + kE2y*size;
+  const G4double* e2z = data + kE2z*size;
+
+  const G4double px = p.x(), py = p.y(), pz = p.z();
+  const G4double vx = v.x(), vy = v.y(), vz = v.z();
+
+  G4double pass[kBVHLeafSize];  // 1 or 0: a G4bool mask is not vectorised
+  for (G4int k = 0; k < count; ++k)
+  {
+    // Direction and distance with respect to the plane of the facet
+    //
+    G4double w = vx*nx[k] + vy*ny[k] + vz*nz[k];
+    G4double dfs = (x0[k]-px)*nx[k] + (y0[k]-py)*ny[k] + (z0[k]-pz)*nz[k];
+
+    // Crossing of the plane inside the triangle, with its tolerances
+    //
+    G4double a = e1x[k]*e1x[k] + e1y[k]*e1y[k] + e1z[k]*e1z[k];
+    G4double b = e1x[k]*e2x[k] + e1y[k]*e2y[k] + e1z[k]*e2z[k];
+    G4double c = e2x[k]*e2x[k] + e2y[k]*e2y[k] + e2z[k]*e2z[k];
+    G4double det = std::fabs(a*c - b*b);
+    G4bool packed = det > 0.0;
+    G4bool crossing = packed & (std::fabs(w) >= dirTolerance);
+    G4double dist = dfs/(crossing ? w : 1.0);
+    G4double ddx = x0[k] - (px + vx*dist);
+    G4double ddy = y0[k] - (py + vy*dist);
+    G4double ddz = z0[k] - (pz + vz*dist);
+    G4double d = e1x[k]*ddx + e1y[k]*ddy + e1z[k]*ddz;
+    G4double e = e2x[k]*ddx + e2y[k]*ddy + e2z[k]*ddz;
+    G4double ss = b*e - c*d;
+    G4double t = b*d - a*e;
+    G4double sTolerance = (std::fabs(b)+std::fabs(c)+std::fabs(d)+std::fabs(e))
+                        * tolerance;
+    G4double tTolerance = (std::fabs(a)+std::fabs(b)+std::fabs(d)+std::fabs(e))
+                        * tolerance;
+    G4double detTolerance = (std::fabs(a)+std::fabs(c)+2*std::fabs(b))
+                          * tolerance;
+    G4bool outside = (ss < -sTolerance) | (t < -tTolerance)
+                   | (ss + t - det > detTolerance);
+
+    G4bool rejectOut = packed & ((w < -dirTolerance) | (dfs < -kCarTolerance)
+                     | (crossing & (dfs >= kCarToleranceHalf) & outside));
+    G4bool rejectIn = packed & ((w > dirTolerance) | (dfs > kCarTolerance)
+                    | (crossing & (dfs <= -kCarToleranceHalf) & outside));
+    pass[k] = ((outgoing & !rejectOut) | (ingoing & !rejectIn)) ? 1.0 : 0.0;
+  }
+
+  const vector<G4int>& items = fBVH->GetItems();
+  G4int n = 0;
+  for (G4int k = 0; k < count; ++k)
+  {
+    if (pass[k] != 0.0) candidates[n++] = items[first + k];
+  }
+  return n;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Distance along v to the solid for BVH acceleration: the leaves are
+// visited nearest first, with the selection of DistanceToInCandidates(),
+// until they are farther than the nearest intersection.
+//
+G4double
+G4TessellatedSolid::DistanceToInBVH(const G4ThreeVector& aPoint,
+                                    const G4ThreeVector& aDirection) const
+{
+  G4ThreeVector direction = aDirection.unit();
+  G4double dist            = 0.0;
+  G4double distFromSurface = 0.0;
+  G4ThreeVector normal;
+
+  G4double minDistance = kInfinity;
+  G4double tMax = kInfinity;
+  G4bool onSurface = false;
+  G4int candidates[kBVHLeafSize];
+
+  fBVH->TraverseRayLeaves(aPoint, direction, tMax,
+                          [&](G4int first, G4int count)
+  {
+    for (G4int i = first; i < first + count && !onSurface; i += kBVHLeafSize)
+    {
+      G4int limit = SelectCandidates(i, std::min(kBVHLeafSize, first+count-i),
+                                     aPoint, direction, false, true,
+                                     candidates);
+      for (G4int j = 0; j < limit; ++j)
+      {
+        G4VFacet& facet = *fFacets[candidates[j]];
+        if (!facet.Intersect(aPoint,direction,false,dist,distFromSurface,
+                             normal)) continue;
+        if ( (distFromSurface > kCarToleranceHalf)
+          && (dist >= 0.0) && (dist < minDistance))
+        {
+          minDistance = dist;
+        }
+        else if (-kCarToleranceHalf <= dist && dist <= kCarToleranceHalf)
+        {
+          onSurface = true;
+          break;
+        }
+        else if (distFromSurface > -kCarToleranceHalf
+              && distFromSurface <  kCarToleranceHalf)
+        {
+          minDistance = dist;
+        }
+      }
+    }
+    tMax = onSurface ? -1.0 : std::max(minDistance, 0.0) + kCarTolerance;
+  });
+
+  return onSurface ? 0.0 : minDistance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Distance along v out of the solid for BVH acceleration, with the
+// selection of DistanceToOutCandidates().
+//
+G4double
+G4TessellatedSolid::DistanceToOutBVH(const G4ThreeVector& aPoint,
+                                     const G4ThreeVector& aDirection,
+                                           G4ThreeVector& aNormalVector,
+                                           G4bool& aConvex) const
+{
+  G4ThreeVector direction = aDirection.unit();
+  G4double dist            = 0.0;
+  G4double distFromSurface = 0.0;
+  G4ThreeVector normal;
+
+  G4double minDistance = kInfinity;
+  G4double tMax = kInfinity;
+  G4int minCandidate = -1;
+  G4bool onSurface = false;
+  G4int candidates[kBVHLeafSize];
+
+  fBVH->TraverseRayLeaves(aPoint, direction, tMax,
+                          [&](G4int first, G4int count)
+  {
+    for (G4int i = first; i < first + count && !onSurface; i += kBVHLeafSize)
+    {
+      G4int limit = SelectCandidates(i, std::min(kBVHLeafSize, first+count-i),
+                                     aPoint, direction, true, false,
+                                     candidates);
+      for (G4int j = 0; j < limit; ++j)
+      {
+        G4int candidate = candidates[j];
+        G4VFacet& facet = *fFacets[candidate];
+        if (!facet.Intersect(aPoint,direction,true,dist,distFromSurface,
+                             normal)) continue;
+        if (distFromSurface > 0.0 && distFromSurface <= kCarToleranceHalf
+         && facet.Distance(aPoint,kCarTolerance) <= kCarToleranceHalf)
+        {
+          // We are on a surface
+          //
+          minDistance = 0.0;
+          aNormalVector = normal;
+          minCandidate = candidate;
+          onSurface = true;
+          break;
+        }
+        if (dist >= 0.0 && dist < minDistance)
+        {
+          minDistance = dist;
+          aNormalVector = normal;
+          minCandidate = candidate;
+        }
+      }
+    }
+    tMax = onSurface ? -1.0 : minDistance + kCarTolerance;
+  });
+
+  if (minCandidate < 0)
+  {
+    // No intersection found
+    minDistance = 0.;
+    aConvex = false;
+    Normal(aPoint, aNormalVector);
+  }
+  else
+  {
+    aConvex = (fExtremeFacets.find(fFacets[minCandidate])
+            != fExtremeFacets.end());
+  }
+  return minDistance;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Distance to the nearest facet for BVH acceleration; minCandidate is set
+// to its index, -1 if none is found.
+//
+G4double
+G4TessellatedSolid::MinDistanceFacetBVH(const G4ThreeVector& p,
+                                              G4int& minCandidate) const
+{
+  G4double minDist = kInfinity;
+  minCandidate = -1;
+  fBVH->TraverseDistance(p, minDist, [&](G4int i)
+  {
+    G4double dist = fFacets[i]->Distance(p, minDist);
+    if (dist < minDist)
+    {
+      minDist = dist;
+      minCandidate = i;
+    }
+  });
+  return minDist;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // Compute extremeFacets, i.e. find those facets that have surface
@@ -609,10 +912,20 @@ void G4TessellatedSolid::SetSolidClosed (const G4bool t)
 #endif
     SetExtremeFacets();
 
+    if (fUseBVH)
+    {
+#ifdef G4SPECSDEBUG
+      G4cout << "Building BVH..." << G4endl;
+#endif
+      BuildBVH();
+    }
+    else
+    {
 #ifdef G4SPECSDEBUG
-    G4cout << "Voxelizing..." << G4endl;
+      G4cout << "Voxelizing..." << G4endl;
 #endif
-    Voxelize();
+      Voxelize();
+    }
 
 #ifdef G4SPECSDEBUG
     DisplayAllocatedMemory();
@@ -954,6 +1267,122 @@ EInside G4TessellatedSolid::InsideVoxels(const G4ThreeVector& p) const
   return location;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// Inside for BVH acceleration: as in InsideVoxels(), the point is on the
+// surface if a facet is within tolerance, otherwise the nearest crossings
+// entering and leaving are compared along a ray. Only the leaves up to the
+// nearest crossing are visited.
+//
+EInside G4TessellatedSolid::InsideBVH(const G4ThreeVector& p) const
+{
+  if (OutsideOfExtent(p, kCarTolerance))
+    return kOutside;
+
+  G4bool onSurface = false;
+  G4double safety = kCarTolerance;
+  fBVH->TraverseDistance(p, safety, [&](G4int i)
+  {
+    if (onSurface) return;
+    if (fFacets[i]->Distance(p,kCarTolerance) <= kCarToleranceHalf)
+    {
+      onSurface = true;
+      safety = 0.0;
+    }
+  });
+  if (onSurface) return kSurface;
+
+  const G4double dirTolerance = 1.0E-14;
+
+  G4double distOut          = kInfinity;
+  G4double distIn           = kInfinity;
+  G4double distO            = 0.0;
+  G4double distI            = 0.0;
+  G4double distFromSurfaceO = 0.0;
+  G4double distFromSurfaceI = 0.0;
+  G4ThreeVector normalO, normalI;
+  EInside location          = kOutside;
+  G4int sm                  = 0;
+  G4int candidates[kBVHLeafSize];
+
+  G4bool nearParallel = false;
+  do    // Loop checking, 13.08.2015, G.Cosmo
+  {
+    // Change direction if the ray is nearly parallel to a crossed facet
+    //
+    distOut = distIn = kInfinity;
+    nearParallel = false;
+    const G4ThreeVector& v = fRandir[sm];
+    ++sm;
+
+    G4double tMax = kInfinity;
+    fBVH->TraverseRayLeaves(p, v, tMax, [&](G4int first, G4int count)
+    {
+      for (G4int i = first; i < first + count && !nearParallel;
+           i += kBVHLeafSize)
+      {
+        G4int limit = SelectCandidates(i, std::min(kBVHLeafSize,first+count-i),
+                                       p, v, true, true, candidates);
+        for (G4int j = 0; j < limit; ++j)
+        {
+          G4VFacet& facet = *fFacets[candidates[j]];
+
+          G4bool crossingO =
+            facet.Intersect(p,v,true,distO,distFromSurfaceO,normalO);
+          G4bool crossingI =
+            facet.Intersect(p,v,false,distI,distFromSurfaceI,normalI);
+
+          if (crossingO || crossingI)
+          {
+            nearParallel = (crossingO
+                     && std::fabs(normalO.dot(v))<dirTolerance)
+                     || (crossingI && std::fabs(normalI.dot(v))<dirTolerance);
+            if (nearParallel) break;
+
+            if (crossingO && distO > 0.0 && distO < distOut)
+              distOut = distO;
+            if (crossingI && distI > 0.0 && distI < distIn)
+              distIn  = distI;
+          }
+        }
+      }
+      // Farther crossings cannot change the comparison below
+      //
+      tMax = nearParallel ? -1.0 : std::min(distOut,distIn) + kCarTolerance;
+    });
+  }
+  while (nearParallel && sm != fMaxTries);
+
+#ifdef G4VERBOSE
+  if (sm == fMaxTries)
+  {
+    std::ostringstream message;
+    G4int oldprc = message.precision(16);
+    message << "Cannot determine whether point is inside or outside volume!"
+      << G4endl
+      << "Solid name       = " << GetName()  << G4endl
+      << "Geometry Type    = " << fGeometryType  << G4endl
+      << "Number of facets = " << fFacets.size() << G4endl
+      << "Position:"  << G4endl << G4endl
+      << "p.x() = "   << p.x()/mm << " mm" << G4endl
+      << "p.y() = "   << p.y()/mm << " mm" << G4endl
+      << "p.z() = "   << p.z()/mm << " mm";
+    message.precision(oldprc);
+    G4Exception("G4TessellatedSolid::Inside()",
+                "GeomSolids1002", JustWarning, message);
+  }
+#endif
+
+  if (distIn == kInfinity && distOut == kInfinity)
+    location = kOutside;
+  else if (distIn <= distOut - kCarToleranceHalf)
+    location = kOutside;
+  else if (distOut <= distIn - kCarToleranceHalf)
+    location = kInside;
+
+  return location;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 EInside G4TessellatedSolid::InsideNoVoxels (const G4ThreeVector &p) const
@@ -1106,7 +1535,11 @@ G4int G4TessellatedSolid::GetFacetIndex (const G4ThreeVector& p) const
 {
   G4int index = -1;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (fBVH)
+  {
+    MinDistanceFacetBVH(p, index);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     vector<G4int> curVoxel(3);
     fVoxels.GetVoxel(curVoxel, p);
@@ -1157,7 +1590,13 @@ G4bool G4TessellatedSolid::Normal (const G4ThreeVector& p,
   G4double minDist;
   G4VFacet* facet = nullptr;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (fBVH)
+  {
+    G4int candidate;
+    minDist = MinDistanceFacetBVH(p, candidate);
+    if (candidate >= 0) facet = fFacets[candidate];
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     vector<G4int> curVoxel(3);
     fVoxels.GetVoxel(curVoxel, p);
@@ -1415,7 +1854,11 @@ G4TessellatedSolid::DistanceToOutCore(const G4ThreeVector& aPoint,
 {
   G4double minDistance;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (fBVH)
+  {
+    minDistance = DistanceToOutBVH(aPoint, aDirection, aNormalVector, aConvex);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     minDistance = kInfinity;
 
@@ -1534,7 +1977,11 @@ G4TessellatedSolid::DistanceToInCore(const G4ThreeVector& aPoint,
 {
   G4double minDistance;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (fBVH)
+  {
+    minDistance = DistanceToInBVH(aPoint, aDirection);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     minDistance = kInfinity;
     G4ThreeVector currentPoint = aPoint;
@@ -1664,7 +2111,15 @@ G4double G4TessellatedSolid::SafetyFromOutside (const G4ThreeVector& p,
 
   G4double minDist;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (fBVH)
+  {
+    if (!aAccurate)
+      return G4Voxelizer::MinDistanceToBox(p - 0.5*(fMinExtent + fMaxExtent),
+                                           0.5*(fMaxExtent - fMinExtent));
+    G4int candidate;
+    minDist = MinDistanceFacetBVH(p, candidate);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     if (!aAccurate)
       return fVoxels.DistanceToBoundingBox(p);
@@ -1724,7 +2179,12 @@ G4TessellatedSolid::SafetyFromInside (const G4ThreeVector& p, G4bool) const
 
   if (OutsideOfExtent(p, kCarTolerance)) return 0.0;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (fBVH)
+  {
+    G4int candidate;
+    minDist = MinDistanceFacetBVH(p, candidate);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     G4VFacet* facet;
     minDist = MinDistanceFacet(p, true, facet);
@@ -1799,7 +2259,11 @@ EInside G4TessellatedSolid::Inside (const G4ThreeVector& aPoint) const
 {
   EInside location;
 
-  if (fVoxels.GetCountOfVoxels() > 1)
+  if (fBVH)
+  {
+    location = InsideBVH(aPoint);
+  }
+  else if (fVoxels.GetCountOfVoxels() > 1)
   {
     location = InsideVoxels(aPoint);
   }
@@ -2251,6 +2715,11 @@ G4int G4TessellatedSolid::AllocatedMemory()
   G4int sizeInsides = fInsides.GetNbytes();
   G4int sizeVoxels = fVoxels.AllocatedMemory();
   size += sizeInsides + sizeVoxels;
+  if (fBVH)
+  {
+    size += sizeof(G4BoundingVolumeHierarchy) + fBVH->AllocatedMemory();
+    size += fPackedFacets.capacity() * sizeof(G4double);
+  }
   return size;
 }
 
@@ -35,6 +35,7 @@
 
 // History:
 //
+// 17.10.26 - added G4SplitMix64, G4DeriveSeeds
 // 24.08.17 - E.Tcherniaev, added G4RandomRadiusInRing, G4RandomPointInEllipse
 //                          G4RandomPointOnEllipse, G4RandomPointOnEllipsoid
 // 07.11.08 - P.Gumplinger, based on implementation in G4OpBoundaryProcess
@@ -46,6 +47,8 @@
 
 #include <CLHEP/Units/PhysicalConstants.h>
 
+#include <cstdint>
+
 #include "G4RandomDirection.hh"
 #include "G4ThreeVector.hh"
 #include "G4TwoVector.hh"
@@ -175,4 +178,31 @@ inline G4ThreeVector G4RandomPointOnEllipsoid(G4double a, G4double b,
   return G4ThreeVector(A * p.x(), B * p.y(), C * p.z());
 }
 
+// ---------------------------------------------------------------------------
+// Returns the SplitMix64 hash of a 64-bit value: consecutive inputs give
+// uncorrelated outputs
+//
+inline std::uint64_t G4SplitMix64(std::uint64_t z)
+{
+  z += 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+// ---------------------------------------------------------------------------
+// Fills n seeds derived from a key, without using the random engine.
+// The seeds are in the range of those drawn by the run managers
+// (0 to 10^8), e.g. to seed an event from its run seeds and event ID
+//
+inline void G4DeriveSeeds(std::uint64_t key, G4int n, G4long* seeds)
+{
+  for(G4int i = 0; i < n; ++i)
+  {
+    G4double rndm = G4double(G4SplitMix64(key + i) >> 11)
+                    / 9007199254740992.;  // 2^53
+    seeds[i] = (G4long) (100000000L * rndm);
+  }
+}
+
 #endif /* G4RANDOMTOOLS_HH */
@@ -74,6 +74,11 @@ class G4Allocator : public G4AllocatorBase
   // Returns allocated storage to the free store, resets allocator.
   // Note: contents in memory are lost using this call !
 
+  inline void TakeOverStorage(G4Allocator<Type>& right);
+  // Takes over the storage of another allocator, which is left empty.
+  // Objects allocated by 'right' are then to be freed to this allocator.
+  // Used to pass objects built on a helper thread to another thread.
+
   inline std::size_t GetAllocatedSize() const;
   // Returns the size of the total memory allocated
   inline int GetNoPages() const;
@@ -222,6 +227,16 @@ void G4Allocator<Type>::ResetStorage()
   return;
 }
 
+// ************************************************************
+// TakeOverStorage
+// ************************************************************
+//
+template <class Type>
+void G4Allocator<Type>::TakeOverStorage(G4Allocator<Type>& right)
+{
+  mem.Absorb(right.mem);
+}
+
 // ************************************************************
 // GetAllocatedSize
 // ************************************************************
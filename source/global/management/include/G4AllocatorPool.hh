@@ -63,6 +63,10 @@ class G4AllocatorPool
   // Return storage size
   void Reset();
   // Return storage to the free store
+  void Absorb(G4AllocatorPool& right);
+  // Take over the pages and free elements of another pool of elements of
+  // the same size, which is left empty. Elements allocated from it can
+  // then be freed to this pool, which releases them at its destruction
 
   inline int GetNoPages() const;
   // Return the total number of allocated pages
@@ -0,0 +1,180 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4EventArena
+//
+// Class description:
+//
+// Thread-local arena for objects whose lifetime is bound to a single
+// event (G4Track, G4DynamicParticle). Memory is carved out of large
+// blocks of one size, each aligned to its size. Deallocated objects are
+// kept in free lists, one per allocation size, and reused by the
+// following allocations of the same event, so that the memory in use
+// follows the number of objects alive rather than the number created.
+// The whole arena is rewound at once by Reset() at the end of the event.
+// Blocks are kept and reused by the following events, so that after the
+// first few events no system allocation takes place at all.
+// Because of the alignment of the blocks, Contains() masks the address
+// and makes one hash lookup, whatever the number of blocks.
+// The arena is owned and activated by G4EventManager; the allocators of
+// the client classes query Instance() and fall back to their G4Allocator
+// pools when no arena is active. Objects allocated in the arena must not
+// be kept beyond the end of the event.
+
+// --------------------------------------------------------------------
+#ifndef G4EventArena_hh
+#define G4EventArena_hh 1
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "G4Types.hh"
+
+class G4EventArena
+{
+  public:
+
+    explicit G4EventArena(std::size_t blockSize = 1048576);
+      // Create the arena and register it as the one of the current thread.
+      // The block size is rounded up to a power of two
+    ~G4EventArena();
+      // Return all blocks to the free store
+
+    G4EventArena(const G4EventArena&) = delete;
+    G4EventArena& operator=(const G4EventArena&) = delete;
+
+    static G4EventArena*& Instance();
+      // Arena of the current thread, nullptr if none
+
+    inline void* Allocate(std::size_t n);
+      // Allocate n bytes, aligned to fAlignment. n must not exceed
+      // GetMaxAllocationSize()
+    inline void Deallocate(void* p, std::size_t n);
+      // Give back an allocation of n bytes made by this arena, for reuse
+      // by the following allocations of the same size
+    inline G4bool Contains(const void* p) const;
+      // True if p points inside one of the blocks of the arena
+
+    void Reset();
+      // Release all allocations at once, keeping the blocks
+
+    inline void SetActive(G4bool val) { fActive = val; }
+    inline G4bool IsActive() const { return fActive; }
+
+    static constexpr std::size_t GetMaxAllocationSize()
+      { return fAlignment * fNSizeClasses; }
+
+    // Statistics
+    inline std::size_t GetNumberOfAllocations() const { return fNAlloc; }
+      // Allocations since the last Reset()
+    inline std::size_t GetTotalNumberOfAllocations() const
+      { return fNAllocTotal + fNAlloc; }
+    inline std::size_t GetNumberOfReuses() const { return fNReuse; }
+      // Allocations served from the free lists since the last Reset()
+    inline std::size_t GetBytesInUse() const { return fUsed + fOffset; }
+      // Bytes carved out of the blocks since the last Reset()
+    inline std::size_t GetPeakBytes() const { return fPeak; }
+      // Largest value of GetBytesInUse() at any Reset()
+    inline std::size_t GetReservedBytes() const { return fReserved; }
+    inline std::size_t GetNumberOfBlockAllocations() const
+      { return fNBlockAlloc; }
+    inline std::size_t GetNumberOfResets() const { return fNReset; }
+
+  private:
+
+    void* Grow(std::size_t n);
+      // Move to the next block, allocating it if needed
+
+  private:
+
+    static constexpr std::size_t fAlignment = 16;
+    static constexpr std::size_t fNSizeClasses = 64;
+
+    std::vector<char*> fBlocks;
+    std::unordered_set<std::uintptr_t> fBlockSet;
+    std::uintptr_t fBlockMask;
+    std::array<void*, fNSizeClasses> fFree{};
+      // Heads of the free lists, indexed by size / fAlignment - 1; the
+      // link to the next entry is stored in the freed object
+    std::size_t fCurrent = 0;     // index of the block in use
+    char* fHead = nullptr;        // start of the block in use
+    std::size_t fOffset = 0;      // bytes used in the block in use
+    std::size_t fUsed = 0;        // bytes used in the previous blocks
+    std::size_t fBlockSize;
+
+    std::size_t fNAlloc = 0;
+    std::size_t fNAllocTotal = 0;
+    std::size_t fNReuse = 0;
+    std::size_t fPeak = 0;
+    std::size_t fReserved = 0;
+    std::size_t fNBlockAlloc = 0;
+    std::size_t fNReset = 0;
+
+    G4bool fActive = false;
+};
+
+// ------------------------------------------------------------------------
+// Inline methods
+// ------------------------------------------------------------------------
+
+inline void* G4EventArena::Allocate(std::size_t n)
+{
+  n = (n + fAlignment - 1) & ~(fAlignment - 1);
+  ++fNAlloc;
+  void*& head = fFree[n / fAlignment - 1];
+  if(head != nullptr)
+  {
+    void* p = head;
+    head = *static_cast<void**>(p);
+    ++fNReuse;
+    return p;
+  }
+  if(fHead != nullptr && fOffset + n <= fBlockSize)
+  {
+    void* p = fHead + fOffset;
+    fOffset += n;
+    return p;
+  }
+  return Grow(n);
+}
+
+inline void G4EventArena::Deallocate(void* p, std::size_t n)
+{
+  n = (n + fAlignment - 1) & ~(fAlignment - 1);
+  void*& head = fFree[n / fAlignment - 1];
+  *static_cast<void**>(p) = head;
+  head = p;
+}
+
+inline G4bool G4EventArena::Contains(const void* p) const
+{
+  return !fBlockSet.empty()
+    && fBlockSet.count(reinterpret_cast<std::uintptr_t>(p) & fBlockMask) > 0;
+}
+
+#endif
@@ -0,0 +1,92 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4PhysicsTableReplicas
+//
+// Class description:
+//
+// Thread-safe registry of copies of the read-only physics tables shared
+// by the worker threads, one copy per NUMA node. A worker which gets its
+// tables from the master thread can ask for the copy of a table local
+// to the NUMA node it runs on. The copy is made by the first worker of
+// the node asking for it, so that its memory is allocated on that node.
+// The node of the master thread uses the original tables.
+// Vectors are copied with their dynamic type; vectors of types other
+// than those provided by Geant4 are not copied, the original is used.
+// Copies are owned by the registry and are deleted by Clear(), which must
+// be invoked when the tables of the master are rebuilt. Replication is
+// active only if enabled and if more than one NUMA node exists; otherwise
+// the original table is returned.
+// --------------------------------------------------------------------
+#ifndef G4PhysicsTableReplicas_hh
+#define G4PhysicsTableReplicas_hh 1
+
+#include "G4PhysicsTable.hh"
+#include "G4Threading.hh"
+#include "globals.hh"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+class G4PhysicsTableReplicas
+{
+ public:
+  static G4PhysicsTableReplicas* Instance();
+
+  ~G4PhysicsTableReplicas();
+
+  G4PhysicsTableReplicas(const G4PhysicsTableReplicas&) = delete;
+  G4PhysicsTableReplicas& operator=(const G4PhysicsTableReplicas&) = delete;
+
+  void SetEnabled(G4bool val);
+  // Enable/disable replication; the calling thread is taken as the one
+  // which has allocated the original tables
+  inline G4bool IsEnabled() const { return enabled; }
+
+  G4PhysicsTable* GetReplica(G4PhysicsTable* table);
+  // Returns the copy of 'table' local to the NUMA node of the calling
+  // thread, creating it if needed
+
+  void Clear();
+  // Deletes all copies
+
+  void Report(std::ostream& out) const;
+  // Prints number of copies and their memory cost per NUMA node
+
+ private:
+  G4PhysicsTableReplicas() = default;
+
+  G4bool enabled = false;
+  G4int homeNode = 0;
+  std::map<std::pair<const G4PhysicsTable*, G4int>, G4PhysicsTable*> tables;
+  std::map<std::pair<const G4PhysicsVector*, G4int>, G4PhysicsVector*> vectors;
+  // Copies keyed by original and NUMA node; vectors shared between
+  // tables stay shared in the copies
+  std::vector<std::size_t> bytesPerNode;
+  mutable G4Mutex mutex;
+};
+
+#endif
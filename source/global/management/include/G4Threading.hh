@@ -304,6 +304,10 @@ namespace G4Threading
   G4bool IsMasterThread();
   void G4SetThreadId(G4int aNewValue);
   G4bool G4SetPinAffinity(G4int idx, G4NativeThread& at);
+  // NUMA topology (Linux only, a single node is reported elsewhere)
+  G4int G4GetNumberOfNumaNodes();
+  G4int G4GetNumaNode();  // node of the CPU running the calling thread
+  G4bool G4SetNumaAffinity(G4int node, G4NativeThread& at);
   void SetMultithreadedApplication(G4bool value);
   G4bool IsMultithreadedApplication();
   G4int WorkerThreadLeavesPool();
@@ -94,6 +94,46 @@ void G4AllocatorPool::Reset()
   nchunks = 0;
 }
 
+// ************************************************************
+// Absorb
+// ************************************************************
+//
+void G4AllocatorPool::Absorb(G4AllocatorPool& right)
+{
+  if(&right == this || right.chunks == nullptr)
+  {
+    return;
+  }
+
+  // Append the chunks of 'right' to the list of chunks
+  //
+  G4PoolChunk* c = right.chunks;
+  while(c->next)
+  {
+    c = c->next;
+  }
+  c->next = chunks;
+  chunks  = right.chunks;
+  nchunks += right.nchunks;
+
+  // Put the free elements of 'right' in front of the free list
+  //
+  if(right.head)
+  {
+    G4PoolLink* p = right.head;
+    while(p->next)
+    {
+      p = p->next;
+    }
+    p->next = head;
+    head    = right.head;
+  }
+
+  right.chunks  = nullptr;
+  right.head    = nullptr;
+  right.nchunks = 0;
+}
+
 // ************************************************************
 // Grow
 // ************************************************************
@@ -0,0 +1,110 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4EventArena implementation
+//
+// --------------------------------------------------------------------
+
+#include "G4EventArena.hh"
+#include "G4Threading.hh"
+#include "globals.hh"
+
+#include <new>
+
+// --------------------------------------------------------------------
+G4EventArena*& G4EventArena::Instance()
+{
+  G4ThreadLocalStatic G4EventArena* _instance = nullptr;
+  return _instance;
+}
+
+// --------------------------------------------------------------------
+G4EventArena::G4EventArena(std::size_t blockSize)
+  : fBlockSize(4096)
+{
+  while(fBlockSize < blockSize) { fBlockSize *= 2; }
+  fBlockMask = ~(std::uintptr_t(fBlockSize) - 1);
+  Instance() = this;
+}
+
+// --------------------------------------------------------------------
+G4EventArena::~G4EventArena()
+{
+  for(auto block : fBlocks)
+  {
+    ::operator delete(block, std::align_val_t(fBlockSize));
+  }
+  if(Instance() == this) { Instance() = nullptr; }
+}
+
+// --------------------------------------------------------------------
+void G4EventArena::Reset()
+{
+  std::size_t inUse = fUsed + fOffset;
+  if(inUse > fPeak) { fPeak = inUse; }
+  fNAllocTotal += fNAlloc;
+  fNAlloc = 0;
+  fNReuse = 0;
+  ++fNReset;
+  fFree.fill(nullptr);
+
+  fCurrent = 0;
+  fUsed = 0;
+  fOffset = 0;
+  fHead = fBlocks.empty() ? nullptr : fBlocks[0];
+}
+
+// --------------------------------------------------------------------
+void* G4EventArena::Grow(std::size_t n)
+{
+  if(n > GetMaxAllocationSize())
+  {
+    G4ExceptionDescription ed;
+    ed << "Allocation of " << n << " bytes, the maximum is "
+       << GetMaxAllocationSize() << ".";
+    G4Exception("G4EventArena::Allocate()", "EventArena001",
+                FatalException, ed);
+    return nullptr;
+  }
+
+  // Blocks left over from previous events are reused first
+  if(fHead != nullptr)
+  {
+    fUsed += fOffset;
+    ++fCurrent;
+  }
+  if(fCurrent == fBlocks.size())
+  {
+    auto data = static_cast<char*>(
+      ::operator new(fBlockSize, std::align_val_t(fBlockSize)));
+    fBlocks.push_back(data);
+    fBlockSet.insert(reinterpret_cast<std::uintptr_t>(data));
+    fReserved += fBlockSize;
+    ++fNBlockAlloc;
+  }
+  fHead = fBlocks[fCurrent];
+  fOffset = n;
+  return fHead;
+}
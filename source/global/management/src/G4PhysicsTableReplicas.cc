@@ -0,0 +1,160 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4PhysicsTableReplicas class implementation
+// --------------------------------------------------------------------
+
+#include "G4PhysicsTableReplicas.hh"
+#include "G4AutoLock.hh"
+#include "G4PhysicsFreeVector.hh"
+#include "G4PhysicsLinearVector.hh"
+#include "G4PhysicsLogVector.hh"
+
+#include <typeinfo>
+
+namespace
+{
+  // Copy of a vector with the same dynamic type, or null if the vector
+  // is not of one of the types provided by Geant4
+  //
+  template <class T>
+  G4PhysicsVector* CloneAs(const G4PhysicsVector* vec)
+  {
+    if(typeid(*vec) != typeid(T))
+      return nullptr;
+    return new T(static_cast<const T&>(*vec));
+  }
+
+  G4PhysicsVector* CloneVector(const G4PhysicsVector* vec)
+  {
+    switch(vec->GetType())
+    {
+      case T_G4PhysicsLogVector:
+        return CloneAs<G4PhysicsLogVector>(vec);
+      case T_G4PhysicsLinearVector:
+        return CloneAs<G4PhysicsLinearVector>(vec);
+      case T_G4PhysicsFreeVector:
+      {
+        G4PhysicsVector* vcopy = CloneAs<G4PhysicsFreeVector>(vec);
+        return (vcopy != nullptr) ? vcopy : CloneAs<G4PhysicsVector>(vec);
+      }
+    }
+    return nullptr;
+  }
+}
+
+G4PhysicsTableReplicas* G4PhysicsTableReplicas::Instance()
+{
+  static G4PhysicsTableReplicas theInstance;
+  return &theInstance;
+}
+
+G4PhysicsTableReplicas::~G4PhysicsTableReplicas()
+{
+  Clear();
+}
+
+void G4PhysicsTableReplicas::SetEnabled(G4bool val)
+{
+  G4AutoLock l(&mutex);
+  enabled = val && (G4Threading::G4GetNumberOfNumaNodes() > 1);
+  homeNode = G4Threading::G4GetNumaNode();
+}
+
+G4PhysicsTable* G4PhysicsTableReplicas::GetReplica(G4PhysicsTable* table)
+{
+  if(!enabled || table == nullptr)
+    return table;
+  G4int node = G4Threading::G4GetNumaNode();
+  if(node == homeNode)
+    return table;
+
+  G4AutoLock l(&mutex);
+  G4PhysicsTable*& replica = tables[std::make_pair(table, node)];
+  if(replica != nullptr)
+    return replica;
+
+  if(bytesPerNode.size() <= std::size_t(node))
+    bytesPerNode.resize(node + 1, 0);
+  replica = new G4PhysicsTable(table->size());
+  bytesPerNode[node] += sizeof(G4PhysicsTable)
+                        + table->size() * sizeof(G4PhysicsVector*);
+  for(auto vec : *table)
+  {
+    if(vec == nullptr)
+    {
+      replica->push_back(nullptr);
+      continue;
+    }
+    auto key = std::make_pair(vec, node);
+    auto itr = vectors.find(key);
+    if(itr != vectors.end())
+    {
+      replica->push_back(itr->second);
+      continue;
+    }
+    G4PhysicsVector* vcopy = CloneVector(vec);
+    if(vcopy == nullptr)
+    {
+      // Vector of a user-defined type: the original is shared
+      replica->push_back(vec);
+      continue;
+    }
+    vectors[key] = vcopy;
+    std::size_t n = vec->GetVectorLength();
+    bytesPerNode[node] += sizeof(G4PhysicsVector)
+                          + n * sizeof(G4double) * (vec->GetSpline() ? 3 : 2);
+    replica->push_back(vcopy);
+  }
+  return replica;
+}
+
+void G4PhysicsTableReplicas::Clear()
+{
+  G4AutoLock l(&mutex);
+  for(auto& itr : tables)
+    delete itr.second;
+  for(auto& itr : vectors)
+    delete itr.second;
+  tables.clear();
+  vectors.clear();
+  bytesPerNode.clear();
+}
+
+void G4PhysicsTableReplicas::Report(std::ostream& out) const
+{
+  G4AutoLock l(&mutex);
+  out << "G4PhysicsTableReplicas: " << tables.size() << " tables and "
+      << vectors.size() << " vectors replicated over "
+      << G4Threading::G4GetNumberOfNumaNodes() << " NUMA nodes (home node "
+      << homeNode << ")" << G4endl;
+  for(std::size_t node = 0; node < bytesPerNode.size(); ++node)
+  {
+    if(bytesPerNode[node] == 0)
+      continue;
+    out << "   node " << node << " : " << bytesPerNode[node] / 1024
+        << " kB" << G4endl;
+  }
+}
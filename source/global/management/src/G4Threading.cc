@@ -45,6 +45,9 @@
 #if defined(G4MULTITHREADED)
 
 #  include <atomic>
+#  include <fstream>
+#  include <sstream>
+#  include <vector>
 
 namespace
 {
@@ -88,6 +91,82 @@ G4bool G4Threading::G4SetPinAffinity(G4int, G4NativeThread&)
 }
 #  endif
 
+#  if defined(__linux__)
+namespace
+{
+  // CPUs of a NUMA node, from its cpulist in sysfs, e.g. "0-15,64-79"
+  std::vector<G4int> NumaNodeCpus(G4int node)
+  {
+    std::vector<G4int> cpus;
+    std::ostringstream fname;
+    fname << "/sys/devices/system/node/node" << node << "/cpulist";
+    std::ifstream in(fname.str());
+    std::string range;
+    while(std::getline(in, range, ','))
+    {
+      G4int first = 0, last = -1;
+      char dash   = 0;
+      std::istringstream is(range);
+      is >> first;
+      if(is >> dash >> last)
+        for(G4int i = first; i <= last; ++i)
+          cpus.push_back(i);
+      else
+        cpus.push_back(first);
+    }
+    return cpus;
+  }
+}  // namespace
+
+G4int G4Threading::G4GetNumberOfNumaNodes()
+{
+  static const G4int nNodes = [] {
+    G4int n = 0;
+    while(!NumaNodeCpus(n).empty())
+      ++n;
+    return (n > 0) ? n : 1;
+  }();
+  return nNodes;
+}
+
+G4int G4Threading::G4GetNumaNode()
+{
+  G4int cpu    = sched_getcpu();
+  G4int nNodes = G4GetNumberOfNumaNodes();
+  for(G4int node = 0; cpu >= 0 && node < nNodes && nNodes > 1; ++node)
+  {
+    for(auto i : NumaNodeCpus(node))
+      if(i == cpu)
+        return node;
+  }
+  return 0;
+}
+
+G4bool G4Threading::G4SetNumaAffinity(G4int node, G4NativeThread& aT)
+{
+  std::vector<G4int> cpus = NumaNodeCpus(node % G4GetNumberOfNumaNodes());
+  if(cpus.empty())
+    return false;
+  cpu_set_t aset;
+  CPU_ZERO(&aset);
+  for(auto cpu : cpus)
+    CPU_SET(cpu, &aset);
+  pthread_t& _aT = (pthread_t&) (aT);
+  return (pthread_setaffinity_np(_aT, sizeof(cpu_set_t), &aset) == 0);
+}
+#  else
+G4int G4Threading::G4GetNumberOfNumaNodes() { return 1; }
+G4int G4Threading::G4GetNumaNode() { return 0; }
+G4bool G4Threading::G4SetNumaAffinity(G4int, G4NativeThread&)
+{
+  G4Exception("G4Threading::G4SetNumaAffinity()", "NotImplemented",
+              JustWarning,
+              "NUMA affinity not available for this architecture, "
+              "ignoring...");
+  return true;
+}
+#  endif
+
 void G4Threading::SetMultithreadedApplication(G4bool value)
 {
   isMTAppType = value;
@@ -125,6 +204,9 @@ G4bool G4Threading::IsMasterThread() { return true; }
 void G4Threading::G4SetThreadId(G4int) {}
 
 G4bool G4Threading::G4SetPinAffinity(G4int, G4NativeThread&) { return true; }
+G4int G4Threading::G4GetNumberOfNumaNodes() { return 1; }
+G4int G4Threading::G4GetNumaNode() { return 0; }
+G4bool G4Threading::G4SetNumaAffinity(G4int, G4NativeThread&) { return true; }
 
 void G4Threading::SetMultithreadedApplication(G4bool) {}
 G4bool G4Threading::IsMultithreadedApplication() { return false; }
@@ -51,6 +51,7 @@
 
 #include "G4ParticleDefinition.hh"
 #include "G4Allocator.hh"
+#include "G4EventArena.hh"
 #include "G4LorentzVector.hh"
 #include "G4Log.hh"
 
@@ -0,0 +1,110 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4ElectronTrackingManager
+//
+// Class description:
+//
+// Specialized tracking manager for e- and e+, used by the EM physics
+// constructors if G4EmParameters::ElectronTrackingManagerActive() is set
+// (/process/em/UseElectronTrackingManager true).
+// The processes are those assigned to the process managers of e- and e+
+// by the physics list, taken in the order of the process vectors, so
+// that the physics is the same as with G4SteppingManager. They are
+// invoked in one stepping loop, G4TrackingManagerHelper::
+// TrackChargedParticle(), instead of the generic loops over process
+// vectors:
+//  - the post-step limits are asked before the along-step ones, in the
+//    order of G4SteppingManager, so that the range used by multiple
+//    scattering is the one already looked up for the step by the
+//    ionisation process; there is no other sharing of table lookups;
+//  - the particle changes of energy loss, multiple scattering and
+//    discrete EM processes are applied directly by their concrete types,
+//    other processes go through the G4VParticleChange interface;
+//  - a step claimed by an ExclusivelyForced process (e.g. fast
+//    simulation) is handled as by G4SteppingManager: the track is not
+//    transported and only this process and the StronglyForced ones are
+//    invoked.
+// The macros electronTM.mac and electronTMref.mac of TestEm3 compare the
+// results with those of the generic stepping.
+// The process lists are set up in PreparePhysicsTable(): processes
+// activated or inactivated later are not taken into account, and
+// trajectories are not stored for tracks handled by this manager.
+// --------------------------------------------------------------------
+#ifndef G4ElectronTrackingManager_hh
+#define G4ElectronTrackingManager_hh 1
+
+#include "G4VTrackingManager.hh"
+#include "G4ForceCondition.hh"
+#include "globals.hh"
+
+#include <vector>
+
+class G4ParticleDefinition;
+class G4VProcess;
+
+class G4ElectronTrackingManager : public G4VTrackingManager
+{
+  public:
+
+    G4ElectronTrackingManager();
+   ~G4ElectronTrackingManager() override;
+
+    G4ElectronTrackingManager(const G4ElectronTrackingManager&) = delete;
+    G4ElectronTrackingManager&
+      operator=(const G4ElectronTrackingManager&) = delete;
+
+    void BuildPhysicsTable(const G4ParticleDefinition&) override;
+    void PreparePhysicsTable(const G4ParticleDefinition&) override;
+
+    void HandOverOneTrack(G4Track* aTrack) override;
+
+  private:
+
+    enum ChangeType { kGeneric, kLoss, kMsc, kGamma };
+      // Concrete type of the particle change of a process
+
+    struct ProcessList
+    {
+      std::vector<G4VProcess*> alongStep;  // DoIt order, no transportation
+      std::vector<ChangeType> alongType;
+      std::vector<G4VProcess*> postStep;   // DoIt order, no transportation
+      std::vector<ChangeType> postType;
+      std::vector<G4VProcess*> atRest;     // DoIt order
+      std::vector<G4ForceCondition> condition;  // of the current step
+      G4VProcess* transport = nullptr;
+    };
+
+    class ChargedPhysics;
+
+    ProcessList* GetProcessList(const G4ParticleDefinition*);
+
+  private:
+
+    ProcessList fElectron;
+    ProcessList fPositron;
+};
+
+#endif
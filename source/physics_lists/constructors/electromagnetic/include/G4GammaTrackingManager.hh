@@ -0,0 +1,102 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4GammaTrackingManager
+//
+// Class description:
+//
+// Specialized tracking manager for gamma, used by G4EmStandardPhysics
+// if G4EmParameters::GammaTrackingManagerActive() and
+// G4EmParameters::GeneralProcessActive() are both set
+// (/process/em/UseGammaTrackingManager true and
+// /process/em/UseGeneralProcess true). Without the general process,
+// the request is ignored with a warning.
+// All gamma interactions are provided by one G4GammaGeneralProcess, so
+// that the step length is sampled from a single combined macroscopic
+// cross section, which is looked up only when the energy or the
+// material changes. Gamma have no continuous process: there is no
+// AlongStep loop, and the particle change of the selected interaction
+// is applied without virtual dispatch. The step loop itself is
+// G4TrackingManagerHelper::TrackNeutralParticle().
+//
+// The physics is that of the general process with the same models, which
+// is not identical to that of separate photoelectric, Compton, conversion
+// and Rayleigh processes: the general process samples the interaction
+// from tabulated total and partial cross sections, while separate
+// processes each sample their own interaction length. Results agree
+// with G4EmStandardPhysics using the general process without this
+// tracking manager, not with the default configuration.
+// Gamma-nuclear and conversion to muons are included when
+// they are added to the general process by G4EmExtraPhysics.
+// Other processes assigned to the gamma process manager, apart from
+// transportation, are ignored, and trajectories are not stored for
+// gamma tracked by this manager.
+// --------------------------------------------------------------------
+#ifndef G4GammaTrackingManager_hh
+#define G4GammaTrackingManager_hh 1
+
+#include "G4VTrackingManager.hh"
+#include "globals.hh"
+
+class G4GammaGeneralProcess;
+class G4VProcess;
+
+class G4GammaTrackingManager : public G4VTrackingManager
+{
+  public:
+
+    explicit G4GammaTrackingManager(G4GammaGeneralProcess* proc);
+      // The process is not owned by the tracking manager
+   ~G4GammaTrackingManager() override;
+
+    G4GammaTrackingManager(const G4GammaTrackingManager&) = delete;
+    G4GammaTrackingManager& operator=(const G4GammaTrackingManager&) = delete;
+
+    void BuildPhysicsTable(const G4ParticleDefinition&) override;
+    void PreparePhysicsTable(const G4ParticleDefinition&) override;
+
+    void HandOverOneTrack(G4Track* aTrack) override;
+
+    inline G4GammaGeneralProcess* GetGeneralProcess() const;
+
+  private:
+
+    void CheckProcessManager(const G4ParticleDefinition&);
+      // Finds the transportation process, used to flag geometry
+      // limited steps, and warns about processes which are ignored
+
+  private:
+
+    G4GammaGeneralProcess* fProcess = nullptr;
+    G4VProcess* fTransport = nullptr;
+};
+
+inline G4GammaGeneralProcess*
+G4GammaTrackingManager::GetGeneralProcess() const
+{
+  return fProcess;
+}
+
+#endif
@@ -23,7 +23,7 @@
 // * acceptance of all terms of the Geant4 Software license.          *
 // ********************************************************************
 //
-// TrackingManagerHelper
+// G4TrackingManagerHelper
 //
 // Class description:
 //
@@ -34,8 +34,8 @@
 //
 // Original author: Jonas Hahnfeld, 2021
 
-#ifndef TrackingManagerHelper_hh
-#define TrackingManagerHelper_hh 1
+#ifndef G4TrackingManagerHelper_hh
+#define G4TrackingManagerHelper_hh 1
 
 #include "G4TrackVector.hh"
 #include "globals.hh"
@@ -43,7 +43,7 @@
 class G4Step;
 class G4Track;
 
-class TrackingManagerHelper
+class G4TrackingManagerHelper
 {
  public:
   class Physics
@@ -71,7 +71,7 @@ class TrackingManagerHelper
     virtual void PostStepDoIt(G4Track& track, G4Step& step,
                               G4TrackVector& secondaries) = 0;
 
-    virtual bool HasAtRestProcesses() { return false; }
+    virtual G4bool HasAtRestProcesses() { return false; }
 
     // This method is called when a track is stopped, but still alive. If
     // secondaries should be given back to the G4EventManager, put them into
@@ -103,8 +103,13 @@ class TrackingManagerHelper
 
   template <typename PhysicsImpl>
   static void TrackNeutralParticle(G4Track* aTrack, PhysicsImpl& physics);
+
+  // As in G4SteppingManager, a secondary without kinetic energy is kept,
+  // stopped but alive, only if it can be handled at rest. It returns
+  // false if the secondary should be deleted.
+  static G4bool AcceptSecondary(G4Track* secondary);
 };
 
-#include "TrackingManagerHelper.icc"
+#include "G4TrackingManagerHelper.icc"
 
 #endif
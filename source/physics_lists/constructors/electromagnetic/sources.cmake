@@ -36,8 +36,12 @@ geant4_add_module(G4phys_ctor_em
     G4EmStandardPhysics_option2.hh
     G4EmStandardPhysics_option3.hh
     G4EmStandardPhysics_option4.hh
+    G4ElectronTrackingManager.hh
     G4GammaGeneralProcess.hh
+    G4GammaTrackingManager.hh
     G4OpticalPhysics.hh
+    G4TrackingManagerHelper.hh
+    G4TrackingManagerHelper.icc
   SOURCES
     G4EmBuilder.cc
     G4EmDNAChemistry.cc
@@ -72,20 +76,30 @@ geant4_add_module(G4phys_ctor_em
     G4EmStandardPhysics_option2.cc
     G4EmStandardPhysics_option3.cc
     G4EmStandardPhysics_option4.cc
+    G4ElectronTrackingManager.cc
     G4GammaGeneralProcess.cc
+    G4GammaTrackingManager.cc
     G4OpticalPhysics.cc)
 
 geant4_module_link_libraries(G4phys_ctor_em
   PUBLIC
     G4decay
+    G4detector
     G4emdna-utils
     G4emutils
+    G4event
+    G4geometrymng
     G4globman
+    G4magneticfield
     G4materials
+    G4navigation
     G4partman
     G4procman
     G4run
+    G4track
+    G4tracking
     G4transportation
+    G4volumes
   PRIVATE
     G4baryons
     G4bosons
@@ -98,7 +112,6 @@ geant4_module_link_libraries(G4phys_ctor_em
     G4emhighenergy
     G4emlowenergy
     G4emstandard
-    G4geometrymng
     G4hadronic_mgt
     G4hadronic_util
     G4ions
@@ -109,5 +122,4 @@ geant4_module_link_libraries(G4phys_ctor_em
     G4phys_builders
     G4phys_ctor_factory
     G4physlist_util
-    G4track
     G4xrays)
@@ -0,0 +1,477 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4ElectronTrackingManager implementation
+// --------------------------------------------------------------------
+
+#include "G4ElectronTrackingManager.hh"
+#include "G4TrackingManagerHelper.hh"
+
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4ParticleChangeForGamma.hh"
+#include "G4ParticleChangeForLoss.hh"
+#include "G4ParticleChangeForMSC.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4VEmProcess.hh"
+#include "G4VEnergyLossProcess.hh"
+#include "G4VMultipleScattering.hh"
+
+// --------------------------------------------------------------------
+// Physics of e- or e+ for G4TrackingManagerHelper: the process lists are
+// used as G4SteppingManager uses the process vectors
+class G4ElectronTrackingManager::ChargedPhysics final
+  : public G4TrackingManagerHelper::Physics
+{
+  public:
+
+    ChargedPhysics(ProcessList& procs, G4ProcessManager* pm)
+      : fProcs(procs), fManager(pm), fCondition(procs.condition)
+    {}
+
+    void StartTracking(G4Track* aTrack) override
+    {
+      fManager->StartTracking(aTrack);
+      fPreviousStepLength = 0.0;
+    }
+
+    void EndTracking() override
+    {
+      fManager->EndTracking();
+    }
+
+    G4double GetPhysicalInteractionLength(const G4Track& track) override
+    {
+      fProposedStep = DBL_MAX;
+      fSelected = -1;
+      fDefinedBy = nullptr;
+      fExclusive = false;
+
+      // Post-step limits: the GPIL order is the inverse of the DoIt order.
+      // The discrete processes are asked first, so that the material and
+      // energy of the step are set up in ionisation before its
+      // along-step limit, and the range is then shared with MSC.
+      const auto& post = fProcs.postStep;
+      for(G4int i = G4int(post.size()) - 1; i >= 0; --i)
+      {
+        G4ForceCondition condition = NotForced;
+        G4double length =
+          post[i]->PostStepGPIL(track, fPreviousStepLength, &condition);
+        fCondition[i] = condition;
+        if(condition == ExclusivelyForced)
+        {
+          // As in G4SteppingManager: the step is left to this process
+          // alone, the track is not transported and the processes not yet
+          // asked are inactivated
+          for(G4int j = 0; j < i; ++j)
+          {
+            fCondition[j] = InActivated;
+          }
+          fExclusive = true;
+          fSelected = i;
+          fDefinedBy = post[i];
+          fProposedStep = 0.0;
+          return fProposedStep;
+        }
+        if(condition == NotForced && length < fProposedStep)
+        {
+          fProposedStep = length;
+          fSelected = i;
+          fDefinedBy = post[i];
+        }
+      }
+
+      G4double safety = DBL_MAX;
+      const auto& along = fProcs.alongStep;
+      for(G4int i = G4int(along.size()) - 1; i >= 0; --i)
+      {
+        G4GPILSelection selection = NotCandidateForSelection;
+        G4double length = along[i]->AlongStepGPIL(
+          track, fPreviousStepLength, fProposedStep, safety, &selection);
+        if(length < fProposedStep)
+        {
+          fProposedStep = length;
+          // MSC usually only converts the step length and does not win
+          if(selection == CandidateForSelection)
+          {
+            fSelected = -1;
+            fDefinedBy = along[i];
+          }
+        }
+      }
+      return fProposedStep;
+    }
+
+    void AlongStepDoIt(G4Track& track, G4Step& step,
+                       G4TrackVector& secondaries) override
+    {
+      G4StepPoint* postStepPoint = step.GetPostStepPoint();
+      if(fExclusive)
+      {
+        // no along-step process is invoked
+        postStepPoint->SetStepStatus(fExclusivelyForcedProc);
+        postStepPoint->SetProcessDefinedStep(fDefinedBy);
+        fPreviousStepLength = step.GetStepLength();
+        return;
+      }
+      if(step.GetStepLength() == fProposedStep)
+      {
+        postStepPoint->SetStepStatus(fSelected < 0 ? fAlongStepDoItProc
+                                                   : fPostStepDoItProc);
+        postStepPoint->SetProcessDefinedStep(fDefinedBy);
+      }
+      else
+      {
+        // the step was limited by geometry
+        fSelected = -1;
+        postStepPoint->SetProcessDefinedStep(fProcs.transport);
+      }
+
+      const auto& along = fProcs.alongStep;
+      for(std::size_t i = 0; i < along.size(); ++i)
+      {
+        G4VParticleChange* particleChange = along[i]->AlongStepDoIt(track, step);
+        switch(fProcs.alongType[i])
+        {
+          case kMsc:
+            static_cast<G4ParticleChangeForMSC*>(particleChange)
+              ->G4ParticleChangeForMSC::UpdateStepForAlongStep(&step);
+            break;
+          case kLoss:
+            static_cast<G4ParticleChangeForLoss*>(particleChange)
+              ->G4ParticleChangeForLoss::UpdateStepForAlongStep(&step);
+            break;
+          default:
+            particleChange->UpdateStepForAlongStep(&step);
+            break;
+        }
+        StackSecondaries(track, particleChange, along[i], secondaries);
+        track.SetTrackStatus(particleChange->GetTrackStatus());
+        particleChange->Clear();
+      }
+      fPreviousStepLength = step.GetStepLength();
+    }
+
+    void PostStepDoIt(G4Track& track, G4Step& step,
+                      G4TrackVector& secondaries) override
+    {
+      const auto& post = fProcs.postStep;
+      for(std::size_t i = 0; i < post.size(); ++i)
+      {
+        G4ForceCondition condition = fCondition[i];
+        G4bool invoke = false;
+        switch(condition)
+        {
+          case NotForced:
+            invoke = (G4int(i) == fSelected && !fExclusive);
+            break;
+          case Forced:
+            invoke = !fExclusive;
+            break;
+          case ExclusivelyForced:
+            invoke = fExclusive;
+            break;
+          case StronglyForced:
+            invoke = true;
+            break;
+          default:
+            break;
+        }
+        if(!invoke)
+        {
+          continue;
+        }
+        // after the track is killed only strongly forced processes
+        if(track.GetTrackStatus() == fStopAndKill &&
+           condition != StronglyForced)
+        {
+          continue;
+        }
+        G4VParticleChange* particleChange = post[i]->PostStepDoIt(track, step);
+        switch(fProcs.postType[i])
+        {
+          case kLoss:
+            static_cast<G4ParticleChangeForLoss*>(particleChange)
+              ->G4ParticleChangeForLoss::UpdateStepForPostStep(&step);
+            break;
+          case kGamma:
+            static_cast<G4ParticleChangeForGamma*>(particleChange)
+              ->G4ParticleChangeForGamma::UpdateStepForPostStep(&step);
+            break;
+          default:
+            particleChange->UpdateStepForPostStep(&step);
+            break;
+        }
+        step.UpdateTrack();
+        StackSecondaries(track, particleChange, post[i], secondaries);
+        track.SetTrackStatus(particleChange->GetTrackStatus());
+        particleChange->Clear();
+      }
+    }
+
+    G4bool HasAtRestProcesses() override { return !fProcs.atRest.empty(); }
+
+    void AtRestDoIt(G4Track& track, G4Step& step,
+                    G4TrackVector& secondaries) override
+    {
+      // the process with the shortest time is invoked, with forced ones
+      const auto& atRest = fProcs.atRest;
+      std::vector<G4bool> invoke(atRest.size(), false);
+      G4double shortestLifeTime = DBL_MAX;
+      G4int selected = -1;
+      for(G4int i = G4int(atRest.size()) - 1; i >= 0; --i)
+      {
+        G4ForceCondition condition = NotForced;
+        G4double lifeTime = atRest[i]->AtRestGPIL(track, &condition);
+        if(condition == Forced)
+        {
+          invoke[i] = true;
+        }
+        else if(lifeTime < shortestLifeTime)
+        {
+          shortestLifeTime = lifeTime;
+          selected = i;
+        }
+      }
+      if(selected >= 0)
+      {
+        invoke[selected] = true;
+      }
+
+      step.SetStepLength(0.0);
+      track.SetStepLength(0.0);
+      G4StepPoint* postStepPoint = step.GetPostStepPoint();
+      for(std::size_t i = 0; i < atRest.size(); ++i)
+      {
+        if(!invoke[i])
+        {
+          continue;
+        }
+        G4VParticleChange* particleChange = atRest[i]->AtRestDoIt(track, step);
+        postStepPoint->SetProcessDefinedStep(atRest[i]);
+        postStepPoint->SetStepStatus(fAtRestDoItProc);
+        particleChange->UpdateStepForAtRest(&step);
+        step.UpdateTrack();
+        StackSecondaries(track, particleChange, atRest[i], secondaries);
+        track.SetTrackStatus(particleChange->GetTrackStatus());
+        particleChange->Clear();
+      }
+      track.SetTrackStatus(fStopAndKill);
+    }
+
+  private:
+
+    void StackSecondaries(const G4Track& track,
+                          G4VParticleChange* particleChange,
+                          const G4VProcess* process,
+                          G4TrackVector& secondaries)
+    {
+      G4int nSecondaries = particleChange->GetNumberOfSecondaries();
+      for(G4int i = 0; i < nSecondaries; ++i)
+      {
+        G4Track* secondary = particleChange->GetSecondary(i);
+        secondary->SetParentID(track.GetTrackID());
+        secondary->SetCreatorProcess(process);
+        if(G4TrackingManagerHelper::AcceptSecondary(secondary))
+        {
+          secondaries.push_back(secondary);
+        }
+        else
+        {
+          delete secondary;
+        }
+      }
+    }
+
+  private:
+
+    const ProcessList& fProcs;
+    G4ProcessManager* fManager;
+    std::vector<G4ForceCondition>& fCondition;
+    const G4VProcess* fDefinedBy = nullptr;
+    G4double fPreviousStepLength = 0.0;
+    G4double fProposedStep = DBL_MAX;
+    G4int fSelected = -1;
+    G4bool fExclusive = false;
+};
+
+// --------------------------------------------------------------------
+G4ElectronTrackingManager::G4ElectronTrackingManager() = default;
+
+// --------------------------------------------------------------------
+G4ElectronTrackingManager::~G4ElectronTrackingManager() = default;
+
+// --------------------------------------------------------------------
+G4ElectronTrackingManager::ProcessList*
+G4ElectronTrackingManager::GetProcessList(const G4ParticleDefinition* part)
+{
+  if(part == G4Electron::Definition())
+  {
+    return &fElectron;
+  }
+  if(part == G4Positron::Definition())
+  {
+    return &fPositron;
+  }
+  return nullptr;
+}
+
+// --------------------------------------------------------------------
+void G4ElectronTrackingManager::PreparePhysicsTable(
+  const G4ParticleDefinition& part)
+{
+  ProcessList* list = GetProcessList(&part);
+  G4ProcessManager* pm = part.GetProcessManager();
+  if(list == nullptr || pm == nullptr)
+  {
+    G4ExceptionDescription ed;
+    ed << "Cannot be used for " << part.GetParticleName();
+    G4Exception("G4ElectronTrackingManager::PreparePhysicsTable()",
+                "em0302", FatalException, ed);
+    return;
+  }
+
+  auto changeType = [](G4VProcess* proc) {
+    if(dynamic_cast<G4VMultipleScattering*>(proc) != nullptr)
+      return kMsc;
+    if(dynamic_cast<G4VEnergyLossProcess*>(proc) != nullptr)
+      return kLoss;
+    if(dynamic_cast<G4VEmProcess*>(proc) != nullptr)
+      return kGamma;
+    return kGeneric;
+  };
+
+  // Transportation is done by the helper. Parallel world processes
+  // relocate the track in their own geometry and cannot be used.
+  *list = ProcessList();
+  G4String ignored;
+  auto usable = [&](G4VProcess* proc) {
+    if(proc == nullptr)
+    {
+      return false;
+    }
+    if(proc->GetProcessType() == fTransportation)
+    {
+      list->transport = proc;
+      return false;
+    }
+    if(proc->GetProcessType() == fParallel)
+    {
+      if(ignored.find(proc->GetProcessName()) == std::string::npos)
+      {
+        ignored += " " + proc->GetProcessName();
+      }
+      return false;
+    }
+    return true;
+  };
+
+  G4ProcessVector* pv = pm->GetAlongStepProcessVector(typeDoIt);
+  for(G4int i = 0; i < (G4int)pv->entries(); ++i)
+  {
+    G4VProcess* proc = (*pv)[i];
+    if(usable(proc))
+    {
+      list->alongStep.push_back(proc);
+      list->alongType.push_back(changeType(proc));
+    }
+  }
+  pv = pm->GetPostStepProcessVector(typeDoIt);
+  for(G4int i = 0; i < (G4int)pv->entries(); ++i)
+  {
+    G4VProcess* proc = (*pv)[i];
+    if(usable(proc))
+    {
+      list->postStep.push_back(proc);
+      list->postType.push_back(changeType(proc));
+    }
+  }
+  list->condition.resize(list->postStep.size(), NotForced);
+  pv = pm->GetAtRestProcessVector(typeDoIt);
+  for(G4int i = 0; i < (G4int)pv->entries(); ++i)
+  {
+    G4VProcess* proc = (*pv)[i];
+    if(usable(proc))
+    {
+      list->atRest.push_back(proc);
+    }
+  }
+  if(!ignored.empty())
+  {
+    G4ExceptionDescription ed;
+    ed << "Processes assigned to " << part.GetParticleName()
+       << " are not used by G4ElectronTrackingManager:" << ignored;
+    G4Exception("G4ElectronTrackingManager::PreparePhysicsTable()",
+                "em0303", JustWarning, ed);
+  }
+
+  G4bool master = (pm == part.GetMasterProcessManager());
+  G4ProcessVector* procs = pm->GetProcessList();
+  for(G4int i = 0; i < (G4int)procs->size(); ++i)
+  {
+    if(master)
+    {
+      (*procs)[i]->PreparePhysicsTable(part);
+    }
+    else
+    {
+      (*procs)[i]->PrepareWorkerPhysicsTable(part);
+    }
+  }
+}
+
+// --------------------------------------------------------------------
+void G4ElectronTrackingManager::BuildPhysicsTable(
+  const G4ParticleDefinition& part)
+{
+  G4ProcessManager* pm = part.GetProcessManager();
+  G4bool master = (pm == part.GetMasterProcessManager());
+  G4ProcessVector* procs = pm->GetProcessList();
+  for(G4int i = 0; i < (G4int)procs->size(); ++i)
+  {
+    if(master)
+    {
+      (*procs)[i]->BuildPhysicsTable(part);
+    }
+    else
+    {
+      (*procs)[i]->BuildWorkerPhysicsTable(part);
+    }
+  }
+}
+
+// --------------------------------------------------------------------
+void G4ElectronTrackingManager::HandOverOneTrack(G4Track* aTrack)
+{
+  const G4ParticleDefinition* part = aTrack->GetParticleDefinition();
+  ChargedPhysics physics(*GetProcessList(part), part->GetProcessManager());
+  G4TrackingManagerHelper::TrackChargedParticle(aTrack, physics);
+
+  aTrack->SetTrackStatus(fStopAndKill);
+  delete aTrack;
+}
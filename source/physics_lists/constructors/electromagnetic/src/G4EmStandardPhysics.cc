@@ -75,6 +75,8 @@
 #include "G4BuilderType.hh"
 #include "G4EmModelActivator.hh"
 #include "G4GammaGeneralProcess.hh"
+#include "G4GammaTrackingManager.hh"
+#include "G4ElectronTrackingManager.hh"
 
 // factory
 #include "G4PhysicsConstructorFactory.hh"
@@ -156,14 +158,31 @@ void G4EmStandardPhysics::ConstructProcess()
     rl->SetEmModel(new G4LivermorePolarizedRayleighModel());
   }
 
-  if(G4EmParameters::Instance()->GeneralProcessActive()) {
+  // the gamma tracking manager drives the general process only, so that
+  // it is used only if the general process is enabled as well
+  if(param->GammaTrackingManagerActive() && !param->GeneralProcessActive()) {
+    G4ExceptionDescription ed;
+    ed << "G4GammaTrackingManager requires /process/em/UseGeneralProcess true,"
+       << " gamma are transported by the generic stepping loop";
+    G4Exception("G4EmStandardPhysics::ConstructProcess()", "em0304",
+                JustWarning, ed);
+  }
+
+  if(param->GeneralProcessActive()) {
     G4GammaGeneralProcess* sp = new G4GammaGeneralProcess();
     sp->AddEmProcess(pe);
     sp->AddEmProcess(cs);
     sp->AddEmProcess(new G4GammaConversion());
     sp->AddEmProcess(rl);
     G4LossTableManager::Instance()->SetGammaGeneralProcess(sp);
-    ph->RegisterProcess(sp, particle);
+
+    // gamma are transported by the specialized tracking manager,
+    // the general process is not assigned to the process manager
+    if(param->GammaTrackingManagerActive()) {
+      particle->SetTrackingManager(new G4GammaTrackingManager(sp));
+    } else {
+      ph->RegisterProcess(sp, particle);
+    }
 
   } else {
     ph->RegisterProcess(pe, particle);
@@ -219,6 +238,13 @@ void G4EmStandardPhysics::ConstructProcess()
   ph->RegisterProcess(new G4eplusAnnihilation(), particle);
   ph->RegisterProcess(ss, particle);
 
+  // e+- may be transported by the specialised tracking manager
+  if(param->ElectronTrackingManagerActive()) {
+    auto etm = new G4ElectronTrackingManager();
+    G4Electron::Electron()->SetTrackingManager(etm);
+    G4Positron::Positron()->SetTrackingManager(etm);
+  }
+
   // generic ion
   particle = G4GenericIon::GenericIon();
   G4ionIonisation* ionIoni = new G4ionIonisation();
@@ -97,6 +97,7 @@
 #include "G4BuilderType.hh"
 #include "G4EmModelActivator.hh"
 #include "G4GammaGeneralProcess.hh"
+#include "G4ElectronTrackingManager.hh"
 
 // factory
 #include "G4PhysicsConstructorFactory.hh"
@@ -314,6 +315,13 @@ void G4EmStandardPhysics_option4::ConstructProcess()
   ph->RegisterProcess(new G4eplusAnnihilation(), particle);
   ph->RegisterProcess(ss, particle);
 
+  // e+- may be transported by the specialised tracking manager
+  if(param->ElectronTrackingManagerActive()) {
+    auto etm = new G4ElectronTrackingManager();
+    G4Electron::Electron()->SetTrackingManager(etm);
+    G4Positron::Positron()->SetTrackingManager(etm);
+  }
+
   // generic ion
   particle = G4GenericIon::GenericIon();
   G4ionIonisation* ionIoni = new G4ionIonisation();
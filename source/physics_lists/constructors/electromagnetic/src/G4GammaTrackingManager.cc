@@ -0,0 +1,207 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4GammaTrackingManager implementation
+// --------------------------------------------------------------------
+
+#include "G4GammaTrackingManager.hh"
+#include "G4TrackingManagerHelper.hh"
+
+#include "G4GammaGeneralProcess.hh"
+#include "G4EmProcessSubType.hh"
+#include "G4ParticleChangeForGamma.hh"
+#include "G4ProcessManager.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+
+namespace
+{
+  // Physics of gamma for G4TrackingManagerHelper: one discrete process,
+  // nothing to be done along the step
+  class GammaPhysics final : public G4TrackingManagerHelper::Physics
+  {
+    public:
+
+      GammaPhysics(G4GammaGeneralProcess* proc, G4VProcess* transport)
+        : fProcess(proc), fTransport(transport)
+      {}
+
+      void StartTracking(G4Track* aTrack) override
+      {
+        fProcess->StartTracking(aTrack);
+        fPreviousStepLength = 0.0;
+      }
+
+      void EndTracking() override
+      {
+        fProcess->EndTracking();
+      }
+
+      G4double GetPhysicalInteractionLength(const G4Track& track) override
+      {
+        G4ForceCondition condition;
+        fProposedStep =
+          fProcess->PostStepGPIL(track, fPreviousStepLength, &condition);
+        return fProposedStep;
+      }
+
+      void AlongStepDoIt(G4Track&, G4Step& step, G4TrackVector&) override
+      {
+        fInteraction = (step.GetStepLength() == fProposedStep);
+        G4StepPoint* postStepPoint = step.GetPostStepPoint();
+        if(fInteraction)
+        {
+          postStepPoint->SetStepStatus(fAlongStepDoItProc);
+          postStepPoint->SetProcessDefinedStep(fProcess);
+        }
+        else
+        {
+          // the step was limited by geometry
+          postStepPoint->SetProcessDefinedStep(fTransport);
+        }
+        fPreviousStepLength = step.GetStepLength();
+      }
+
+      void PostStepDoIt(G4Track& track, G4Step& step,
+                        G4TrackVector& secondaries) override
+      {
+        if(!fInteraction)
+        {
+          return;
+        }
+        step.GetPostStepPoint()->SetStepStatus(fPostStepDoItProc);
+
+        G4VParticleChange* particleChange =
+          fProcess->PostStepDoIt(track, step);
+
+        // All EM sub-processes use G4ParticleChangeForGamma: it is updated
+        // directly, other sub-processes through the virtual interface
+        G4int subType = fProcess->GetSubProcessSubType();
+        if(subType <= fGammaConversion || subType == fGammaGeneralProcess)
+        {
+          auto pc = static_cast<G4ParticleChangeForGamma*>(particleChange);
+          pc->G4ParticleChangeForGamma::UpdateStepForPostStep(&step);
+        }
+        else
+        {
+          particleChange->UpdateStepForPostStep(&step);
+        }
+        step.UpdateTrack();
+
+        G4int nSecondaries = particleChange->GetNumberOfSecondaries();
+        for(G4int i = 0; i < nSecondaries; ++i)
+        {
+          G4Track* secondary = particleChange->GetSecondary(i);
+          secondary->SetParentID(track.GetTrackID());
+          secondary->SetCreatorProcess(fProcess);
+          if(G4TrackingManagerHelper::AcceptSecondary(secondary))
+          {
+            secondaries.push_back(secondary);
+          }
+          else
+          {
+            delete secondary;
+          }
+        }
+
+        track.SetTrackStatus(particleChange->GetTrackStatus());
+        particleChange->Clear();
+      }
+
+    private:
+
+      G4GammaGeneralProcess* fProcess;
+      G4VProcess* fTransport;
+      G4double fPreviousStepLength = 0.0;
+      G4double fProposedStep = DBL_MAX;
+      G4bool fInteraction = false;
+  };
+}
+
+// --------------------------------------------------------------------
+G4GammaTrackingManager::G4GammaTrackingManager(G4GammaGeneralProcess* proc)
+  : fProcess(proc)
+{}
+
+// --------------------------------------------------------------------
+G4GammaTrackingManager::~G4GammaTrackingManager() = default;
+
+// --------------------------------------------------------------------
+void G4GammaTrackingManager::PreparePhysicsTable(
+  const G4ParticleDefinition& part)
+{
+  CheckProcessManager(part);
+  fProcess->PreparePhysicsTable(part);
+}
+
+// --------------------------------------------------------------------
+void G4GammaTrackingManager::BuildPhysicsTable(
+  const G4ParticleDefinition& part)
+{
+  fProcess->BuildPhysicsTable(part);
+}
+
+// --------------------------------------------------------------------
+void G4GammaTrackingManager::HandOverOneTrack(G4Track* aTrack)
+{
+  GammaPhysics physics(fProcess, fTransport);
+  G4TrackingManagerHelper::TrackNeutralParticle(aTrack, physics);
+
+  aTrack->SetTrackStatus(fStopAndKill);
+  delete aTrack;
+}
+
+// --------------------------------------------------------------------
+void G4GammaTrackingManager::CheckProcessManager(
+  const G4ParticleDefinition& part)
+{
+  G4ProcessManager* pm = part.GetProcessManager();
+  if(pm == nullptr)
+  {
+    return;
+  }
+  G4ProcessVector* pv = pm->GetProcessList();
+  G4String ignored;
+  for(G4int i = 0; i < (G4int)pv->size(); ++i)
+  {
+    G4VProcess* proc = (*pv)[i];
+    if(proc->GetProcessType() == fTransportation)
+    {
+      fTransport = proc;
+    }
+    else
+    {
+      ignored += " " + proc->GetProcessName();
+    }
+  }
+  if(!ignored.empty())
+  {
+    G4ExceptionDescription ed;
+    ed << "Processes assigned to " << part.GetParticleName()
+       << " are not used by G4GammaTrackingManager:" << ignored;
+    G4Exception("G4GammaTrackingManager::PreparePhysicsTable()", "em0301",
+                JustWarning, ed);
+  }
+}
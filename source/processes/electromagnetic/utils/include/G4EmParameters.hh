@@ -166,6 +166,16 @@ public:
   void SetGeneralProcessActive(G4bool val);
   G4bool GeneralProcessActive() const;
 
+  // if enabled together with the general process, gamma are transported
+  // by G4GammaTrackingManager instead of the generic stepping loop
+  void SetGammaTrackingManagerActive(G4bool val);
+  G4bool GammaTrackingManagerActive() const;
+
+  // if enabled, e+- are transported by G4ElectronTrackingManager
+  // instead of the generic stepping loop
+  void SetElectronTrackingManagerActive(G4bool val);
+  G4bool ElectronTrackingManagerActive() const;
+
   void SetEnableSamplingTable(G4bool val);
   G4bool EnableSamplingTable() const;
 
@@ -390,6 +400,8 @@ private:
   G4bool birks;
   G4bool fICRU90;
   G4bool gener;
+  G4bool fGammaTM;
+  G4bool fElectronTM;
   G4bool fSamplingTable;
   G4bool fPolarisation;
   G4bool fMuDataFromFile;
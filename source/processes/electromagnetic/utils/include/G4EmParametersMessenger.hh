@@ -97,6 +97,8 @@ private:
   G4UIcmdWithABool*          mottCmd;
   G4UIcmdWithABool*          birksCmd;
   G4UIcmdWithABool*          sharkCmd;
+  G4UIcmdWithABool*          gtmCmd;
+  G4UIcmdWithABool*          etmCmd;
   G4UIcmdWithABool*          poCmd;
   G4UIcmdWithABool*          onIsolatedCmd;
   G4UIcmdWithABool*          sampleTCmd;
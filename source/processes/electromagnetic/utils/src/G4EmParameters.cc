@@ -131,6 +131,8 @@ void G4EmParameters::Initialise()
   birks = false;
   fICRU90 = false;
   gener = false;
+  fGammaTM = false;
+  fElectronTM = false;
   onIsolated = false;
   fSamplingTable = false;
   fPolarisation = false;
@@ -439,6 +441,28 @@ G4bool G4EmParameters::GeneralProcessActive() const
   return gener;
 }
 
+void G4EmParameters::SetGammaTrackingManagerActive(G4bool val)
+{
+  if(IsLocked()) { return; }
+  fGammaTM = val;
+}
+
+G4bool G4EmParameters::GammaTrackingManagerActive() const
+{
+  return fGammaTM;
+}
+
+void G4EmParameters::SetElectronTrackingManagerActive(G4bool val)
+{
+  if(IsLocked()) { return; }
+  fElectronTM = val;
+}
+
+G4bool G4EmParameters::ElectronTrackingManagerActive() const
+{
+  return fElectronTM;
+}
+
 void G4EmParameters::SetEmSaturation(G4EmSaturation* ptr)
 {
   if(IsLocked()) { return; }
@@ -1235,6 +1259,8 @@ void G4EmParameters::StreamInfo(std::ostream& os) const
   os << "Enable creation and use of sampling tables         " <<fSamplingTable << "\n";
   os << "Apply cuts on all EM processes                     " <<applyCuts << "\n";
   os << "Use general process                                " <<gener << "\n";
+  os << "Use gamma tracking manager                         " <<fGammaTM << "\n";
+  os << "Use e+- tracking manager                           " <<fElectronTM << "\n";
   os << "Enable linear polarisation for gamma               " <<fPolarisation << "\n";
   os << "Enable sampling of quantum entanglement            " 
      <<fBParameters->QuantumEntanglement()  << "\n";
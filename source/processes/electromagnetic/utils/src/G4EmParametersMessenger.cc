@@ -156,6 +156,21 @@ G4EmParametersMessenger::G4EmParametersMessenger(G4EmParameters* ptr)
   sharkCmd->AvailableForStates(G4State_PreInit);
   sharkCmd->SetToBeBroadcasted(false);
 
+  gtmCmd = new G4UIcmdWithABool("/process/em/UseGammaTrackingManager",this);
+  gtmCmd->SetGuidance("Enable specialized tracking manager for gamma");
+  gtmCmd->SetGuidance("  it is used only together with the general process");
+  gtmCmd->SetParameterName("gtm",true);
+  gtmCmd->SetDefaultValue(false);
+  gtmCmd->AvailableForStates(G4State_PreInit);
+  gtmCmd->SetToBeBroadcasted(false);
+
+  etmCmd = new G4UIcmdWithABool("/process/em/UseElectronTrackingManager",this);
+  etmCmd->SetGuidance("Enable specialized tracking manager for e+-");
+  etmCmd->SetParameterName("etm",true);
+  etmCmd->SetDefaultValue(false);
+  etmCmd->AvailableForStates(G4State_PreInit);
+  etmCmd->SetToBeBroadcasted(false);
+
   poCmd = new G4UIcmdWithABool("/process/em/Polarisation",this);
   poCmd->SetGuidance("Enable polarisation");
   poCmd->AvailableForStates(G4State_PreInit);
@@ -439,6 +454,8 @@ G4EmParametersMessenger::~G4EmParametersMessenger()
   delete mottCmd;
   delete birksCmd;
   delete sharkCmd;
+  delete gtmCmd;
+  delete etmCmd;
   delete onIsolatedCmd;
   delete sampleTCmd;
   delete poCmd;
@@ -521,6 +538,10 @@ void G4EmParametersMessenger::SetNewValue(G4UIcommand* command,
     theParameters->SetUseICRU90Data(icru90Cmd->GetNewBoolValue(newValue));
   } else if (command == sharkCmd) {
     theParameters->SetGeneralProcessActive(sharkCmd->GetNewBoolValue(newValue));
+  } else if (command == gtmCmd) {
+    theParameters->SetGammaTrackingManagerActive(gtmCmd->GetNewBoolValue(newValue));
+  } else if (command == etmCmd) {
+    theParameters->SetElectronTrackingManagerActive(etmCmd->GetNewBoolValue(newValue));
   } else if (command == poCmd) {
     theParameters->SetEnablePolarisation(poCmd->GetNewBoolValue(newValue));
   } else if (command == sampleTCmd) {
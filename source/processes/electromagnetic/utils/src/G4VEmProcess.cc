@@ -72,6 +72,7 @@
 #include "G4DNAModelSubType.hh"
 #include "G4GenericIon.hh"
 #include "G4Log.hh"
+#include "G4PhysicsTableReplicas.hh"
 #include <iostream>
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo....
@@ -326,8 +327,10 @@ void G4VEmProcess::BuildPhysicsTable(const G4ParticleDefinition& part)
 
     // worker initialisation
     if(!isTheMaster) {
-      theLambdaTable = masterProc->LambdaTable();
-      theLambdaTablePrim = masterProc->LambdaTablePrim();
+      // tables local to the NUMA node if replication is enabled
+      G4PhysicsTableReplicas* rep = G4PhysicsTableReplicas::Instance();
+      theLambdaTable = rep->GetReplica(masterProc->LambdaTable());
+      theLambdaTablePrim = rep->GetReplica(masterProc->LambdaTablePrim());
       if(fXSType == fEmOnePeak) {
 	SetEnergyOfCrossSectionMax(masterProc->EnergyOfCrossSectionMax());
       }
@@ -78,6 +78,7 @@
 #include "G4TransportationManager.hh"
 #include "G4VAtomDeexcitation.hh"
 #include "G4VSubCutProducer.hh"
+#include "G4PhysicsTableReplicas.hh"
 #include "G4EmBiasingManager.hh"
 #include "G4Log.hh"
 #include <iostream>
@@ -494,15 +495,20 @@ void G4VEnergyLossProcess::BuildPhysicsTable(const G4ParticleDefinition& part)
       const G4VEnergyLossProcess* masterProcess = 
         static_cast<const G4VEnergyLossProcess*>(GetMasterProcess());
 
-      // copy table pointers from master thread
-      SetDEDXTable(masterProcess->DEDXTable(),fRestricted);
-      SetDEDXTable(masterProcess->DEDXunRestrictedTable(),fTotal);
-      SetDEDXTable(masterProcess->IonisationTable(),fIsIonisation);
-      SetRangeTableForLoss(masterProcess->RangeTableForLoss());
-      SetCSDARangeTable(masterProcess->CSDARangeTable());
-      SetSecondaryRangeTable(masterProcess->SecondaryRangeTable());
-      SetInverseRangeTable(masterProcess->InverseRangeTable());
-      SetLambdaTable(masterProcess->LambdaTable());
+      // copy table pointers from master thread,
+      // or from the replicas local to the NUMA node if enabled
+      G4PhysicsTableReplicas* rep = G4PhysicsTableReplicas::Instance();
+      SetDEDXTable(rep->GetReplica(masterProcess->DEDXTable()),fRestricted);
+      SetDEDXTable(rep->GetReplica(masterProcess->DEDXunRestrictedTable()),
+                   fTotal);
+      SetDEDXTable(rep->GetReplica(masterProcess->IonisationTable()),
+                   fIsIonisation);
+      SetRangeTableForLoss(rep->GetReplica(masterProcess->RangeTableForLoss()));
+      SetCSDARangeTable(rep->GetReplica(masterProcess->CSDARangeTable()));
+      SetSecondaryRangeTable(
+        rep->GetReplica(masterProcess->SecondaryRangeTable()));
+      SetInverseRangeTable(rep->GetReplica(masterProcess->InverseRangeTable()));
+      SetLambdaTable(rep->GetReplica(masterProcess->LambdaTable()));
       SetTwoPeaksXS(masterProcess->TwoPeaksXS());
       isIonisation = masterProcess->IsIonisationProcess();
       baseMat = masterProcess->UseBaseMaterial();
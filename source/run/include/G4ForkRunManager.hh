@@ -0,0 +1,96 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4ForkRunManager
+//
+// Class description:
+//
+// This is a class for run control in GEANT4 with several processes
+// on a single node. It extends G4RunManager: geometry and physics are
+// initialised once by this (parent) process, then at each event loop
+// the parent forks N child processes which inherit all tables by
+// copy-on-write. Each child processes a disjoint range of event IDs.
+// The seeds of each event are derived from its ID and from two seeds
+// drawn by the parent for the run, so that results do not depend on the
+// number of processes and no per-event storage is needed. User code
+// does not need to be thread-safe.
+// At the end of its range, each child sends its results to the parent
+// through a pipe and exits. The following results are merged into the
+// parent before the end-of-run user action:
+//  - the G4Run object, with G4Run::WriteForMerge()/MergeFromStream(),
+//    which the user's run class must implement for its own data;
+//  - G4Accumulable<G4double> and G4Accumulable<G4int> registered to the
+//    G4AccumulableManager;
+//  - command-based scoring meshes.
+// Other results (e.g. analysis histograms, output files) must be written
+// by each child, typically with the process index from GetProcessIndex()
+// in the file name, from G4Run::WriteForMerge().
+// Visualisation of events and checkpointing (/run/checkpoint) are not
+// supported in the children. A run resumed from a checkpoint file
+// (/run/restart) is processed by the parent alone, as by G4RunManager.
+// This class is not available on Windows, where it behaves as
+// G4RunManager.
+
+// --------------------------------------------------------------------
+#ifndef G4ForkRunManager_hh
+#define G4ForkRunManager_hh 1
+
+#include "G4RunManager.hh"
+
+class G4ForkRunManager : public G4RunManager
+{
+  public:
+
+    G4ForkRunManager();
+   ~G4ForkRunManager() override = default;
+
+    void DoEventLoop(G4int n_event, const char* macroFile = nullptr,
+                     G4int n_select = -1) override;
+
+    inline void SetNumberOfProcesses(G4int n) { nProcesses = (n > 0) ? n : 1; }
+    inline G4int GetNumberOfProcesses() const { return nProcesses; }
+
+    inline G4int GetProcessIndex() const { return processIndex; }
+      // Index of this child process, -1 in the parent process.
+
+  protected:
+
+    virtual void ChildEventLoop(G4int firstEvent, G4int lastEvent);
+      // Processes events [firstEvent, lastEvent[ in a child process.
+      // Its results are sent with WriteResults() and merged by the parent
+      // with MergeResults().
+
+    void DeriveEventSeeds(G4int eventID, long* seeds) const;
+      // Fills seeds[0] and seeds[1] for the given event from the seeds
+      // of the run.
+
+  private:
+
+    G4int nProcesses = 2;
+    G4int processIndex = -1;
+    G4long runSeeds[2] = { 0, 0 };
+};
+
+#endif
@@ -75,6 +75,14 @@ class G4MTRunManager : public G4RunManager
     virtual G4int GetNumberOfThreads() const { return nworkers; }
     void SetPinAffinity(G4int n = 1);
     inline G4int GetPinAffinity() const { return pinAffinity; }
+    void SetNumaMode(G4int n = 1);
+    inline G4int GetNumaMode() const { return numaMode; }
+      // NUMA mode
+      //  0 : disabled (default)
+      //  1 : each worker is pinned to the CPUs of one NUMA node, nodes
+      //      being assigned in a round robin way; pin affinity is ignored
+      //  2 : as 1, and shared physics tables are replicated once per NUMA
+      //      node (see G4PhysicsTableReplicas)
 
     // Inherited methods to re-implement for MT case
     virtual void Initialize();
@@ -192,6 +200,20 @@ class G4MTRunManager : public G4RunManager
 
     static G4int SeedOncePerCommunication();
     static void SetSeedOncePerCommunication(G4int val);
+
+    inline void SetCounterBasedSeeding(G4bool val) { counterBasedSeeding = val; }
+    inline G4bool IsCounterBasedSeeding() const { return counterBasedSeeding; }
+      // If set, the seeds of each event are not generated in advance by the
+      // master but derived by the worker from the run seed, the run ID and
+      // the event ID with DeriveEventSeeds(). No seeds are passed through
+      // SetUpAnEvent() and SetUpNEvents() in this case: the seeds filled by
+      // an InitializeSeeds() of a derived class are not used, with a
+      // warning. Every event is seeded, whatever the value of
+      // SeedOncePerCommunication(), so that the results of an event do not
+      // depend on the thread processing it.
+    void DeriveEventSeeds(G4int eventID, G4long* seeds) const;
+      // Fills 'seeds' with the nSeedsPerEvent seeds of the given event of the
+      // current run. Can be invoked by any thread during the event loop.
     static G4ThreadId GetMasterTheadId();
 
   protected:
@@ -253,6 +275,12 @@ class G4MTRunManager : public G4RunManager
     G4int nSeedsPerEvent = 2;
     G4double* randDbl = nullptr;
 
+    G4bool counterBasedSeeding = false;
+    G4long runSeed = 0;
+    G4int runIDOfSeed = 0;
+      // Run seed drawn by the master at the start of each event loop, and
+      // run ID used with it to derive the seeds of each event.
+
     static G4ThreadId masterThreadId;
     static G4int seedOncePerCommunication;
       // - If it is set to 0 (default), seeds that are centrally managed
@@ -283,6 +311,8 @@ class G4MTRunManager : public G4RunManager
 
     G4int pinAffinity = 0;
       // Pin Affinity parameter
+    G4int numaMode = 0;
+      // NUMA mode parameter
     G4ThreadsList threads;
       // List of workers run managers
       // List of all workers run managers
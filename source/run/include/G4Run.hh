@@ -36,6 +36,7 @@
 #ifndef G4Run_hh
 #define G4Run_hh 1
 
+#include <iosfwd>
 #include <vector>
 
 #include "globals.hh"
@@ -66,6 +67,15 @@ class G4Run
     virtual void Merge(const G4Run*);
       // Method to be overwritten by the user for merging local G4Run object
       // to the global G4Run object.
+    virtual void WriteForMerge(std::ostream& out) const;
+    virtual void MergeFromStream(std::istream& in);
+      // Methods used by G4ForkRunManager, where the run objects to be
+      // merged live in different processes: the run object of a child
+      // process is written by WriteForMerge() and read and merged into the
+      // run object of the parent process by MergeFromStream(). Also used
+      // to save the run object in checkpoint files (see /run/checkpoint)
+      // and to restore it into an empty run object. To be overwritten
+      // together by the user, invoking the base class methods first.
     void StoreEvent(G4Event* evt);
       // Store a G4Event object until this run object is deleted.
       // Given the potential large memory size of G4Event and its data-member
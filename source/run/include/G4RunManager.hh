@@ -102,6 +102,7 @@
 #define G4RunManager_hh 1
 
 #include <algorithm>
+#include <iosfwd>
 #include <list>
 
 #include "rundefs.hh"
@@ -555,6 +556,22 @@ class G4RunManager
       }
       return nullptr;
     }
+    void SetCheckpoint(G4int interval, const G4String& fileName);
+      // Every "interval" events, the state of the run (number of processed
+      // events, random number engine status, accumulables, scoring meshes
+      // and the G4Run object, see WriteResults()) is written to "fileName".
+      // An interval of zero disables checkpointing. Sequential mode only.
+    inline G4int GetCheckpointInterval() const { return checkpointInterval; }
+    inline const G4String& GetCheckpointFile() const { return checkpointFile; }
+    inline void SetRestartFile(const G4String& fileName)
+      // The next BeamOn() resumes the run saved in the given checkpoint
+      // file: the saved results are restored and the event loop starts
+      // after the last saved event.
+    {
+      restartFile = fileName;
+    }
+    inline const G4String& GetRestartFile() const { return restartFile; }
+
     inline void SetRunIDCounter(G4int i) { runIDCounter = i; }
       // Set the run number counter. Initially, the counter is initialized
       // to zero and incremented by one for every BeamOn().
@@ -592,6 +609,16 @@ class G4RunManager
 
     virtual void StoreRNGStatus(const G4String& filenamePrefix);
 
+    virtual void WriteResults(std::ostream& out) const;
+    virtual void MergeResults(std::istream& in);
+      // Writes the results of the current run (number of processed events,
+      // accumulables, scoring meshes and G4Run object) to a binary stream,
+      // and merges such results into the current run.
+    virtual void WriteCheckpoint();
+    virtual G4int RestoreCheckpoint(G4int n_event);
+      // Writes the checkpoint file, and restores the run from the restart
+      // file, returning the index of the first event to be processed.
+
     void UpdateScoring();
     virtual void DeleteUserInitializations();
       // Called by destructor to delete user detector. Note: the user detector
@@ -653,6 +680,10 @@ class G4RunManager
 
     G4bool geometryDirectlyUpdated = false;
 
+    G4int checkpointInterval = 0;
+    G4String checkpointFile = "G4checkpoint.dat";
+    G4String restartFile = "";
+
     RMType runManagerType;
 
     G4RUN_DLL static G4bool fGeometryHasBeenDestroyed;
@@ -84,7 +84,11 @@ class G4RunMessenger : public G4UImessenger
     G4UIcmdWithAnInteger* nThreadsCmd = nullptr;
     G4UIcmdWithoutParameter* maxThreadsCmd = nullptr;
     G4UIcmdWithAnInteger* pinAffinityCmd = nullptr;
+    G4UIcmdWithAnInteger* numaCmd = nullptr;
     G4UIcommand* evModCmd = nullptr;
+    G4UIcmdWithABool* cntSeedCmd = nullptr;
+    G4UIcommand* ckptCmd = nullptr;
+    G4UIcmdWithAString* restartCmd = nullptr;
     G4UIcmdWithAString* dumpRegCmd = nullptr;
     G4UIcmdWithoutParameter* dumpCoupleCmd = nullptr;
     G4UIcmdWithABool* optCmd = nullptr;
@@ -58,6 +58,10 @@ class G4WorkerThread
     void SetPinAffinity(G4int aff) const;
       // Setting Pin Affinity
 
+    void SetNumaAffinity() const;
+      // Pin this thread to the CPUs of one NUMA node, nodes being
+      // assigned to threads in a round robin way
+
   private:
 
     G4int threadId = 0;
@@ -15,6 +15,7 @@ geant4_add_module(G4run
     G4PhysicsListWorkspace.hh
     G4Run.hh
     G4RunManager.hh
+    G4ForkRunManager.hh
     G4MTRunManager.hh
     G4WorkerRunManager.hh
     G4RunManagerKernel.hh
@@ -52,6 +53,7 @@ geant4_add_module(G4run
     G4PhysicsListWorkspace.cc
     G4Run.cc
     G4RunManager.cc
+    G4ForkRunManager.cc
     G4MTRunManager.cc
     G4WorkerRunManager.cc
     G4RunManagerKernel.cc
@@ -84,6 +86,7 @@ geant4_module_link_libraries(G4run
     G4partman
     G4tracking
   PRIVATE
+    G4accumulables
     G4bosons
     G4detector
     G4detutils
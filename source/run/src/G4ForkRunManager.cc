@@ -0,0 +1,193 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4ForkRunManager implementation
+// --------------------------------------------------------------------
+
+#include "G4ForkRunManager.hh"
+#include "G4RandomTools.hh"
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <vector>
+
+#if !defined(WIN32)
+#  include <cerrno>
+#  include <sys/types.h>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
+// --------------------------------------------------------------------
+G4ForkRunManager::G4ForkRunManager()
+  : G4RunManager()
+{}
+
+// --------------------------------------------------------------------
+void G4ForkRunManager::DoEventLoop(G4int n_event, const char* macroFile,
+                                   G4int n_select)
+{
+#if defined(WIN32)
+  G4RunManager::DoEventLoop(n_event, macroFile, n_select);
+#else
+  G4int nProc = std::min(nProcesses, n_event);
+  if(nProc < 2 || fakeRun)
+  {
+    G4RunManager::DoEventLoop(n_event, macroFile, n_select);
+    return;
+  }
+  if(!GetRestartFile().empty())
+  {
+    G4ExceptionDescription msg;
+    msg << "The run is resumed from <" << GetRestartFile() << ">."
+        << " Its remaining events are processed without child processes.";
+    G4Exception("G4ForkRunManager::DoEventLoop()", "Run0142", JustWarning,
+                msg);
+    G4RunManager::DoEventLoop(n_event, macroFile, n_select);
+    return;
+  }
+
+  InitializeEventLoop(n_event, macroFile, n_select);
+
+  // seeds of the run, the seeds of each event are derived from them
+  G4double rndm[2];
+  G4Random::getTheEngine()->flatArray(2, rndm);
+  runSeeds[0] = (G4long) (100000000L * rndm[0]);
+  runSeeds[1] = (G4long) (100000000L * rndm[1]);
+
+  G4cout << std::flush;
+  G4cerr << std::flush;
+
+  std::vector<pid_t> children;
+  std::vector<G4int> pipes;
+  for(G4int iProc = 0; iProc < nProc; ++iProc)
+  {
+    G4int fd[2];
+    pid_t pid = -1;
+    if(pipe(fd) == 0)
+      pid = fork();
+    if(pid < 0)
+    {
+      G4Exception("G4ForkRunManager::DoEventLoop()", "Run0135",
+                  FatalException, "Cannot create child process.");
+      return;
+    }
+    if(pid == 0)
+    {
+      // child: the events are processed here
+      close(fd[0]);
+      for(auto p : pipes)
+        close(p);
+      processIndex = iProc;
+      G4int first  = G4int(G4long(n_event) * iProc / nProc);
+      G4int last   = G4int(G4long(n_event) * (iProc + 1) / nProc);
+      ChildEventLoop(first, last);
+
+      std::ostringstream out;
+      WriteResults(out);
+      const std::string& buf = out.str();
+      std::size_t written    = 0;
+      while(written < buf.size())
+      {
+        ssize_t n = write(fd[1], buf.data() + written, buf.size() - written);
+        if(n < 0 && errno == EINTR)
+          continue;
+        if(n <= 0)
+          break;
+        written += n;
+      }
+      close(fd[1]);
+      G4cout << std::flush;
+      G4cerr << std::flush;
+      // do not run the exit handlers of the parent process
+      _exit(written == buf.size() ? 0 : 1);
+    }
+    close(fd[1]);
+    children.push_back(pid);
+    pipes.push_back(fd[0]);
+  }
+
+  // parent: collect and merge results in the order of the event ranges
+  for(G4int iProc = 0; iProc < nProc; ++iProc)
+  {
+    std::string buf;
+    char chunk[65536];
+    for(;;)
+    {
+      ssize_t n = read(pipes[iProc], chunk, sizeof(chunk));
+      if(n < 0 && errno == EINTR)
+        continue;
+      if(n <= 0)
+        break;
+      buf.append(chunk, n);
+    }
+    close(pipes[iProc]);
+
+    G4int status = 0;
+    while(waitpid(children[iProc], &status, 0) < 0 && errno == EINTR)
+    {}
+    if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+    {
+      G4ExceptionDescription msg;
+      msg << "Child process " << iProc << " did not terminate normally."
+          << " Its results are discarded.";
+      G4Exception("G4ForkRunManager::DoEventLoop()", "Run0136", JustWarning,
+                  msg);
+      runAborted = true;
+      continue;
+    }
+    std::istringstream in(buf);
+    MergeResults(in);
+  }
+
+  TerminateEventLoop();
+#endif
+}
+
+// --------------------------------------------------------------------
+void G4ForkRunManager::ChildEventLoop(G4int firstEvent, G4int lastEvent)
+{
+  for(G4int i_event = firstEvent; i_event < lastEvent; ++i_event)
+  {
+    long evtSeeds[3] = { 0, 0, 0 };
+    DeriveEventSeeds(i_event, evtSeeds);
+    G4Random::setTheSeeds(evtSeeds, -1);
+    ProcessOneEvent(i_event);
+    TerminateOneEvent();
+    if(runAborted)
+      break;
+  }
+}
+
+// --------------------------------------------------------------------
+void G4ForkRunManager::DeriveEventSeeds(G4int eventID, long* seeds) const
+{
+  std::uint64_t key =
+    G4SplitMix64(G4SplitMix64(G4SplitMix64(std::uint64_t(runSeeds[0])) ^
+                              std::uint64_t(runSeeds[1])) ^
+                 std::uint64_t(eventID));
+  G4DeriveSeeds(key, 2, seeds);
+}
@@ -45,6 +45,10 @@
 #include "G4VUserActionInitialization.hh"
 #include "G4WorkerRunManager.hh"
 #include "G4WorkerThread.hh"
+#include "G4PhysicsTableReplicas.hh"
+#include "G4RandomTools.hh"
+
+#include <cstdint>
 
 G4ScoringManager* G4MTRunManager::masterScM = nullptr;
 G4MTRunManager::masterWorlds_t G4MTRunManager::masterWorlds
@@ -425,7 +429,20 @@ void G4MTRunManager::InitializeEventLoop(G4int n_event, const char* macroFile,
       if(eventModulo < 1)
         eventModulo = 1;
     }
-    if(InitializeSeeds(n_event) == false && n_event > 0)
+    G4bool seedsInitialized = InitializeSeeds(n_event);
+    if(counterBasedSeeding)
+    {
+      if(seedsInitialized)
+      {
+        G4Exception("G4MTRunManager::InitializeEventLoop()", "Run10038",
+                    JustWarning,
+                    "Counter-based seeding is set: the seeds filled by "
+                    "InitializeSeeds() are not used.");
+      }
+      runSeed     = (G4long) (100000000L * masterRNGEngine->flat());
+      runIDOfSeed = (currentRun != nullptr) ? currentRun->GetRunID() : 0;
+    }
+    else if(!seedsInitialized && n_event > 0)
     {
       G4RNGHelper* helper = G4RNGHelper::GetInstance();
       switch(seedOncePerCommunication)
@@ -509,6 +526,8 @@ void G4MTRunManager::RunTermination()
 
   // Wait now for all threads to finish event-loop
   WaitForEndEventLoopWorkers();
+  if(numaMode > 1 && verboseLevel > 0)
+    G4PhysicsTableReplicas::Instance()->Report(G4cout);
   // Now call base-class methof
   G4RunManager::TerminateEventLoop();
   G4RunManager::RunTermination();
@@ -641,7 +660,7 @@ G4bool G4MTRunManager::SetUpAnEvent(G4Event* evt, long& s1, long& s2, long& s3,
   if(numberOfEventProcessed < numberOfEventToBeProcessed)
   {
     evt->SetEventID(numberOfEventProcessed);
-    if(reseedRequired)
+    if(reseedRequired && !counterBasedSeeding)
     {
       G4RNGHelper* helper = G4RNGHelper::GetInstance();
       G4int idx_rndm      = nSeedsPerEvent * nSeedsUsed;
@@ -672,7 +691,7 @@ G4int G4MTRunManager::SetUpNEvents(G4Event* evt, G4SeedsQueue* seedsQueue,
       nev = numberOfEventToBeProcessed - numberOfEventProcessed;
     }
     evt->SetEventID(numberOfEventProcessed);
-    if(reseedRequired)
+    if(reseedRequired && !counterBasedSeeding)
     {
       G4RNGHelper* helper = G4RNGHelper::GetInstance();
       G4int nevRnd        = nev;
@@ -695,6 +714,16 @@ G4int G4MTRunManager::SetUpNEvents(G4Event* evt, G4SeedsQueue* seedsQueue,
   return 0;
 }
 
+// --------------------------------------------------------------------
+void G4MTRunManager::DeriveEventSeeds(G4int eventID, G4long* seeds) const
+{
+  std::uint64_t key =
+    G4SplitMix64(G4SplitMix64(G4SplitMix64(std::uint64_t(runSeed)) ^
+                              std::uint64_t(runIDOfSeed)) ^
+                 std::uint64_t(eventID));
+  G4DeriveSeeds(key, nSeedsPerEvent, seeds);
+}
+
 // --------------------------------------------------------------------
 void G4MTRunManager::TerminateWorkers()
 {
@@ -814,3 +843,16 @@ void G4MTRunManager::SetPinAffinity(G4int n)
   pinAffinity = n;
   return;
 }
+
+// --------------------------------------------------------------------
+void G4MTRunManager::SetNumaMode(G4int n)
+{
+  if(n < 0 || n > 2)
+  {
+    G4Exception("G4MTRunManager::SetNumaMode", "Run0134", FatalException,
+                "NUMA mode must be 0, 1 or 2.");
+  }
+  numaMode = n;
+  // the tables of the master are allocated on the node of this thread
+  G4PhysicsTableReplicas::Instance()->SetEnabled(numaMode > 1);
+}
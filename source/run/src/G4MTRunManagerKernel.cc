@@ -160,7 +160,10 @@ void G4MTRunManagerKernel::StartThread(G4WorkerThread* context)
   // Optimization: optional
   //============================
   // Enforce thread affinity if requested
-  wThreadContext->SetPinAffinity(masterRM->GetPinAffinity());
+  if(masterRM->GetNumaMode() > 0)
+    wThreadContext->SetNumaAffinity();
+  else
+    wThreadContext->SetPinAffinity(masterRM->GetPinAffinity());
 
   //============================
   // Step-1: Random number engine
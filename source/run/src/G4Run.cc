@@ -74,6 +74,20 @@ void G4Run::Merge(const G4Run* right)
   }
 }
 
+// --------------------------------------------------------------------
+void G4Run::WriteForMerge(std::ostream& out) const
+{
+  out.write(reinterpret_cast<const char*>(&numberOfEvent), sizeof(G4int));
+}
+
+// --------------------------------------------------------------------
+void G4Run::MergeFromStream(std::istream& in)
+{
+  G4int nEvent = 0;
+  in.read(reinterpret_cast<char*>(&nEvent), sizeof(G4int));
+  numberOfEvent += nEvent;
+}
+
 // --------------------------------------------------------------------
 void G4Run::StoreEvent(G4Event* evt)
 {
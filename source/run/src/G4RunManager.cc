@@ -28,6 +28,8 @@
 // Original author: M.Asai, 1996
 // --------------------------------------------------------------------
 
+#include <cstdio>
+#include <fstream>
 #include <sstream>
 
 #include "G4Timer.hh"
@@ -37,6 +39,8 @@
 #include "G4RunManagerKernel.hh"
 #include "G4WorkerRunManagerKernel.hh"
 
+#include "G4Accumulable.hh"
+#include "G4AccumulableManager.hh"
 #include "G4ApplicationState.hh"
 #include "G4Material.hh"
 #include "G4ParallelWorldProcessStore.hh"
@@ -46,6 +50,7 @@
 #include "G4Run.hh"
 #include "G4RunMessenger.hh"
 #include "G4SDManager.hh"
+#include "G4SteppingProfiler.hh"
 #include "G4StateManager.hh"
 #include "G4TiMemory.hh"
 #include "G4UImanager.hh"
@@ -71,6 +76,8 @@
 #include "G4ParticleTable.hh"
 #include "G4ProcessManager.hh"
 #include "G4ScoringManager.hh"
+#include "G4StatDouble.hh"
+#include "G4THitsMap.hh"
 #include "G4TransportationManager.hh"
 #include "G4VHitsCollection.hh"
 #include "G4VScoringMesh.hh"
@@ -97,6 +104,39 @@ using namespace CLHEP;
 #  undef theParticleIterator
 #endif
 
+namespace
+{
+  template <typename T>
+  void WriteValue(std::ostream& out, const T& val)
+  {
+    out.write(reinterpret_cast<const char*>(&val), sizeof(T));
+  }
+
+  template <typename T>
+  T ReadValue(std::istream& in)
+  {
+    T val = T();
+    in.read(reinterpret_cast<char*>(&val), sizeof(T));
+    return val;
+  }
+
+  // Rebuilds a G4StatDouble from its sums
+  class G4StatDoubleSums : public G4StatDouble
+  {
+    public:
+      G4StatDoubleSums(std::istream& in)
+      {
+        m_n       = ReadValue<G4int>(in);
+        m_sum_w   = ReadValue<G4double>(in);
+        m_sum_w2  = ReadValue<G4double>(in);
+        m_sum_wx  = ReadValue<G4double>(in);
+        m_sum_wx2 = ReadValue<G4double>(in);
+      }
+  };
+
+  const char checkpointTag[8] = "G4CKPT1";
+}  // namespace
+
 G4ThreadLocal G4RunManager* G4RunManager::fRunManager = nullptr;
 
 G4bool G4RunManager::fGeometryHasBeenDestroyed = false;
@@ -414,13 +454,20 @@ void G4RunManager::DoEventLoop(G4int n_event, const char* macroFile,
 {
   InitializeEventLoop(n_event, macroFile, n_select);
 
+  G4int firstEvent = 0;
+  if(!restartFile.empty())
+    firstEvent = RestoreCheckpoint(n_event);
+
   // Event loop
-  for(G4int i_event = 0; i_event < n_event; ++i_event)
+  for(G4int i_event = firstEvent; i_event < n_event; ++i_event)
   {
     ProcessOneEvent(i_event);
     TerminateOneEvent();
     if(runAborted)
       break;
+    if(checkpointInterval > 0 && runManagerType == sequentialRM &&
+       (i_event + 1) % checkpointInterval == 0 && i_event + 1 < n_event)
+      WriteCheckpoint();
   }
 
   // For G4MTRunManager, TerminateEventLoop() is invoked after all threads are
@@ -544,6 +591,275 @@ void G4RunManager::StoreRNGStatus(const G4String& fnpref)
   G4Random::saveEngineStatus(fileN);
 }
 
+// --------------------------------------------------------------------
+void G4RunManager::WriteResults(std::ostream& out) const
+{
+  WriteValue(out, numberOfEventProcessed);
+
+  // accumulables
+  G4AccumulableManager* accManager = G4AccumulableManager::Instance();
+  G4int nAcc = accManager->GetNofAccumulables();
+  WriteValue(out, nAcc);
+  for(G4int i = 0; i < nAcc; ++i)
+  {
+    G4VAccumulable* acc = accManager->GetAccumulable(i);
+    if(auto dAcc = dynamic_cast<G4Accumulable<G4double>*>(acc))
+    {
+      WriteValue(out, 'd');
+      WriteValue(out, dAcc->GetValue());
+    }
+    else if(auto iAcc = dynamic_cast<G4Accumulable<G4int>*>(acc))
+    {
+      WriteValue(out, 'i');
+      WriteValue(out, iAcc->GetValue());
+    }
+    else
+    {
+      WriteValue(out, 'x');
+    }
+  }
+
+  // scoring meshes
+  G4ScoringManager* ScM = G4ScoringManager::GetScoringManagerIfExist();
+  G4int nMesh = (ScM != nullptr) ? G4int(ScM->GetNumberOfMesh()) : 0;
+  WriteValue(out, nMesh);
+  for(G4int iMesh = 0; iMesh < nMesh; ++iMesh)
+  {
+    const auto scoreMap = ScM->GetMesh(iMesh)->GetScoreMap();
+    WriteValue(out, G4int(scoreMap.size()));
+    for(const auto& score : scoreMap)
+    {
+      const auto map = score.second->GetMap();
+      WriteValue(out, G4int(map->size()));
+      for(const auto& itr : *map)
+      {
+        WriteValue(out, itr.first);
+        WriteValue(out, itr.second->n());
+        WriteValue(out, itr.second->sum_w());
+        WriteValue(out, itr.second->sum_w2());
+        WriteValue(out, itr.second->sum_wx());
+        WriteValue(out, itr.second->sum_wx2());
+      }
+    }
+  }
+
+  // user's run
+  if(currentRun != nullptr)
+    currentRun->WriteForMerge(out);
+}
+
+// --------------------------------------------------------------------
+void G4RunManager::MergeResults(std::istream& in)
+{
+  // Entries which do not match the objects of this process are read and
+  // dropped, so that the rest of the stream is still merged
+  G4ExceptionDescription mismatch;
+
+  numberOfEventProcessed += ReadValue<G4int>(in);
+
+  G4AccumulableManager* accManager = G4AccumulableManager::Instance();
+  G4int nAcc = ReadValue<G4int>(in);
+  if(in && nAcc != accManager->GetNofAccumulables())
+  {
+    mismatch << "  " << nAcc << " accumulables read, "
+             << accManager->GetNofAccumulables() << " registered.\n";
+  }
+  for(G4int i = 0; i < nAcc && in; ++i)
+  {
+    G4VAccumulable* acc = (i < accManager->GetNofAccumulables())
+                          ? accManager->GetAccumulable(i) : nullptr;
+    char type = ReadValue<char>(in);
+    if(type == 'd')
+    {
+      G4double value = ReadValue<G4double>(in);
+      if(auto dAcc = dynamic_cast<G4Accumulable<G4double>*>(acc))
+      {
+        G4Accumulable<G4double> other(value, dAcc->GetMergeMode());
+        dAcc->Merge(other);
+      }
+      else if(acc != nullptr)
+      {
+        mismatch << "  accumulable " << i << " is not of type G4double.\n";
+      }
+    }
+    else if(type == 'i')
+    {
+      G4int value = ReadValue<G4int>(in);
+      if(auto iAcc = dynamic_cast<G4Accumulable<G4int>*>(acc))
+      {
+        G4Accumulable<G4int> other(value, iAcc->GetMergeMode());
+        iAcc->Merge(other);
+      }
+      else if(acc != nullptr)
+      {
+        mismatch << "  accumulable " << i << " is not of type G4int.\n";
+      }
+    }
+  }
+
+  G4ScoringManager* ScM = G4ScoringManager::GetScoringManagerIfExist();
+  G4int nMesh = ReadValue<G4int>(in);
+  G4int nMeshHere = (ScM != nullptr) ? G4int(ScM->GetNumberOfMesh()) : 0;
+  if(in && nMesh != nMeshHere)
+  {
+    mismatch << "  " << nMesh << " scoring meshes read, " << nMeshHere
+             << " defined.\n";
+  }
+  for(G4int iMesh = 0; iMesh < nMesh && in; ++iMesh)
+  {
+    G4int nScore = ReadValue<G4int>(in);
+    G4VScoringMesh::MeshScoreMap scoreMap;
+    if(iMesh < nMeshHere)
+    {
+      scoreMap = ScM->GetMesh(iMesh)->GetScoreMap();
+      if(in && nScore != G4int(scoreMap.size()))
+      {
+        mismatch << "  mesh " << iMesh << ": " << nScore
+                 << " quantities read, " << scoreMap.size()
+                 << " defined.\n";
+        scoreMap.clear();
+      }
+    }
+    auto score = scoreMap.cbegin();
+    for(G4int iScore = 0; iScore < nScore && in; ++iScore)
+    {
+      G4int nEntry = ReadValue<G4int>(in);
+      for(G4int iEntry = 0; iEntry < nEntry && in; ++iEntry)
+      {
+        G4int idx = ReadValue<G4int>(in);
+        G4StatDoubleSums sums(in);
+        G4StatDouble& val = sums;
+        if(score != scoreMap.cend()) { score->second->add(idx, val); }
+      }
+      if(score != scoreMap.cend()) { ++score; }
+    }
+  }
+
+  if(currentRun != nullptr && in)
+    currentRun->MergeFromStream(in);
+
+  if(!in)
+  {
+    G4Exception("G4RunManager::MergeResults()", "Run0137", JustWarning,
+                "Results read from the stream are truncated.");
+  }
+  else if(!mismatch.str().empty())
+  {
+    G4ExceptionDescription ed;
+    ed << "Results read from the stream do not match the accumulables\n"
+       << "and scoring meshes of this process. Not merged:\n"
+       << mismatch.str();
+    G4Exception("G4RunManager::MergeResults()", "Run0143", JustWarning, ed);
+  }
+}
+
+// --------------------------------------------------------------------
+void G4RunManager::SetCheckpoint(G4int interval, const G4String& fileName)
+{
+  if(runManagerType != sequentialRM && interval > 0)
+  {
+    G4Exception("G4RunManager::SetCheckpoint()", "Run0138", JustWarning,
+                "Checkpointing is available only in sequential mode. "
+                "Command ignored.");
+    return;
+  }
+  checkpointInterval = (interval > 0) ? interval : 0;
+  if(!fileName.empty())
+    checkpointFile = fileName;
+}
+
+// --------------------------------------------------------------------
+void G4RunManager::WriteCheckpoint()
+{
+  // written to a temporary file first, so that a job killed while
+  // writing leaves the previous checkpoint intact
+  G4String tmpFile = checkpointFile + ".tmp";
+  {
+    std::ofstream out(tmpFile, std::ios::binary | std::ios::trunc);
+    out.write(checkpointTag, sizeof(checkpointTag));
+    WriteValue(out, currentRun->GetRunID());
+    WriteValue(out, numberOfEventToBeProcessed);
+
+    std::ostringstream rndm;
+    G4Random::saveFullState(rndm);
+    const std::string& state = rndm.str();
+    WriteValue(out, G4int(state.size()));
+    out.write(state.data(), state.size());
+
+    WriteResults(out);
+    if(!out)
+    {
+      G4ExceptionDescription msg;
+      msg << "Cannot write checkpoint file <" << tmpFile << ">.";
+      G4Exception("G4RunManager::WriteCheckpoint()", "Run0139", JustWarning,
+                  msg);
+      return;
+    }
+  }
+#ifdef WIN32
+  std::remove(checkpointFile.c_str());
+#endif
+  if(std::rename(tmpFile.c_str(), checkpointFile.c_str()) != 0)
+  {
+    G4ExceptionDescription msg;
+    msg << "Cannot rename <" << tmpFile << "> to <" << checkpointFile << ">.";
+    G4Exception("G4RunManager::WriteCheckpoint()", "Run0139", JustWarning,
+                msg);
+    return;
+  }
+  if(verboseLevel > 0)
+  {
+    G4cout << "Checkpoint of run " << currentRun->GetRunID() << " written to "
+           << checkpointFile << " after " << numberOfEventProcessed
+           << " events." << G4endl;
+  }
+}
+
+// --------------------------------------------------------------------
+G4int G4RunManager::RestoreCheckpoint(G4int n_event)
+{
+  G4String fileName = restartFile;
+  restartFile       = "";
+
+  std::ifstream in(fileName, std::ios::binary);
+  char tag[sizeof(checkpointTag)] = { 0 };
+  in.read(tag, sizeof(tag));
+  if(!in || std::string(tag) != checkpointTag)
+  {
+    G4ExceptionDescription msg;
+    msg << "<" << fileName << "> is not a valid checkpoint file."
+        << " The run starts from the first event.";
+    G4Exception("G4RunManager::RestoreCheckpoint()", "Run0140", JustWarning,
+                msg);
+    return 0;
+  }
+  G4int runID   = ReadValue<G4int>(in);
+  G4int nEvents = ReadValue<G4int>(in);
+  if(nEvents != n_event)
+  {
+    G4ExceptionDescription msg;
+    msg << "Run " << runID << " saved in <" << fileName << "> has " << nEvents
+        << " events to be processed, while " << n_event
+        << " are requested.";
+    G4Exception("G4RunManager::RestoreCheckpoint()", "Run0141", JustWarning,
+                msg);
+  }
+
+  G4int stateSize = ReadValue<G4int>(in);
+  std::string state(stateSize, '\0');
+  in.read(&state[0], stateSize);
+  std::istringstream rndm(state);
+  G4Random::restoreFullState(rndm);
+
+  MergeResults(in);
+  if(verboseLevel > 0)
+  {
+    G4cout << "Run " << runID << " restored from " << fileName << " after "
+           << numberOfEventProcessed << " events." << G4endl;
+  }
+  return numberOfEventProcessed;
+}
+
 // --------------------------------------------------------------------
 void G4RunManager::AnalyzeEvent(G4Event* anEvent)
 {
@@ -580,6 +896,11 @@ void G4RunManager::RunTermination()
       }
     }
     ++runIDCounter;
+    // worker tables are merged by the master or sequential run manager
+    if(runManagerType != workerRM && G4SteppingProfiler::GetLevel() > 0)
+    {
+      G4SteppingProfiler::Report();
+    }
   }
 
   kernel->RunTermination();
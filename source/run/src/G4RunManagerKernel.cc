@@ -76,6 +76,7 @@
 
 #include "G4AutoLock.hh"
 #include "G4RNGHelper.hh"
+#include "G4PhysicsTableReplicas.hh"
 
 #ifdef G4BT_DEBUG
 #  include "G4Backtrace.hh"
@@ -903,6 +904,8 @@ void G4RunManagerKernel::BuildPhysicsTables(G4bool fakeRun)
       // make sure workers also rebuild physics tables
       G4UImanager* pUImanager = G4UImanager::GetUIpointer();
       pUImanager->ApplyCommand("/run/physicsModified");
+      // NUMA replicas of the tables to be rebuilt are obsolete
+      G4PhysicsTableReplicas::Instance()->Clear();
     }
   #endif
     physicsList->BuildPhysicsTable();
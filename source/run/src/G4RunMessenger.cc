@@ -32,6 +32,7 @@
 
 #include "G4RunMessenger.hh"
 #include "G4MTRunManager.hh"
+#include "G4ForkRunManager.hh"
 #include "G4MaterialScanner.hh"
 #include "G4ProductionCutsTable.hh"
 #include "G4RunManager.hh"
@@ -107,9 +108,10 @@ G4RunMessenger::G4RunMessenger(G4RunManager* runMgr)
 
   nThreadsCmd = new G4UIcmdWithAnInteger("/run/numberOfThreads", this);
   nThreadsCmd->SetGuidance("Set the number of threads to be used.");
+  nThreadsCmd->SetGuidance("With G4ForkRunManager, set the number of processes.");
   nThreadsCmd->SetGuidance("This command works only in PreInit state.");
   nThreadsCmd->SetGuidance(
-    "This command is valid only for multi-threaded mode.");
+    "This command is valid only for multi-threaded and multi-process modes.");
   nThreadsCmd->SetGuidance(
     "The command is ignored if it is issued in sequential mode.");
   nThreadsCmd->SetParameterName("nThreads", true);
@@ -152,6 +154,27 @@ G4RunMessenger::G4RunMessenger(G4RunManager* runMgr)
   pinAffinityCmd->SetRange("pinAffinity > 0 || pinAffinity < 0");
   pinAffinityCmd->AvailableForStates(G4State_PreInit);
 
+  numaCmd = new G4UIcmdWithAnInteger("/run/numaMode", this);
+  numaCmd->SetGuidance("Set NUMA mode for worker threads.");
+  numaCmd->SetGuidance(" 0 : disabled (default)");
+  numaCmd->SetGuidance(
+    " 1 : pin each worker to the CPUs of one NUMA node, nodes being");
+  numaCmd->SetGuidance(
+    "     assigned in a round robin way. /run/pinAffinity is ignored.");
+  numaCmd->SetGuidance(
+    " 2 : as 1, and the physics tables shared by the workers are");
+  numaCmd->SetGuidance(
+    "     replicated once per NUMA node. The memory cost of the copies");
+  numaCmd->SetGuidance("     is reported at the end of each run.");
+  numaCmd->SetGuidance("This command works only in PreInit state.");
+  numaCmd->SetGuidance(
+    "This command is ignored if it is issued in sequential mode.");
+  numaCmd->SetParameterName("mode", true);
+  numaCmd->SetDefaultValue(1);
+  numaCmd->SetRange("mode >= 0 && mode <= 2");
+  numaCmd->SetToBeBroadcasted(false);
+  numaCmd->AvailableForStates(G4State_PreInit);
+
   evModCmd = new G4UIcommand("/run/eventModulo", this);
   evModCmd->SetGuidance(
     "Set the event modulo for dispatching events to worker threads");
@@ -210,6 +233,60 @@ G4RunMessenger::G4RunMessenger(G4RunManager* runMgr)
   evModCmd->SetToBeBroadcasted(false);
   evModCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
 
+  cntSeedCmd = new G4UIcmdWithABool("/run/counterBasedSeeds", this);
+  cntSeedCmd->SetGuidance(
+    "Derive the seeds of each event from the run seed, the run ID and the");
+  cntSeedCmd->SetGuidance(
+    "event ID, instead of generating the seeds of all events in advance");
+  cntSeedCmd->SetGuidance(
+    "by the master G4MTRunManager. Worker threads compute the seeds of");
+  cntSeedCmd->SetGuidance(
+    "their events themselves. Every event is seeded whatever seedOnce of");
+  cntSeedCmd->SetGuidance(
+    "/run/eventModulo, so that event reproducibility is guaranteed");
+  cntSeedCmd->SetGuidance(
+    "regardless of number of threads.");
+  cntSeedCmd->SetGuidance(
+    "Note that the random number sequences differ from the default scheme.");
+  cntSeedCmd->SetGuidance("This command is valid only for multi-threaded mode.");
+  cntSeedCmd->SetParameterName("flag", true);
+  cntSeedCmd->SetDefaultValue(true);
+  cntSeedCmd->SetToBeBroadcasted(false);
+  cntSeedCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  ckptCmd = new G4UIcommand("/run/checkpoint", this);
+  ckptCmd->SetGuidance("Write a checkpoint of the run every N events.");
+  ckptCmd->SetGuidance(
+    "The number of processed events, the status of the random number");
+  ckptCmd->SetGuidance(
+    "engine, the accumulables, the scoring meshes and the data written by");
+  ckptCmd->SetGuidance(
+    "G4Run::WriteForMerge() are saved. The run can be resumed from this");
+  ckptCmd->SetGuidance("file with /run/restart.");
+  ckptCmd->SetGuidance("N = 0 disables checkpointing (default).");
+  ckptCmd->SetGuidance("This command is valid only for sequential mode.");
+  G4UIparameter* ckp1 = new G4UIparameter("N", 'i', false);
+  ckp1->SetParameterRange("N >= 0");
+  ckptCmd->SetParameter(ckp1);
+  G4UIparameter* ckp2 = new G4UIparameter("fileName", 's', true);
+  ckp2->SetDefaultValue("G4checkpoint.dat");
+  ckptCmd->SetParameter(ckp2);
+  ckptCmd->SetToBeBroadcasted(false);
+  ckptCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
+  restartCmd = new G4UIcmdWithAString("/run/restart", this);
+  restartCmd->SetGuidance(
+    "Resume the run saved in a checkpoint file at the next /run/beamOn.");
+  restartCmd->SetGuidance(
+    "The saved results are restored and the event loop starts after the");
+  restartCmd->SetGuidance(
+    "last saved event. /run/beamOn must be issued with the same number of");
+  restartCmd->SetGuidance("events and the same settings as the saved run.");
+  restartCmd->SetParameterName("fileName", true);
+  restartCmd->SetDefaultValue("G4checkpoint.dat");
+  restartCmd->SetToBeBroadcasted(false);
+  restartCmd->AvailableForStates(G4State_PreInit, G4State_Idle);
+
   dumpRegCmd = new G4UIcmdWithAString("/run/dumpRegion", this);
   dumpRegCmd->SetGuidance("Dump region information.");
   dumpRegCmd->SetGuidance(
@@ -420,7 +497,11 @@ G4RunMessenger::~G4RunMessenger()
   delete nThreadsCmd;
   delete maxThreadsCmd;
   delete pinAffinityCmd;
+  delete numaCmd;
   delete evModCmd;
+  delete cntSeedCmd;
+  delete ckptCmd;
+  delete restartCmd;
   delete optCmd;
   delete dumpRegCmd;
   delete dumpCoupleCmd;
@@ -485,6 +566,11 @@ void G4RunMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
       static_cast<G4MTRunManager*>(runManager)
         ->SetNumberOfThreads(nThreadsCmd->GetNewIntValue(newValue));
     }
+    else if(auto forkRM = dynamic_cast<G4ForkRunManager*>(runManager))
+    {
+      // number of child processes
+      forkRM->SetNumberOfProcesses(nThreadsCmd->GetNewIntValue(newValue));
+    }
     else if(rmType == G4RunManager::sequentialRM)
     {
       G4cout << "*** /run/numberOfThreads command is issued in sequential mode."
@@ -536,6 +622,25 @@ void G4RunMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
                   "/run/pinAffinity command is issued to local thread.");
     }
   }
+  else if(command == numaCmd)
+  {
+    G4RunManager::RMType rmType = runManager->GetRunManagerType();
+    if(rmType == G4RunManager::masterRM)
+    {
+      static_cast<G4MTRunManager*>(runManager)
+        ->SetNumaMode(numaCmd->GetNewIntValue(newValue));
+    }
+    else if(rmType == G4RunManager::sequentialRM)
+    {
+      G4cout << "*** /run/numaMode command is issued in sequential mode."
+             << "\nCommand is ignored." << G4endl;
+    }
+    else
+    {
+      G4Exception("G4RunMessenger::ApplyNewCommand", "Run0904", FatalException,
+                  "/run/numaMode command is issued to local thread.");
+    }
+  }
   else if(command == evModCmd)
   {
     G4RunManager::RMType rmType = runManager->GetRunManagerType();
@@ -560,6 +665,37 @@ void G4RunMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
                   "/run/eventModulo command is issued to local thread.");
     }
   }
+  else if(command == cntSeedCmd)
+  {
+    G4RunManager::RMType rmType = runManager->GetRunManagerType();
+    if(rmType == G4RunManager::masterRM)
+    {
+      static_cast<G4MTRunManager*>(runManager)
+        ->SetCounterBasedSeeding(cntSeedCmd->GetNewBoolValue(newValue));
+    }
+    else if(rmType == G4RunManager::sequentialRM)
+    {
+      G4cout << "*** /run/counterBasedSeeds command is issued in sequential"
+             << " mode.\nCommand is ignored." << G4endl;
+    }
+    else
+    {
+      G4Exception("G4RunMessenger::ApplyNewCommand", "Run0903", FatalException,
+                  "/run/counterBasedSeeds command is issued to local thread.");
+    }
+  }
+  else if(command == ckptCmd)
+  {
+    G4int interval = 0;
+    G4String fileName;
+    std::istringstream is(newValue);
+    is >> interval >> fileName;
+    runManager->SetCheckpoint(interval, fileName);
+  }
+  else if(command == restartCmd)
+  {
+    runManager->SetRestartFile(newValue);
+  }
   else if(command == dumpRegCmd)
   {
     if(newValue == "**ALL**")
@@ -737,6 +873,10 @@ G4String G4RunMessenger::GetCurrentValue(G4UIcommand* command)
       cv = nThreadsCmd->ConvertToString(
         static_cast<G4MTRunManager*>(runManager)->GetNumberOfThreads());
     }
+    else if(auto forkRM = dynamic_cast<G4ForkRunManager*>(runManager))
+    {
+      cv = nThreadsCmd->ConvertToString(forkRM->GetNumberOfProcesses());
+    }
     else if(rmType == G4RunManager::sequentialRM)
     {
       cv = "0";
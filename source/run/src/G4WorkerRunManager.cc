@@ -344,7 +344,11 @@ G4Event* G4WorkerRunManager::GenerateEvent(G4int i_event)
   G4long s2                   = 0;
   G4long s3                   = 0;
   G4bool eventHasToBeSeeded = true;
-  if(G4MTRunManager::SeedOncePerCommunication() == 1 && runIsSeeded)
+  G4MTRunManager* mrm       = G4MTRunManager::GetMasterRunManager();
+  // counter-based seeds are derived for every event, whatever the
+  // seedOncePerCommunication mode
+  if(G4MTRunManager::SeedOncePerCommunication() == 1 && runIsSeeded
+     && !mrm->IsCounterBasedSeeding())
   {
     eventHasToBeSeeded = false;
   }
@@ -376,12 +380,15 @@ G4Event* G4WorkerRunManager::GenerateEvent(G4int i_event)
       }
       else
       {
-        if(G4MTRunManager::SeedOncePerCommunication() > 0)
+        // counter-based seeds are derived per event, as for eventModulo 1
+        if(G4MTRunManager::SeedOncePerCommunication() > 0 &&
+           !mrm->IsCounterBasedSeeding())
           eventHasToBeSeeded = false;
         anEvent->SetEventID(++currEvID);
         --nevModulo;
       }
-      if(eventLoopOnGoing && eventHasToBeSeeded)
+      if(eventLoopOnGoing && eventHasToBeSeeded &&
+         !mrm->IsCounterBasedSeeding())
       {
         s1 = seedsQueue.front();
         seedsQueue.pop();
@@ -396,7 +403,7 @@ G4Event* G4WorkerRunManager::GenerateEvent(G4int i_event)
       return nullptr;
     }
   }
-  else if(eventHasToBeSeeded)
+  else if(eventHasToBeSeeded && !mrm->IsCounterBasedSeeding())
   {
     // Need to reseed random number generator
     G4RNGHelper* helper = G4RNGHelper::GetInstance();
@@ -404,6 +411,14 @@ G4Event* G4WorkerRunManager::GenerateEvent(G4int i_event)
     s2                  = helper->GetSeed(i_event * 2 + 1);
   }
 
+  if(eventHasToBeSeeded && mrm->IsCounterBasedSeeding())
+  {
+    G4long evtSeeds[3] = { 0, 0, 0 };
+    mrm->DeriveEventSeeds(anEvent->GetEventID(), evtSeeds);
+    s1 = evtSeeds[0];
+    s2 = evtSeeds[1];
+  }
+
   if(eventHasToBeSeeded)
   {
     G4long seeds[3] = { s1, s2, 0 };
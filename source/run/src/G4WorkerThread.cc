@@ -254,3 +254,21 @@ void G4WorkerThread::SetPinAffinity(G4int affinity) const
   }
 #endif
 }
+
+// --------------------------------------------------------------------
+void G4WorkerThread::SetNumaAffinity() const
+{
+#if !defined(WIN32)
+  G4int node = GetThreadId() % G4Threading::G4GetNumberOfNumaNodes();
+#  if defined(G4MULTITHREADED)
+  G4NativeThread t = pthread_self();
+#  else
+  G4NativeThread t;
+#  endif
+  if(!G4Threading::G4SetNumaAffinity(node, t))
+  {
+    G4Exception("G4WorkerThread::SetNumaAffinity()", "Run0133", JustWarning,
+                "Cannot set NUMA node affinity.");
+  }
+#endif
+}
@@ -57,6 +57,8 @@ enum class G4RunManagerType : G4int
   TaskingOnly = 5,
   TBB         = 6,
   TBBOnly     = 7,
+  Fork        = 8,
+  ForkOnly    = 9,
   Default
 };
 
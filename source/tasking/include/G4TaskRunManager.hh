@@ -51,6 +51,7 @@
 
 #include "PTL/TaskRunManager.hh"
 
+#include <deque>
 #include <list>
 #include <map>
 
@@ -60,6 +61,7 @@ class G4UserTaskInitialization;
 class G4UserTaskThreadInitialization;
 class G4WorkerTaskRunManager;
 class G4RunManagerFactory;
+class G4SubEvent;
 
 //============================================================================//
 
@@ -144,6 +146,32 @@ class G4TaskRunManager
   // thread must delete that G4Event.
   virtual G4int SetUpNEvents(G4Event*, G4SeedsQueue* seedsQueue,
                              G4bool reseedRequired = true) override;
+  // Used instead of the two methods above when adaptive scheduling is
+  // active (see SetAdaptiveScheduling()). Each worker owns a range of
+  // consecutive events which it consumes one event at a time. When the
+  // pool of events left is empty, a worker with an empty range steals the
+  // upper half of the largest range of another worker. Seeds stay attached
+  // to their event ID, so that results do not depend on which worker
+  // processes an event. False is returned if no more event is to be
+  // processed.
+  G4bool SetUpAnAdaptiveEvent(G4Event*, G4long& s1, G4long& s2, G4long& s3);
+
+  // Adaptive (guided) scheduling: the size of the range of events given to
+  // a worker is the number of events left divided by twice the number of
+  // threads, bounded by the event modulo and by "minEvents", so that
+  // ranges shrink toward the end of the run, and idle workers steal events
+  // from busy ones. This mode requires seeds to be set for every event,
+  // i.e. SeedOncePerCommunication() == 0, otherwise it is ignored.
+  // It can also be enabled with the G4FORCE_ADAPTIVE_SCHEDULING environment
+  // variable.
+  void SetAdaptiveScheduling(G4bool val, G4int minEvents = 1)
+  {
+    adaptiveScheduling     = val;
+    minEventsPerAdaptRange = (minEvents > 0) ? minEvents : 1;
+  }
+  G4bool GetAdaptiveScheduling() const { return adaptiveScheduling; }
+  // True if adaptive scheduling is used for the current event loop
+  G4bool IsAdaptiveSchedulingActive() const { return adaptiveActive; }
 
   // Method called by Initialize() method
 
@@ -179,6 +207,12 @@ class G4TaskRunManager
   void MergeScores(const G4ScoringManager* localScoringManager);
   void MergeRun(const G4Run* localRun);
 
+  // To be invoked from G4WorkerTaskRunManager to offer a sub-event of
+  // the event being processed to another worker. False is returned if the
+  // sub-event cannot be dispatched, in which case it remains to be
+  // processed by the owner of the event.
+  G4bool AddSubEventTask(G4SubEvent* subEvent);
+
  public:
   virtual void RequestWorkersProcessCommandsStack() override;
   // Called to force workers to request and process the UI commands stack
@@ -225,6 +259,20 @@ class G4TaskRunManager
   // Pointer to the master thread random engine
   G4TaskRunManagerKernel* MTkernel = nullptr;
 
+  // adaptive scheduling
+  struct EventRange
+  {
+    G4int next = 0;
+    G4int end  = 0;
+    std::deque<G4long> seeds;
+  };
+  G4bool adaptiveScheduling    = false;
+  G4bool adaptiveActive        = false;
+  G4int minEventsPerAdaptRange = 1;
+  std::map<G4int, EventRange> eventRanges;
+  // Ranges of events owned by the workers, keyed by thread ID
+  G4int nStolenRanges = 0;
+
  protected:
   // Barriers: synch points between master and workers
   RunTaskGroup* workTaskGroup = nullptr;
@@ -60,6 +60,7 @@
 
 class G4WorkerThread;
 class G4WorkerTaskRunManager;
+class G4SubEvent;
 #include <vector>
 
 class G4TaskRunManagerKernel : public G4RunManagerKernel
@@ -74,6 +75,7 @@ class G4TaskRunManagerKernel : public G4RunManagerKernel
   static void InitializeWorker();
   static void ExecuteWorkerInit();
   static void ExecuteWorkerTask();
+  static void ExecuteWorkerSubEventTask(G4SubEvent*);
   static void TerminateWorkerRunEventLoop();
   static void TerminateWorker();
   static void TerminateWorkerRunEventLoop(G4WorkerTaskRunManager*);
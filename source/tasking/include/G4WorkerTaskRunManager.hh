@@ -44,6 +44,7 @@
 
 class G4WorkerThread;
 class G4WorkerTaskRunManagerKernel;
+class G4SubEvent;
 
 class G4WorkerTaskRunManager : public G4WorkerRunManager
 {
@@ -67,6 +68,8 @@ class G4WorkerTaskRunManager : public G4WorkerRunManager
   virtual void RunTermination() override;
   virtual void TerminateEventLoop() override;
   virtual void DoWork() override;
+  // Process a sub-event spawned by the event loop of another worker
+  virtual void DoSubEventWork(G4SubEvent* subEvent);
   virtual void RestoreRndmEachEvent(G4bool flag) override
   {
     readStatusFromFile = flag;
@@ -82,6 +85,8 @@ class G4WorkerTaskRunManager : public G4WorkerRunManager
 
  private:
   void SetupDefaultRNGEngine();
+  // Bring this worker up to date with the current run of the master
+  void PrepareNewRun();
 
  private:
   G4StrVector processedCommandStack;
@@ -28,6 +28,7 @@
 #include "G4RunManagerFactory.hh"
 #include "G4EnvironmentUtils.hh"
 #include "G4RunManager.hh"
+#include "G4ForkRunManager.hh"
 #include "G4MTRunManager.hh"
 #include "G4TaskRunManager.hh"
 #include "G4Threading.hh"
@@ -70,7 +71,8 @@ G4RunManager* G4RunManagerFactory::CreateRunManager(G4RunManagerType _type,
   if(_type == G4RunManagerType::SerialOnly ||
      _type == G4RunManagerType::MTOnly ||
      _type == G4RunManagerType::TaskingOnly ||
-     _type == G4RunManagerType::TBBOnly)
+     _type == G4RunManagerType::TBBOnly ||
+     _type == G4RunManagerType::ForkOnly)
   {
     // MUST fail if unavail in this case
     fail_if_unavail = true;
@@ -136,6 +138,11 @@ G4RunManager* G4RunManagerFactory::CreateRunManager(G4RunManagerType _type,
     case G4RunManagerType::TBB:
 #if defined(G4MULTITHREADED) && defined(GEANT4_USE_TBB)
       rm = new G4TaskRunManager(_queue, true);
+#endif
+      break;
+    case G4RunManagerType::Fork:
+#if !defined(WIN32)
+      rm = new G4ForkRunManager();
 #endif
       break;
     // "Only" types are not handled since they are converted above to main type
@@ -147,6 +154,8 @@ G4RunManager* G4RunManagerFactory::CreateRunManager(G4RunManagerType _type,
       break;
     case G4RunManagerType::TBBOnly:
       break;
+    case G4RunManagerType::ForkOnly:
+      break;
     case G4RunManagerType::Default:
       break;
   }
@@ -157,6 +166,9 @@ G4RunManager* G4RunManagerFactory::CreateRunManager(G4RunManagerType _type,
   auto mtrm = dynamic_cast<G4MTRunManager*>(rm);
   if(nthreads > 0 && mtrm)
     mtrm->SetNumberOfThreads(nthreads);
+  auto forkrm = dynamic_cast<G4ForkRunManager*>(rm);
+  if(nthreads > 0 && forkrm)
+    forkrm->SetNumberOfProcesses(nthreads);
 
   master_run_manager        = rm;
   mt_master_run_manager     = mtrm;
@@ -185,6 +197,9 @@ std::set<std::string> G4RunManagerFactory::GetOptions()
 {
   static auto _instance = []() {
     std::set<std::string> options = { "Serial" };
+#if !defined(WIN32)
+    options.insert("Fork");
+#endif
 #if defined(G4MULTITHREADED)
     options.insert({ "MT", "Tasking" });
 #  if defined(GEANT4_USE_TBB)
@@ -211,6 +226,8 @@ G4RunManagerType G4RunManagerFactory::GetType(const std::string& key)
     return G4RunManagerType::Tasking;
   else if(std::regex_match(key, std::regex("^(TBB).*", opts)))
     return G4RunManagerType::TBB;
+  else if(std::regex_match(key, std::regex("^(Fork).*", opts)))
+    return G4RunManagerType::Fork;
 
   return G4RunManagerType::Default;
 }
@@ -237,6 +254,10 @@ std::string G4RunManagerFactory::GetName(G4RunManagerType _type)
       return "TBB";
     case G4RunManagerType::TBBOnly:
       return "TBB";
+    case G4RunManagerType::Fork:
+      return "Fork";
+    case G4RunManagerType::ForkOnly:
+      return "Fork";
     default:
       break;
   };
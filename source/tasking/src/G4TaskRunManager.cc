@@ -51,7 +51,9 @@
 #include "G4UserTaskQueue.hh"
 #include "G4TiMemory.hh"
 #include "G4ThreadLocalSingleton.hh"
+#include "G4PhysicsTableReplicas.hh"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <iterator>
@@ -477,6 +479,17 @@ void G4TaskRunManager::AddEventTask(G4int nt)
 
 //============================================================================//
 
+G4bool G4TaskRunManager::AddSubEventTask(G4SubEvent* subEvent)
+{
+  if(workTaskGroup == nullptr || fakeRun)
+    return false;
+  workTaskGroup->exec(
+    [subEvent]() { G4TaskRunManagerKernel::ExecuteWorkerSubEventTask(subEvent); });
+  return true;
+}
+
+//============================================================================//
+
 void G4TaskRunManager::RefillSeeds()
 {
   G4RNGHelper* helper = G4RNGHelper::GetInstance();
@@ -538,13 +551,41 @@ void G4TaskRunManager::InitializeEventLoop(G4int n_event, const char* macroFile,
 
     ComputeNumberOfTasks();
 
+    adaptiveScheduling = G4GetEnv<G4bool>("G4FORCE_ADAPTIVE_SCHEDULING",
+                                          adaptiveScheduling);
+    adaptiveActive     = adaptiveScheduling;
+    if(adaptiveActive && SeedOncePerCommunication() != 0)
+    {
+      G4ExceptionDescription msgd;
+      msgd << "Adaptive scheduling requires seeds to be set for every event"
+           << " (seedOnce = 0 of /run/eventModulo). It is not used for this"
+           << " run.";
+      G4Exception("G4TaskRunManager::InitializeEventLoop()", "Run10037",
+                  JustWarning, msgd);
+      adaptiveActive = false;
+    }
+    eventRanges.clear();
+    nStolenRanges = 0;
+
     // initialize seeds
     // If user did not implement InitializeSeeds,
     // use default: nSeedsPerEvent seeds per event
 
-    if(n_event > 0)
+    G4bool _overload = (n_event > 0) && InitializeSeeds(n_event);
+    if(counterBasedSeeding)
+    {
+      if(_overload)
+      {
+        G4Exception("G4TaskRunManager::InitializeEventLoop()", "Run10038",
+                    JustWarning,
+                    "Counter-based seeding is set: the seeds filled by "
+                    "InitializeSeeds() are not used.");
+      }
+      runSeed     = (G4long) (100000000L * masterRNGEngine->flat());
+      runIDOfSeed = (currentRun != nullptr) ? currentRun->GetRunID() : 0;
+    }
+    else if(n_event > 0)
     {
-      G4bool _overload = InitializeSeeds(n_event);
       G4bool _functor  = false;
       if(!_overload)
         _functor = initSeedsCallback(n_event, nSeedsPerEvent, nSeedsFilled);
@@ -603,6 +644,11 @@ void G4TaskRunManager::RunTermination()
 
   // Wait now for all threads to finish event-loop
   WaitForEndEventLoopWorkers();
+  if(GetNumaMode() > 1 && verboseLevel > 0)
+    G4PhysicsTableReplicas::Instance()->Report(G4cout);
+  if(adaptiveActive && verboseLevel > 1)
+    G4cout << "G4TaskRunManager: " << nStolenRanges
+           << " ranges of events were stolen by idle workers." << G4endl;
   // Now call base-class methof
   G4RunManager::TerminateEventLoop();
   G4RunManager::RunTermination();
@@ -655,7 +701,7 @@ G4bool G4TaskRunManager::SetUpAnEvent(G4Event* evt, G4long& s1, G4long& s2,
   if(numberOfEventProcessed < numberOfEventToBeProcessed)
   {
     evt->SetEventID(numberOfEventProcessed);
-    if(reseedRequired)
+    if(reseedRequired && !counterBasedSeeding)
     {
       G4RNGHelper* helper = G4RNGHelper::GetInstance();
       G4int idx_rndm      = nSeedsPerEvent * nSeedsUsed;
@@ -690,7 +736,7 @@ G4int G4TaskRunManager::SetUpNEvents(G4Event* evt, G4SeedsQueue* seedsQueue,
     }
     evt->SetEventID(numberOfEventProcessed);
 
-    if(reseedRequired)
+    if(reseedRequired && !counterBasedSeeding)
     {
       G4RNGHelper* helper = G4RNGHelper::GetInstance();
       G4int nevRnd        = nmod;
@@ -715,6 +761,83 @@ G4int G4TaskRunManager::SetUpNEvents(G4Event* evt, G4SeedsQueue* seedsQueue,
 
 //============================================================================//
 
+G4bool G4TaskRunManager::SetUpAnAdaptiveEvent(G4Event* evt, G4long& s1,
+                                              G4long& s2, G4long& s3)
+{
+  G4AutoLock l(&setUpEventMutex);
+  if(runAborted)
+    return false;
+
+  EventRange& range = eventRanges[G4Threading::G4GetThreadId()];
+  if(range.next >= range.end)
+  {
+    range.seeds.clear();
+    G4int nLeft = numberOfEventToBeProcessed - numberOfEventProcessed;
+    if(nLeft > 0)
+    {
+      // guided: take a share of the events left
+      G4int nThreads = std::max<G4int>(GetNumberOfThreads(), 1);
+      G4int nevt     = nLeft / (2 * nThreads);
+      nevt           = std::min(nevt, eventModulo);
+      nevt           = std::max(nevt, minEventsPerAdaptRange);
+      nevt           = std::min(nevt, nLeft);
+
+      // with counter-based seeding the worker derives the seeds itself
+      G4RNGHelper* helper = G4RNGHelper::GetInstance();
+      for(G4int i = 0; i < nevt && !counterBasedSeeding; ++i)
+      {
+        for(G4int j = 0; j < nSeedsPerEvent; ++j)
+          range.seeds.push_back(helper->GetSeed(nSeedsPerEvent * nSeedsUsed + j));
+        ++nSeedsUsed;
+        if(nSeedsUsed == nSeedsFilled)
+          RefillSeeds();
+      }
+      range.next = numberOfEventProcessed;
+      range.end  = numberOfEventProcessed + nevt;
+      numberOfEventProcessed += nevt;
+    }
+    else
+    {
+      // steal the upper half of the largest range
+      EventRange* victim = nullptr;
+      for(auto& itr : eventRanges)
+      {
+        EventRange& r = itr.second;
+        if(r.end - r.next > 1 &&
+           (victim == nullptr || r.end - r.next > victim->end - victim->next))
+          victim = &r;
+      }
+      if(victim == nullptr)
+        return false;
+
+      G4int nSteal = (victim->end - victim->next) / 2;
+      range.end    = victim->end;
+      range.next   = victim->end - nSteal;
+      victim->end  = range.next;
+      auto first   = victim->seeds.end() - nSteal * nSeedsPerEvent;
+      range.seeds.assign(first, victim->seeds.end());
+      victim->seeds.erase(first, victim->seeds.end());
+      ++nStolenRanges;
+    }
+  }
+
+  evt->SetEventID(range.next++);
+  if(counterBasedSeeding)
+    return true;
+  s1 = range.seeds.front();
+  range.seeds.pop_front();
+  s2 = range.seeds.front();
+  range.seeds.pop_front();
+  if(nSeedsPerEvent == 3)
+  {
+    s3 = range.seeds.front();
+    range.seeds.pop_front();
+  }
+  return true;
+}
+
+//============================================================================//
+
 void G4TaskRunManager::TerminateWorkers()
 {
   // Force workers to execute (if any) all UI commands left in the stack
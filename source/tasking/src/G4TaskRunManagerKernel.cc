@@ -172,7 +172,10 @@ void G4TaskRunManagerKernel::InitializeWorker()
   // Optimization: optional
   //============================
   // Enforce thread affinity if requested
-  context()->SetPinAffinity(mrm->GetPinAffinity());
+  if(mrm->GetNumaMode() > 0)
+    context()->SetNumaAffinity();
+  else
+    context()->SetPinAffinity(mrm->GetPinAffinity());
 
   //============================
   // Step-1: Random number engine
@@ -276,6 +279,28 @@ void G4TaskRunManagerKernel::ExecuteWorkerTask()
 
 //============================================================================//
 
+void G4TaskRunManagerKernel::ExecuteWorkerSubEventTask(G4SubEvent* subEvent)
+{
+  // because of TBB
+  if(G4MTRunManager::GetMasterThreadId() == G4ThisThread::get_id())
+  {
+    G4TaskManager* taskManager =
+      G4TaskRunManager::GetMasterRunManager()->GetTaskManager();
+    auto _fut = taskManager->async(
+      [subEvent]() { ExecuteWorkerSubEventTask(subEvent); });
+    return _fut->get();
+  }
+
+  if(!workerRM())
+    InitializeWorker();
+
+  auto& wrm = workerRM();
+  assert(wrm.get() != nullptr);
+  wrm->DoSubEventWork(subEvent);
+}
+
+//============================================================================//
+
 void G4TaskRunManagerKernel::TerminateWorkerRunEventLoop()
 {
   if(workerRM())
@@ -51,6 +51,8 @@
 #include "G4AutoLock.hh"
 #include "G4ParallelWorldProcessStore.hh"
 #include "G4TaskRunManager.hh"
+#include "G4EventManager.hh"
+#include "G4SubEvent.hh"
 
 #include <fstream>
 #include <sstream>
@@ -80,7 +82,14 @@ G4WorkerTaskRunManager::GetWorkerRunManagerKernel()
 
 G4WorkerTaskRunManager::G4WorkerTaskRunManager()
   : G4WorkerRunManager()
-{}
+{
+  // Sub-events of the events processed by this worker are offered to
+  // the other workers through the task group of the master
+  eventManager->SetSubEventDispatcher([](G4SubEvent* subEvent) {
+    G4TaskRunManager* mrm = G4TaskRunManager::GetMasterRunManager();
+    return (mrm != nullptr) && mrm->AddSubEventTask(subEvent);
+  });
+}
 
 //============================================================================//
 
@@ -261,10 +270,23 @@ G4Event* G4WorkerTaskRunManager::GenerateEvent(G4int i_event)
   long s2                   = 0;
   long s3                   = 0;
   G4bool eventHasToBeSeeded = true;
-  if(G4MTRunManager::SeedOncePerCommunication() == 1 && runIsSeeded)
+  G4TaskRunManager* mrm = G4TaskRunManager::GetMasterRunManager();
+  // counter-based seeds are derived for every event, whatever the
+  // seedOncePerCommunication mode
+  if(G4MTRunManager::SeedOncePerCommunication() == 1 && runIsSeeded
+     && !mrm->IsCounterBasedSeeding())
     eventHasToBeSeeded = false;
 
-  if(i_event < 0)
+  if(i_event < 0 && mrm->IsAdaptiveSchedulingActive())
+  {
+    eventLoopOnGoing = mrm->SetUpAnAdaptiveEvent(anEvent, s1, s2, s3);
+    if(!eventLoopOnGoing)
+    {
+      delete anEvent;
+      return nullptr;
+    }
+  }
+  else if(i_event < 0)
   {
     G4int nevM = G4MTRunManager::GetMasterRunManager()->GetEventModulo();
     if(nevM == 1)
@@ -289,12 +311,15 @@ G4Event* G4WorkerTaskRunManager::GenerateEvent(G4int i_event)
       }
       else
       {
-        if(G4MTRunManager::SeedOncePerCommunication() > 0)
+        // counter-based seeds are derived per event, as for eventModulo 1
+        if(G4MTRunManager::SeedOncePerCommunication() > 0 &&
+           !mrm->IsCounterBasedSeeding())
           eventHasToBeSeeded = false;
         anEvent->SetEventID(++currEvID);
         nevModulo--;
       }
-      if(eventLoopOnGoing && eventHasToBeSeeded)
+      if(eventLoopOnGoing && eventHasToBeSeeded &&
+         !mrm->IsCounterBasedSeeding())
       {
         s1 = seedsQueue.front();
         seedsQueue.pop();
@@ -309,7 +334,7 @@ G4Event* G4WorkerTaskRunManager::GenerateEvent(G4int i_event)
       return nullptr;
     }
   }
-  else if(eventHasToBeSeeded)
+  else if(eventHasToBeSeeded && !mrm->IsCounterBasedSeeding())
   {
     // Need to reseed random number generator
     G4RNGHelper* helper = G4RNGHelper::GetInstance();
@@ -317,6 +342,14 @@ G4Event* G4WorkerTaskRunManager::GenerateEvent(G4int i_event)
     s2                  = helper->GetSeed(i_event * 2 + 1);
   }
 
+  if(eventHasToBeSeeded && mrm->IsCounterBasedSeeding())
+  {
+    G4long evtSeeds[3] = { 0, 0, 0 };
+    mrm->DeriveEventSeeds(anEvent->GetEventID(), evtSeeds);
+    s1 = evtSeeds[0];
+    s2 = evtSeeds[1];
+  }
+
   if(eventHasToBeSeeded)
   {
     long seeds[3] = { s1, s2, 0 };
@@ -404,6 +437,10 @@ void G4WorkerTaskRunManager::RunTermination()
       uwi->WorkerRunEnd();
   }
 
+  // Results of sub-events processed for other workers are kept until
+  // they are merged, which is guaranteed at this point
+  eventManager->CleanUpSubEvents();
+
   if(currentRun)
   {
     G4RunManager::RunTermination();
@@ -502,35 +539,21 @@ void G4WorkerTaskRunManager::DoCleanup()
 
 //============================================================================//
 
-void G4WorkerTaskRunManager::DoWork()
+void G4WorkerTaskRunManager::PrepareNewRun()
 {
   G4TaskRunManager* mrm           = G4TaskRunManager::GetMasterRunManager();
-  G4bool newRun                   = false;
   const G4Run* run                = mrm->GetCurrentRun();
   G4ThreadLocalStatic G4int runId = -1;
   if(run && run->GetRunID() != runId)
   {
-    runId  = run->GetRunID();
-    newRun = true;
+    runId = run->GetRunID();
     if(runId > 0)
     {
       ProcessUI();
       assert(workerContext != nullptr);
     }
     workerContext->UpdateGeometryAndPhysicsVectorFromMaster();
-  }
 
-  // Start this run
-  G4int nevts        = mrm->GetNumberOfEventsToBeProcessed();
-  G4int numSelect    = mrm->GetNumberOfSelectEvents();
-  G4String macroFile = mrm->GetSelectMacro();
-  bool empty_macro   = (macroFile == "" || macroFile == " ");
-
-  const char* macro = (empty_macro) ? nullptr : macroFile.c_str();
-  numSelect         = (empty_macro) ? -1 : numSelect;
-
-  if(newRun)
-  {
     G4bool cond = ConfirmBeamOnCondition();
     if(cond)
     {
@@ -538,7 +561,40 @@ void G4WorkerTaskRunManager::DoWork()
       RunInitialization();
     }
   }
+}
+
+//============================================================================//
+
+void G4WorkerTaskRunManager::DoWork()
+{
+  PrepareNewRun();
+
+  // Start this run
+  G4TaskRunManager* mrm = G4TaskRunManager::GetMasterRunManager();
+  G4int nevts           = mrm->GetNumberOfEventsToBeProcessed();
+  G4int numSelect       = mrm->GetNumberOfSelectEvents();
+  G4String macroFile    = mrm->GetSelectMacro();
+  bool empty_macro      = (macroFile == "" || macroFile == " ");
+
+  const char* macro = (empty_macro) ? nullptr : macroFile.c_str();
+  numSelect         = (empty_macro) ? -1 : numSelect;
+
   DoEventLoop(nevts, macro, numSelect);
 }
 
 //============================================================================//
+
+void G4WorkerTaskRunManager::DoSubEventWork(G4SubEvent* subEvent)
+{
+  PrepareNewRun();
+
+  if(currentRun == nullptr || runAborted)
+  {
+    // this worker cannot process events: leave it to the owner
+    subEvent->Release();
+    return;
+  }
+  eventManager->ProcessSubEvent(subEvent);
+}
+
+//============================================================================//
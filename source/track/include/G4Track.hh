@@ -50,6 +50,7 @@
 #include "G4LogicalVolume.hh"    // Include from 'geometry'
 #include "G4VPhysicalVolume.hh"  // Include from 'geometry'
 #include "G4Allocator.hh"        // Include from 'particle+matter'
+#include "G4EventArena.hh"       // Include from 'global'
 #include "G4DynamicParticle.hh"  // Include from 'particle+matter'
 #include "G4TrackStatus.hh"      // Include from 'tracking'
 #include "G4TouchableHandle.hh"  // Include from 'geometry'
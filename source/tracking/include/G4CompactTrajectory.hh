@@ -0,0 +1,180 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4CompactTrajectory
+//
+// Class description:
+//
+// Trajectory with the same information as G4Trajectory, but whose
+// points are stored contiguously in one buffer, as single precision
+// offsets from the first point of the track: 12 bytes per point instead
+// of one heap allocated G4TrajectoryPoint and its pointer. The
+// precision of a point is then about 1.e-7 of its distance to the
+// first point. It is selected with /tracking/storeTrajectory 5.
+//
+// Points may be dropped while the trajectory is recorded, if the
+// direction change at a point is below the angle tolerance and the
+// point is closer than the distance tolerance to the segment joining
+// its neighbours (/tracking/trajectoryAngleTolerance and
+// /tracking/trajectoryDistanceTolerance). A tolerance of zero, the
+// default, is not applied; no point is dropped if both are zero.
+// The first and the last points are always kept.
+//
+// G4TrajectoryPoint objects are created only when GetPoint() is
+// called, e.g. by visualisation, and kept until the trajectory is
+// modified or deleted.
+// --------------------------------------------------------------------
+#ifndef G4CompactTrajectory_hh
+#define G4CompactTrajectory_hh 1
+
+#include <vector>
+
+#include "trkgdefs.hh"
+#include "G4VTrajectory.hh"
+#include "G4Allocator.hh"
+#include "G4ios.hh"
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4TrajectoryPoint.hh"
+
+class G4ParticleDefinition;
+class G4Step;
+class G4Track;
+
+class G4CompactTrajectory : public G4VTrajectory
+{
+  public:
+
+    // Constructors/Destructor
+
+    G4CompactTrajectory() = default;
+    G4CompactTrajectory(const G4Track* aTrack);
+    G4CompactTrajectory(G4CompactTrajectory&);
+    virtual ~G4CompactTrajectory();
+
+    G4CompactTrajectory& operator=(const G4CompactTrajectory&) = delete;
+
+    // Operators
+
+    inline void* operator new(size_t);
+    inline void  operator delete(void*);
+    inline G4int operator == (const G4CompactTrajectory& r) const;
+
+    // Get/Set functions
+
+    inline G4int GetTrackID() const
+      { return fTrackID; }
+    inline G4int GetParentID() const
+      { return fParentID; }
+    inline G4String GetParticleName() const
+      { return ParticleName; }
+    inline G4double GetCharge() const
+      { return PDGCharge; }
+    inline G4int GetPDGEncoding() const
+      { return PDGEncoding; }
+    inline G4double GetInitialKineticEnergy() const
+      { return initialKineticEnergy; }
+    inline G4ThreeVector GetInitialMomentum() const
+      { return initialMomentum; }
+
+    inline G4ThreeVector GetPosition(G4int i) const;
+      // Position of point i, without creating a G4TrajectoryPoint
+
+    static void SetAngleTolerance(G4double val);
+    static G4double GetAngleTolerance();
+    static void SetDistanceTolerance(G4double val);
+    static G4double GetDistanceTolerance();
+      // Thinning tolerances of the points, per thread: the commands of
+      // G4TrackingMessenger are broadcast and set the values of each worker
+
+    // Other member functions
+
+    virtual void ShowTrajectory(std::ostream& os=G4cout) const;
+    virtual void DrawTrajectory() const;
+    virtual void AppendStep(const G4Step* aStep);
+    virtual G4int GetPointEntries() const
+      { return G4int(fOffsets.size()/3); }
+    virtual G4VTrajectoryPoint* GetPoint(G4int i) const;
+    virtual void MergeTrajectory(G4VTrajectory* secondTrajectory);
+
+    G4ParticleDefinition* GetParticleDefinition();
+
+    virtual const std::map<G4String,G4AttDef>* GetAttDefs() const;
+    virtual std::vector<G4AttValue>* CreateAttValues() const;
+
+  private:
+
+    void AppendPosition(const G4ThreeVector& pos);
+    void ClearPoints() const;
+
+  private:
+
+    std::vector<float> fOffsets;
+      // x, y, z of each point relative to fOrigin
+    G4ThreeVector fOrigin;
+    mutable std::vector<G4TrajectoryPoint>* fPoints = nullptr;
+
+    G4int                       fTrackID = 0;
+    G4int                       fParentID = 0;
+    G4int                       PDGEncoding = 0;
+    G4double                    PDGCharge = 0.0;
+    G4String                    ParticleName = "";
+    G4double                    initialKineticEnergy = 0.0;
+    G4ThreeVector               initialMomentum;
+
+    static G4ThreadLocal G4double fAngleTolerance;
+    static G4ThreadLocal G4double fDistanceTolerance;
+};
+
+extern G4TRACKING_DLL
+G4Allocator<G4CompactTrajectory>*& aCompactTrajectoryAllocator();
+
+inline void* G4CompactTrajectory::operator new(size_t)
+{
+  if (aCompactTrajectoryAllocator() == nullptr)
+  {
+    aCompactTrajectoryAllocator() = new G4Allocator<G4CompactTrajectory>;
+  }
+  return (void*)aCompactTrajectoryAllocator()->MallocSingle();
+}
+
+inline void G4CompactTrajectory::operator delete(void* aTrajectory)
+{
+  aCompactTrajectoryAllocator()->FreeSingle((G4CompactTrajectory*)aTrajectory);
+}
+
+inline G4int
+G4CompactTrajectory::operator == (const G4CompactTrajectory& r) const
+{
+  return (this==&r);
+}
+
+inline G4ThreeVector G4CompactTrajectory::GetPosition(G4int i) const
+{
+  const float* p = &fOffsets[3*i];
+  return fOrigin + G4ThreeVector(p[0], p[1], p[2]);
+}
+
+#endif
@@ -60,9 +60,11 @@
 #include "G4TrackStatus.hh"            // Include from 'tracking'
 #include "G4StepStatus.hh"             // Include from 'tracking'
 #include "G4UserSteppingAction.hh"     // Include from 'tracking'
+#include "G4UserSteppingBatchAction.hh" // Include from 'tracking'
 #include "G4Step.hh"                   // Include from 'tracking'
 #include "G4StepPoint.hh"              // Include from 'tracking'
 #include "G4VSteppingVerbose.hh"       // Include from 'tracking'
+#include "G4SteppingProfiler.hh"       // Include from 'tracking'
 #include "G4TouchableHandle.hh"        // Include from 'geometry'
 #include "G4TouchableHistoryHandle.hh" // Include from 'geometry'
 
@@ -163,21 +165,54 @@ class G4SteppingManager
     G4ForceCondition GetfCondition();
     G4GPILSelection GetfGPILSelection();
 
+    // Fast path for steps in dilute materials
+
+    void SetFastPathDensity(G4double val);
+    G4double GetFastPathDensity() const;
+      // Steps of neutral particles in a material with a density below
+      // this value and without field do not invoke electromagnetic,
+      // hadronic and photolepton-hadron processes: only transportation,
+      // decay, and other material independent processes limit such steps.
+      // Charged particles never take the fast path, as they would miss
+      // their continuous energy loss and multiple scattering. Set by
+      // /tracking/fastPathDensity; 0 (default) disables the fast path.
+      // The first step in such a volume, and the first step after a
+      // change of material, is a normal one, so that the skipped
+      // processes have their interaction lengths computed for the
+      // material where the fast path is taken. The length
+      // travelled on the fast path is subtracted from their number of
+      // interaction lengths left at the next step where they are asked.
+    G4bool IsFastPathStep() const;
+    G4long GetNumberOfFastPathSteps() const;
+    G4long GetNumberOfCountedSteps() const;
+      // Steps which took the fast path, and all steps counted while
+      // the fast path was enabled
+    void ResetFastPathCounters();
+
   private:
 
     // Member functions
 
-    void DefinePhysicalStepLength();
+    template <G4bool verbose> G4StepStatus DoStepping();
+      // Stepping loop; the variant with verbose=true invokes the hooks
+      // of G4VSteppingVerbose and is only selected if verboseLevel > 0
+    template <G4bool verbose> void DefinePhysicalStepLength();
       // Calculate corresponding physical length from the mean free path 
       // left for each discrete physics process. The minimum allowable
       // step for each continuous process will be also calculated.
-    void InvokeAtRestDoItProcs();
-    void InvokeAlongStepDoItProcs();
-    void InvokePostStepDoItProcs();
-    void InvokePSDIP(size_t); // 
+    template <G4bool verbose> void InvokeAtRestDoItProcs();
+    template <G4bool verbose> void InvokeAlongStepDoItProcs();
+    template <G4bool verbose> void InvokePostStepDoItProcs();
+    template <G4bool verbose> void InvokePSDIP(size_t); // 
     G4double CalculateSafety();
       // Return the estimated safety value at the PostStepPoint
     void ApplyProductionCut(G4Track*);
+    G4bool IsFastPathVolume() const;
+      // The track is neutral, the pre-step material is below the fast
+      // path density and no field is assigned to the current volume
+    G4bool IsSkippedInFastPath(const G4VProcess*) const;
+    void ProfileCall(G4double start);
+      // Adds the time since start to the current process and volume
 
     // Member data 
 
@@ -186,6 +221,8 @@ class G4SteppingManager
     G4bool KillVerbose = false;
 
     G4UserSteppingAction* fUserSteppingAction = nullptr;
+    G4UserSteppingBatchAction* fUserSteppingBatchAction = nullptr;
+      // Same object as fUserSteppingAction if it is a batch action
 
     G4VSteppingVerbose* fVerbose = nullptr;
 
@@ -271,6 +308,22 @@ class G4SteppingManager
     G4NoProcess const* fNoProcess = nullptr;
       // Used in the InvokeAtRestDoItProcs() method to flag the process
       // of any stable ion at rest. 
+
+    G4double fFastPathDensity = 0.0;
+    G4bool fFastPathStep = false;
+    G4bool fFastPathReady = false;
+      // The previous step was in a volume eligible for the fast path
+    const G4Material* fFastPathMaterial = nullptr;
+      // Material of the previous step, while the fast path is enabled
+    G4double fFastPathLength = 0.0;
+      // Length not yet subtracted by the processes skipped on the fast
+      // path; it is added to the previous step size passed to them
+    G4long fNumberOfFastPathSteps = 0;
+    G4long fNumberOfCountedSteps = 0;
+
+    G4SteppingProfiler* fProfiler = nullptr;
+    G4bool fProfileCalls = false;
+      // Process invocations are timed (/tracking/profile 2)
 };
 
 //*******************************************************************
@@ -520,6 +573,8 @@ class G4SteppingManager
   inline void G4SteppingManager::SetUserAction(G4UserSteppingAction* apAction)
   {
     fUserSteppingAction = apAction;
+    fUserSteppingBatchAction =
+      dynamic_cast<G4UserSteppingBatchAction*>(apAction);
   }
 
   inline G4UserSteppingAction* G4SteppingManager::GetUserAction()
@@ -535,6 +590,10 @@ class G4SteppingManager
   inline void G4SteppingManager::SetVerboseLevel(G4int vLevel)
   {
     verboseLevel = vLevel; 
+#ifdef G4VERBOSE
+    if(verboseLevel == -1) { G4VSteppingVerbose::SetSilent(1); }
+    else if(verboseLevel <= 0) { G4VSteppingVerbose::SetSilent(0); }
+#endif
   }
 
   inline void G4SteppingManager::SetVerbose(G4VSteppingVerbose* yourVerbose)
@@ -554,4 +613,50 @@ class G4SteppingManager
                 kCarTolerance );
   }
 
+  inline void G4SteppingManager::SetFastPathDensity(G4double val)
+  {
+    fFastPathDensity = val;
+  }
+
+  inline G4double G4SteppingManager::GetFastPathDensity() const
+  {
+    return fFastPathDensity;
+  }
+
+  inline G4bool G4SteppingManager::IsFastPathStep() const
+  {
+    return fFastPathStep;
+  }
+
+  inline G4long G4SteppingManager::GetNumberOfFastPathSteps() const
+  {
+    return fNumberOfFastPathSteps;
+  }
+
+  inline G4long G4SteppingManager::GetNumberOfCountedSteps() const
+  {
+    return fNumberOfCountedSteps;
+  }
+
+  inline void G4SteppingManager::ResetFastPathCounters()
+  {
+    fNumberOfFastPathSteps = 0;
+    fNumberOfCountedSteps = 0;
+  }
+
+  inline void G4SteppingManager::ProfileCall(G4double start)
+  {
+    fProfiler->AddInvocation(fTrack->GetDefinition(), fCurrentProcess,
+                             fCurrentVolume->GetLogicalVolume(),
+                             G4SteppingProfiler::Now() - start);
+  }
+
+  inline G4bool
+  G4SteppingManager::IsSkippedInFastPath(const G4VProcess* proc) const
+  {
+    G4ProcessType type = proc->GetProcessType();
+    return type == fElectromagnetic || type == fHadronic
+        || type == fPhotolepton_hadron;
+  }
+
 #endif
@@ -0,0 +1,158 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4SteppingProfiler
+//
+// Class description:
+//
+// Accumulates the number of steps and the time spent in stepping per
+// particle type, process and logical volume, for one thread.
+// Profiling is switched on with /tracking/profile:
+//  1 : each step is timed as a whole and attributed to the process
+//      which limited it;
+//  2 : in addition, each invocation of a GetPhysicalInteractionLength
+//      or DoIt method is timed and attributed to the invoked process.
+// When it is off, the cost is one test of a static value per step.
+// The tables of all threads are merged by the master at the end of the
+// run and printed, and written as CSV if a file name is given
+// (/tracking/profileFile). They are reset afterwards.
+// --------------------------------------------------------------------
+#ifndef G4SteppingProfiler_hh
+#define G4SteppingProfiler_hh 1
+
+#include "globals.hh"
+
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4VProcess;
+
+class G4SteppingProfiler
+{
+  public:
+
+    static G4SteppingProfiler* GetInstance();
+      // The instance of the calling thread, created on the first call
+
+    static void SetLevel(G4int val);
+    static inline G4int GetLevel();
+    static void SetFileName(const G4String& name);
+    static G4String GetFileName();
+
+    inline void AddStep(const G4ParticleDefinition* particle,
+                        const G4VProcess* process,
+                        const G4LogicalVolume* volume, G4double time);
+      // A step limited by the process, time in nanoseconds
+    inline void AddInvocation(const G4ParticleDefinition* particle,
+                              const G4VProcess* process,
+                              const G4LogicalVolume* volume, G4double time);
+      // A call to one of the methods of the process
+
+    static inline G4double Now();
+      // Current time in nanoseconds, for differences only
+
+    static void Report();
+      // Merges the tables of all threads, prints them and resets them.
+      // Must not be called while events are processed.
+
+    G4SteppingProfiler(const G4SteppingProfiler&) = delete;
+    G4SteppingProfiler& operator=(const G4SteppingProfiler&) = delete;
+
+  private:
+
+    G4SteppingProfiler() = default;
+      // Instances are kept until the end of the program
+
+    struct Key
+    {
+      const G4ParticleDefinition* particle;
+      const G4VProcess* process;
+      const G4LogicalVolume* volume;
+      G4bool operator==(const Key& k) const
+      {
+        return particle == k.particle && process == k.process
+            && volume == k.volume;
+      }
+    };
+
+    struct KeyHash
+    {
+      std::size_t operator()(const Key& k) const
+      {
+        std::size_t h = std::hash<const void*>()(k.particle);
+        h = h*31 + std::hash<const void*>()(k.process);
+        return h*31 + std::hash<const void*>()(k.volume);
+      }
+    };
+
+    struct Entry
+    {
+      G4long steps = 0;
+      G4double stepTime = 0.0;
+      G4long calls = 0;
+      G4double callTime = 0.0;
+    };
+
+    std::unordered_map<Key, Entry, KeyHash> fTable;
+
+    static std::atomic<G4int> fLevel;
+      // Set from the UI thread, read by all workers
+};
+
+inline G4int G4SteppingProfiler::GetLevel()
+{
+  return fLevel.load(std::memory_order_relaxed);
+}
+
+inline G4double G4SteppingProfiler::Now()
+{
+  return std::chrono::duration<G4double, std::nano>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline void G4SteppingProfiler::AddStep(const G4ParticleDefinition* particle,
+                                    const G4VProcess* process,
+                                    const G4LogicalVolume* volume,
+                                    G4double time)
+{
+  Entry& e = fTable[Key{particle, process, volume}];
+  ++e.steps;
+  e.stepTime += time;
+}
+
+inline void
+G4SteppingProfiler::AddInvocation(const G4ParticleDefinition* particle,
+                              const G4VProcess* process,
+                              const G4LogicalVolume* volume, G4double time)
+{
+  Entry& e = fTable[Key{particle, process, volume}];
+  ++e.calls;
+  e.callTime += time;
+}
+
+#endif
@@ -45,6 +45,8 @@ class G4UIdirectory;
 class G4UIcmdWithoutParameter;
 class G4UIcmdWithAnInteger;
 class G4UIcmdWithABool;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWithAString;
 class G4TrackingManager;
 class G4SteppingManager;
 
@@ -69,7 +71,12 @@ class G4TrackingMessenger : public G4UImessenger
     G4UIcmdWithoutParameter* AbortCmd = nullptr;
     G4UIcmdWithoutParameter* ResumeCmd = nullptr;
     G4UIcmdWithAnInteger*    StoreTrajectoryCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* TrajAngleTolCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* TrajDistanceTolCmd = nullptr;
     G4UIcmdWithAnInteger*    VerboseCmd = nullptr;
+    G4UIcmdWithADoubleAndUnit* FastPathCmd = nullptr;
+    G4UIcmdWithAnInteger*    ProfileCmd = nullptr;
+    G4UIcmdWithAString*      ProfileFileCmd = nullptr;
 };
 
 #endif
@@ -0,0 +1,132 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4UserSteppingBatchAction
+//
+// Class description:
+//
+// Variant of G4UserSteppingAction for light-weight accumulation of step
+// data. Instead of being invoked at each step with the full G4Step, the
+// user receives compact step summaries (G4StepSummary) in batches: once
+// every N steps, optionally at the end of each track, and in any case at
+// the end of each event, before G4UserEventAction::EndOfEventAction().
+// When this class is the stepping action set to G4SteppingManager, the
+// step is recorded without any virtual call; the summaries are stored
+// contiguously so that the user can process them in vectorised loops.
+//
+// Usage:
+//   class MyAction : public G4UserSteppingBatchAction
+//   {
+//     public:
+//       MyAction() : G4UserSteppingBatchAction(4096) {}
+//       void UserSteppingBatch(const std::vector<G4StepSummary>&) override;
+//   };
+//
+// Since the user sees the steps after they happened, the track cannot be
+// modified or killed from this action.
+
+// --------------------------------------------------------------------
+#ifndef G4UserSteppingBatchAction_hh
+#define G4UserSteppingBatchAction_hh 1
+
+#include <vector>
+
+#include "G4UserSteppingAction.hh"
+#include "G4Step.hh"
+#include "G4ThreeVector.hh"
+#include "G4VPhysicalVolume.hh"
+
+class G4ParticleDefinition;
+
+struct G4StepSummary
+{
+  G4ThreeVector fPrePosition;
+  G4ThreeVector fPostPosition;
+  G4double fEnergyDeposit;
+  G4double fStepLength;
+  G4double fGlobalTime;                 // at the post-step point
+  const G4ParticleDefinition* fParticle;
+  G4int fTrackID;
+  G4int fVolumeID;                      // instance ID of the pre-step
+                                        // physical volume, -1 if none
+};
+
+class G4UserSteppingBatchAction : public G4UserSteppingAction
+{
+  public:
+
+    explicit G4UserSteppingBatchAction(std::size_t batchSize = 1024);
+    ~G4UserSteppingBatchAction() override;
+
+    virtual void UserSteppingBatch(const std::vector<G4StepSummary>& steps) = 0;
+      // Called with the steps recorded since the previous call
+
+    void UserSteppingAction(const G4Step* aStep) final;
+      // Records the step; used when the action is not invoked directly
+      // by G4SteppingManager (e.g. within G4MultiSteppingAction)
+
+    inline void Record(const G4Step* aStep);
+      // Store the summary of the step, flushing when the batch is full
+    void Flush();
+      // Deliver the recorded steps, if any
+
+    void SetBatchSize(std::size_t n);
+    inline std::size_t GetBatchSize() const { return fBatchSize; }
+    inline void SetFlushAtEndOfTrack(G4bool val) { fFlushAtEndOfTrack = val; }
+    inline G4bool GetFlushAtEndOfTrack() const { return fFlushAtEndOfTrack; }
+
+    static void EndOfTrack();
+      // Flush the actions of this thread requiring it at end of track
+    static void EndOfEvent();
+      // Flush all the actions of this thread
+
+  private:
+
+    static std::vector<G4UserSteppingBatchAction*>*& Instances();
+
+    std::vector<G4StepSummary> fBuffer;
+    std::size_t fBatchSize;
+    G4bool fFlushAtEndOfTrack = false;
+};
+
+// ------------------------------------------------------------------------
+// Inline methods
+// ------------------------------------------------------------------------
+
+inline void G4UserSteppingBatchAction::Record(const G4Step* aStep)
+{
+  const G4StepPoint* pre = aStep->GetPreStepPoint();
+  const G4StepPoint* post = aStep->GetPostStepPoint();
+  const G4Track* track = aStep->GetTrack();
+  const G4VPhysicalVolume* pv = pre->GetPhysicalVolume();
+  fBuffer.push_back({ pre->GetPosition(), post->GetPosition(),
+                      aStep->GetTotalEnergyDeposit(), aStep->GetStepLength(),
+                      post->GetGlobalTime(), track->GetParticleDefinition(),
+                      track->GetTrackID(),
+                      (pv != nullptr) ? pv->GetInstanceID() : -1 });
+  if(fBuffer.size() >= fBatchSize) { Flush(); }
+}
+
+#endif
@@ -6,11 +6,13 @@ geant4_add_module(G4tracking
     G4AdjointCrossSurfChecker.hh
     G4AdjointSteppingAction.hh
     G4AdjointTrackingAction.hh
+    G4CompactTrajectory.hh
     G4RichTrajectory.hh
     G4RichTrajectoryPoint.hh
     G4SmoothTrajectory.hh
     G4SmoothTrajectoryPoint.hh
     G4SteppingManager.hh
+    G4SteppingProfiler.hh
     G4SteppingVerbose.hh
     G4SteppingVerboseWithUnits.hh
     G4TrackingManager.hh
@@ -18,6 +20,7 @@ geant4_add_module(G4tracking
     G4Trajectory.hh
     G4TrajectoryPoint.hh
     G4UserSteppingAction.hh
+    G4UserSteppingBatchAction.hh
     G4MultiSteppingAction.hh
     G4UserTrackingAction.hh
     G4MultiTrackingAction.hh
@@ -30,11 +33,13 @@ geant4_add_module(G4tracking
     G4AdjointCrossSurfChecker.cc
     G4AdjointSteppingAction.cc
     G4AdjointTrackingAction.cc
+    G4CompactTrajectory.cc
     G4RichTrajectory.cc
     G4RichTrajectoryPoint.cc
     G4SmoothTrajectory.cc
     G4SmoothTrajectoryPoint.cc
     G4SteppingManager.cc
+    G4SteppingProfiler.cc
     G4SteppingManager2.cc
     G4SteppingVerbose.cc
     G4SteppingVerboseWithUnits.cc
@@ -43,6 +48,7 @@ geant4_add_module(G4tracking
     G4Trajectory.cc
     G4TrajectoryPoint.cc
     G4UserSteppingAction.cc
+    G4UserSteppingBatchAction.cc
     G4MultiSteppingAction.cc
     G4UserTrackingAction.cc
     G4MultiTrackingAction.cc
@@ -0,0 +1,280 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4CompactTrajectory class implementation
+// --------------------------------------------------------------------
+
+#include "G4CompactTrajectory.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4ParticleTable.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4AttDefStore.hh"
+#include "G4AttDef.hh"
+#include "G4AttValue.hh"
+#include "G4UIcommand.hh"
+#include "G4UnitsTable.hh"
+
+G4ThreadLocal G4double G4CompactTrajectory::fAngleTolerance = 0.0;
+G4ThreadLocal G4double G4CompactTrajectory::fDistanceTolerance = 0.0;
+
+G4Allocator<G4CompactTrajectory>*& aCompactTrajectoryAllocator()
+{
+  G4ThreadLocalStatic G4Allocator<G4CompactTrajectory>* _instance = nullptr;
+  return _instance;
+}
+
+G4CompactTrajectory::G4CompactTrajectory(const G4Track* aTrack)
+{
+  G4ParticleDefinition* fpParticleDefinition = aTrack->GetDefinition();
+  ParticleName = fpParticleDefinition->GetParticleName();
+  PDGCharge = fpParticleDefinition->GetPDGCharge();
+  PDGEncoding = fpParticleDefinition->GetPDGEncoding();
+  fTrackID = aTrack->GetTrackID();
+  fParentID = aTrack->GetParentID();
+  initialKineticEnergy = aTrack->GetKineticEnergy();
+  initialMomentum = aTrack->GetMomentum();
+
+  // Following is for the first trajectory point
+  fOrigin = aTrack->GetPosition();
+  fOffsets.assign(3, 0.0f);
+}
+
+G4CompactTrajectory::G4CompactTrajectory(G4CompactTrajectory& right)
+  : G4VTrajectory()
+{
+  ParticleName = right.ParticleName;
+  PDGCharge = right.PDGCharge;
+  PDGEncoding = right.PDGEncoding;
+  fTrackID = right.fTrackID;
+  fParentID = right.fParentID;
+  initialKineticEnergy = right.initialKineticEnergy;
+  initialMomentum = right.initialMomentum;
+  fOrigin = right.fOrigin;
+  fOffsets = right.fOffsets;
+}
+
+G4CompactTrajectory::~G4CompactTrajectory()
+{
+  ClearPoints();
+}
+
+void G4CompactTrajectory::SetAngleTolerance(G4double val)
+{
+  fAngleTolerance = val;
+}
+
+G4double G4CompactTrajectory::GetAngleTolerance()
+{
+  return fAngleTolerance;
+}
+
+void G4CompactTrajectory::SetDistanceTolerance(G4double val)
+{
+  fDistanceTolerance = val;
+}
+
+G4double G4CompactTrajectory::GetDistanceTolerance()
+{
+  return fDistanceTolerance;
+}
+
+void G4CompactTrajectory::ShowTrajectory(std::ostream& os) const
+{
+  // Invoke the default implementation in G4VTrajectory...
+  G4VTrajectory::ShowTrajectory(os);
+
+  // ... or override with your own code here.
+}
+
+void G4CompactTrajectory::DrawTrajectory() const
+{
+  // Invoke the default implementation in G4VTrajectory...
+  G4VTrajectory::DrawTrajectory();
+
+  // ... or override with your own code here.
+}
+
+G4VTrajectoryPoint* G4CompactTrajectory::GetPoint(G4int i) const
+{
+  if(fPoints == nullptr)
+  {
+    G4int n = GetPointEntries();
+    fPoints = new std::vector<G4TrajectoryPoint>();
+    fPoints->reserve(n);
+    for(G4int j=0; j<n; ++j)
+    {
+      fPoints->emplace_back(GetPosition(j));
+    }
+  }
+  return &(*fPoints)[i];
+}
+
+const std::map<G4String,G4AttDef>* G4CompactTrajectory::GetAttDefs() const
+{
+  G4bool isNew;
+  std::map<G4String,G4AttDef>* store
+    = G4AttDefStore::GetInstance("G4CompactTrajectory",isNew);
+  if (isNew)
+  {
+    G4String ID("ID");
+    (*store)[ID] = G4AttDef(ID,"Track ID","Physics","","G4int");
+
+    G4String PID("PID");
+    (*store)[PID] = G4AttDef(PID,"Parent ID","Physics","","G4int");
+
+    G4String PN("PN");
+    (*store)[PN] = G4AttDef(PN,"Particle Name","Physics","","G4String");
+
+    G4String Ch("Ch");
+    (*store)[Ch] = G4AttDef(Ch,"Charge","Physics","e+","G4double");
+
+    G4String PDG("PDG");
+    (*store)[PDG] = G4AttDef(PDG,"PDG Encoding","Physics","","G4int");
+
+    G4String IKE("IKE");
+    (*store)[IKE] = 
+      G4AttDef(IKE, "Initial kinetic energy",
+               "Physics","G4BestUnit","G4double");
+
+    G4String IMom("IMom");
+    (*store)[IMom] = G4AttDef(IMom, "Initial momentum",
+                              "Physics","G4BestUnit","G4ThreeVector");
+
+    G4String IMag("IMag");
+    (*store)[IMag] = 
+      G4AttDef(IMag, "Initial momentum magnitude",
+               "Physics","G4BestUnit","G4double");
+
+    G4String NTP("NTP");
+    (*store)[NTP] = G4AttDef(NTP,"No. of points","Physics","","G4int");
+  }
+  return store;
+}
+
+std::vector<G4AttValue>* G4CompactTrajectory::CreateAttValues() const
+{
+  std::vector<G4AttValue>* values = new std::vector<G4AttValue>;
+
+  values->push_back
+    (G4AttValue("ID",G4UIcommand::ConvertToString(fTrackID),""));
+
+  values->push_back
+    (G4AttValue("PID",G4UIcommand::ConvertToString(fParentID),""));
+
+  values->push_back(G4AttValue("PN",ParticleName,""));
+
+  values->push_back
+    (G4AttValue("Ch",G4UIcommand::ConvertToString(PDGCharge),""));
+
+  values->push_back
+    (G4AttValue("PDG",G4UIcommand::ConvertToString(PDGEncoding),""));
+
+  values->push_back
+    (G4AttValue("IKE",G4BestUnit(initialKineticEnergy,"Energy"),""));
+
+  values->push_back
+    (G4AttValue("IMom",G4BestUnit(initialMomentum,"Energy"),""));
+
+  values->push_back
+    (G4AttValue("IMag",G4BestUnit(initialMomentum.mag(),"Energy"),""));
+
+  values->push_back
+    (G4AttValue("NTP",G4UIcommand::ConvertToString(GetPointEntries()),""));
+
+  return values;
+}
+
+void G4CompactTrajectory::AppendStep(const G4Step* aStep)
+{
+  AppendPosition(aStep->GetPostStepPoint()->GetPosition());
+}
+
+void G4CompactTrajectory::AppendPosition(const G4ThreeVector& pos)
+{
+  ClearPoints();
+
+  // The last point is dropped if it is not needed between the point
+  // before it and the new one
+  G4int n = GetPointEntries();
+  if(n >= 2 && (fAngleTolerance > 0.0 || fDistanceTolerance > 0.0))
+  {
+    const G4ThreeVector a = GetPosition(n-2);
+    const G4ThreeVector b = GetPosition(n-1);
+    const G4ThreeVector ab = b - a;
+    G4bool drop = true;
+    if(fAngleTolerance > 0.0)
+    {
+      const G4ThreeVector bc = pos - b;
+      if(ab.mag2() > 0.0 && bc.mag2() > 0.0)
+      {
+        drop = (ab.angle(bc) <= fAngleTolerance);
+      }
+    }
+    if(drop && fDistanceTolerance > 0.0)
+    {
+      // distance of b to the segment from a to the new point
+      const G4ThreeVector ac = pos - a;
+      const G4double len2 = ac.mag2();
+      G4double t = (len2 > 0.0) ? ab.dot(ac)/len2 : 0.0;
+      t = std::min(std::max(t, 0.0), 1.0);
+      drop = ((ab - t*ac).mag() <= fDistanceTolerance);
+    }
+    if(drop)
+    {
+      fOffsets.resize(3*(n-1));
+    }
+  }
+
+  const G4ThreeVector d = pos - fOrigin;
+  fOffsets.push_back((float)d.x());
+  fOffsets.push_back((float)d.y());
+  fOffsets.push_back((float)d.z());
+}
+
+void G4CompactTrajectory::ClearPoints() const
+{
+  delete fPoints;
+  fPoints = nullptr;
+}
+
+G4ParticleDefinition* G4CompactTrajectory::GetParticleDefinition()
+{
+  return (G4ParticleTable::GetParticleTable()->FindParticle(ParticleName));
+}
+
+void G4CompactTrajectory::MergeTrajectory(G4VTrajectory* secondTrajectory)
+{
+  if(secondTrajectory == nullptr) return;
+
+  G4CompactTrajectory* seco = (G4CompactTrajectory*)secondTrajectory;
+  G4int ent = seco->GetPointEntries();
+  for(G4int i=1; i<ent; ++i) // initial pt of 2nd trajectory shouldn't be merged
+  {
+    AppendPosition(seco->GetPosition(i));
+  }
+  seco->fOffsets.clear();
+  seco->ClearPoints();
+}
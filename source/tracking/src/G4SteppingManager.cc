@@ -40,6 +40,8 @@
 #include "G4SteppingControl.hh"
 #include "G4TransportationManager.hh"
 #include "G4UserLimits.hh"
+#include "G4FieldManager.hh"
+#include "G4Material.hh"
 #include "G4VSensitiveDetector.hh"    // Include from 'hits/digi'
 #include "G4GeometryTolerance.hh"
 #include "G4Profiler.hh"
@@ -116,32 +118,53 @@ G4SteppingManager::~G4SteppingManager()
   #ifdef G4VERBOSE
     if(KillVerbose) delete fVerbose;
   #endif
+
+  if(verboseLevel > 0 && fNumberOfCountedSteps > 0)
+  {
+    G4cout << "G4SteppingManager: " << fNumberOfFastPathSteps << " of "
+           << fNumberOfCountedSteps << " steps took the fast path"
+           << G4endl;
+  }
 }
 
 //////////////////////////////////////////
 G4StepStatus G4SteppingManager::Stepping()
 //////////////////////////////////////////
+{
+  // The verbose hooks are compiled in a separate variant of the stepping
+  // loop, so that the default one carries no verbose test at all
+  #ifdef G4VERBOSE
+    if(verboseLevel>0) { return DoStepping<true>(); }
+  #endif
+  return DoStepping<false>();
+}
+
+//////////////////////////////////////////
+template <G4bool verbose>
+G4StepStatus G4SteppingManager::DoStepping()
+//////////////////////////////////////////
 {
 #ifdef GEANT4_USE_TIMEMORY
   ProfilerConfig profiler{ fStep };
 #endif
 
+  // Step profiling, see G4SteppingProfiler
+  //
+  const G4int profileLevel = G4SteppingProfiler::GetLevel();
+  G4double profileStart = 0.0;
+  fProfileCalls = false;
+  if(profileLevel > 0)
+  {
+    if(fProfiler == nullptr) { fProfiler = G4SteppingProfiler::GetInstance(); }
+    fProfileCalls = (profileLevel > 1);
+    profileStart = G4SteppingProfiler::Now();
+  }
+
   //--------
   // Prelude
   //--------
   #ifdef G4VERBOSE
-    if(verboseLevel>0)
-    {
-      fVerbose->NewStep();
-    }
-    else if (verboseLevel==-1)
-    { 
-      G4VSteppingVerbose::SetSilent(1);
-    }
-    else
-    {
-      G4VSteppingVerbose::SetSilent(0);
-    }
+    if constexpr (verbose) { fVerbose->NewStep(); }
   #endif 
 
   // Store last PostStepPoint to PreStepPoint, and swap current and nex
@@ -176,12 +199,12 @@ G4StepStatus G4SteppingManager::Stepping()
   {
     if( MAXofAtRestLoops>0 )
     {
-      InvokeAtRestDoItProcs();
+      InvokeAtRestDoItProcs<verbose>();
       fStepStatus = fAtRestDoItProc;
       fStep->GetPostStepPoint()->SetStepStatus( fStepStatus );
        
       #ifdef G4VERBOSE
-        if(verboseLevel>0) fVerbose->AtRestDoItInvoked();
+        if constexpr (verbose) { fVerbose->AtRestDoItInvoked(); }
       #endif 
 
      }
@@ -197,7 +220,7 @@ G4StepStatus G4SteppingManager::Stepping()
   else
   {
     // Find minimum Step length demanded by active disc./cont. processes
-    DefinePhysicalStepLength();
+    DefinePhysicalStepLength<verbose>();
 
     // Store the Step length (geometrical length) to G4Step and G4Track
     fStep->SetStepLength( PhysicalStep );
@@ -208,7 +231,7 @@ G4StepStatus G4SteppingManager::Stepping()
     fStep->GetPostStepPoint()->SetStepStatus( fStepStatus );
 
     // Invoke AlongStepDoIt 
-    InvokeAlongStepDoItProcs();
+    InvokeAlongStepDoItProcs<verbose>();
 
     // Update track by taking into account all changes by AlongStepDoIt
     fStep->UpdateTrack();
@@ -221,14 +244,14 @@ G4StepStatus G4SteppingManager::Stepping()
     fStep->GetPostStepPoint()->SetSafety( endpointSafety );
 
     #ifdef G4VERBOSE
-      if(verboseLevel>0) fVerbose->AlongStepDoItAllDone();
+      if constexpr (verbose) { fVerbose->AlongStepDoItAllDone(); }
     #endif
 
     // Invoke PostStepDoIt
-    InvokePostStepDoItProcs();
+    InvokePostStepDoItProcs<verbose>();
 
     #ifdef G4VERBOSE
-      if(verboseLevel>0) fVerbose->PostStepDoItAllDone();
+      if constexpr (verbose) { fVerbose->PostStepDoItAllDone(); }
     #endif
   }
 
@@ -243,7 +266,7 @@ G4StepStatus G4SteppingManager::Stepping()
   fStep->SetTrack(fTrack);
 
   #ifdef G4VERBOSE
-    if(verboseLevel>0) fVerbose->StepInfo();
+    if constexpr (verbose) { fVerbose->StepInfo(); }
   #endif
 
   // Send G4Step information to Hit/Dig if the volume is sensitive
@@ -261,7 +284,11 @@ G4StepStatus G4SteppingManager::Stepping()
 
   // User intervention process
   //
-  if( fUserSteppingAction != nullptr )
+  if( fUserSteppingBatchAction != nullptr )
+  {
+    fUserSteppingBatchAction->Record(fStep);
+  }
+  else if( fUserSteppingAction != nullptr )
   {
     fUserSteppingAction->UserSteppingAction(fStep);
   }
@@ -272,6 +299,14 @@ G4StepStatus G4SteppingManager::Stepping()
   if(regionalAction)
     regionalAction->UserSteppingAction(fStep);
 
+  if(profileLevel > 0)
+  {
+    fProfiler->AddStep(fTrack->GetDefinition(),
+                       fPostStepPoint->GetProcessDefinedStep(),
+                       fCurrentVolume->GetLogicalVolume(),
+                       G4SteppingProfiler::Now() - profileStart);
+  }
+
   // Stepping process finish. Return the value of the StepStatus
   //
   return fStepStatus;
@@ -288,6 +323,10 @@ void G4SteppingManager::SetInitialStep(G4Track* valueTrack)
   fParticleChange = nullptr;
   fPreviousStepSize = 0.;
   fStepStatus = fUndefined;
+  fFastPathStep = false;
+  fFastPathReady = false;
+  fFastPathMaterial = nullptr;
+  fFastPathLength = 0.;
 
   fTrack = valueTrack;
   Mass = fTrack->GetDynamicParticle()->GetMass();
@@ -397,3 +436,26 @@ void G4SteppingManager::SetInitialStep(G4Track* valueTrack)
      if(verboseLevel>0) fVerbose->TrackingStarted();
    #endif
 }
+
+///////////////////////////////////////////////////////
+G4bool G4SteppingManager::IsFastPathVolume() const
+///////////////////////////////////////////////////////
+{
+  if(fTrack->GetDynamicParticle()->GetCharge() != 0.)
+  {
+    return false;
+  }
+  const G4Material* material = fPreStepPoint->GetMaterial();
+  if(material == nullptr || material->GetDensity() >= fFastPathDensity)
+  {
+    return false;
+  }
+  const G4FieldManager* fieldMgr =
+    fCurrentVolume->GetLogicalVolume()->GetFieldManager();
+  if(fieldMgr == nullptr)
+  {
+    fieldMgr = G4TransportationManager::GetTransportationManager()
+             ->GetFieldManager();
+  }
+  return fieldMgr == nullptr || fieldMgr->GetDetectorField() == nullptr;
+}
@@ -123,6 +123,7 @@ void G4SteppingManager::GetProcessNumber()
 // ************************************************************************
 
 /////////////////////////////////////////////////////////
+template <G4bool verbose>
 void G4SteppingManager::DefinePhysicalStepLength()
 /////////////////////////////////////////////////////////
 {
@@ -132,9 +133,36 @@ void G4SteppingManager::DefinePhysicalStepLength()
   physIntLength = DBL_MAX;          // Initialize by a huge number    
 
   #ifdef G4VERBOSE
-    if(verboseLevel>0) fVerbose->DPSLStarted();
+    if constexpr (verbose) { fVerbose->DPSLStarted(); }
   #endif
 
+  // Decide on the fast path; it requires that the previous step was
+  // also in an eligible volume of the same material, where the skipped
+  // processes were asked
+  //
+  fFastPathStep = false;
+  if(fFastPathDensity > 0.0)
+  {
+    ++fNumberOfCountedSteps;
+    const G4Material* material = fPreStepPoint->GetMaterial();
+    G4bool eligible = IsFastPathVolume();
+    fFastPathStep = eligible && fFastPathReady
+                 && (material == fFastPathMaterial);
+    fFastPathReady = eligible;
+    fFastPathMaterial = material;
+    if(fFastPathStep)
+    {
+      ++fNumberOfFastPathSteps;
+      fFastPathLength += fPreviousStepSize;
+    }
+  }
+  // Skipped processes catch up on the length travelled on the fast path
+  // at the first step which does not take it
+  //
+  G4bool catchUp = !fFastPathStep && (fFastPathLength > 0.);
+  G4double skippedStepSize = fPreviousStepSize + fFastPathLength;
+  if(!fFastPathStep) { fFastPathLength = 0.; }
+
   // GPIL for PostStep
   //
   fPostStepDoItProcTriggered = MAXofPostStepLoops;
@@ -148,10 +176,24 @@ void G4SteppingManager::DefinePhysicalStepLength()
       continue;
     } // NULL means the process is inactivated by a user on fly
 
+    G4double previousStepSize = fPreviousStepSize;
+    if((fFastPathStep || catchUp) && IsSkippedInFastPath(fCurrentProcess))
+    {
+      if(fFastPathStep)
+      {
+        (*fSelectedPostStepDoItVector)[np] = InActivated;
+        continue;
+      }
+      previousStepSize = skippedStepSize;
+    }
+
+    G4double t0 = fProfileCalls ? G4SteppingProfiler::Now() : 0.0;
     physIntLength = fCurrentProcess->PostStepGPIL( *fTrack,
-                                     fPreviousStepSize, &fCondition );
+                                                   previousStepSize,
+                                                   &fCondition );
+    if(fProfileCalls) { ProfileCall(t0); }
     #ifdef G4VERBOSE
-      if(verboseLevel>0) fVerbose->DPSLPostStep();
+      if constexpr (verbose) { fVerbose->DPSLPostStep(); }
     #endif
 
     switch (fCondition)
@@ -217,13 +259,16 @@ void G4SteppingManager::DefinePhysicalStepLength()
     fCurrentProcess = (*fAlongStepGetPhysIntVector)[kp];
     if (fCurrentProcess == nullptr) continue;
       // NULL means the process is inactivated by a user on fly
+    if (fFastPathStep && IsSkippedInFastPath(fCurrentProcess)) continue;
 
+    G4double t0 = fProfileCalls ? G4SteppingProfiler::Now() : 0.0;
     physIntLength = fCurrentProcess->AlongStepGPIL( *fTrack,
                                      fPreviousStepSize, PhysicalStep,
                                      safetyProposedToAndByProcess,
                                      &fGPILSelection );
+    if(fProfileCalls) { ProfileCall(t0); }
     #ifdef G4VERBOSE
-      if(verboseLevel>0) fVerbose->DPSLAlongStep();
+      if constexpr (verbose) { fVerbose->DPSLAlongStep(); }
     #endif
 
     if(physIntLength < PhysicalStep)
@@ -277,6 +322,7 @@ void G4SteppingManager::DefinePhysicalStepLength()
 }
 
 //////////////////////////////////////////////////////
+template <G4bool verbose>
 void G4SteppingManager::InvokeAtRestDoItProcs()
 //////////////////////////////////////////////////////
 {
@@ -300,7 +346,9 @@ void G4SteppingManager::InvokeAtRestDoItProcs()
       continue;
     }   // NULL means the process is inactivated by a user on fly
 
+    G4double t0 = fProfileCalls ? G4SteppingProfiler::Now() : 0.0;
     lifeTime = fCurrentProcess->AtRestGPIL( *fTrack, &fCondition );
+    if(fProfileCalls) { ProfileCall(t0); }
 
     if(fCondition == Forced)
     {
@@ -348,7 +396,9 @@ void G4SteppingManager::InvokeAtRestDoItProcs()
       if( (*fSelectedAtRestDoItVector)[MAXofAtRestLoops-np-1] != InActivated)
       {
         fCurrentProcess = (*fAtRestDoItVector)[np];
+        G4double t0 = fProfileCalls ? G4SteppingProfiler::Now() : 0.0;
         fParticleChange = fCurrentProcess->AtRestDoIt(*fTrack, *fStep);
+        if(fProfileCalls) { ProfileCall(t0); }
                                
         // Set the current process as a process which defined this Step length
         //
@@ -445,6 +495,7 @@ void G4SteppingManager::InvokeAtRestDoItProcs()
 }
 
 /////////////////////////////////////////////////////////
+template <G4bool verbose>
 void G4SteppingManager::InvokeAlongStepDoItProcs()
 /////////////////////////////////////////////////////////
 {
@@ -463,14 +514,17 @@ void G4SteppingManager::InvokeAlongStepDoItProcs()
     fCurrentProcess = (*fAlongStepDoItVector)[ci];
     if (fCurrentProcess== 0) continue;
       // NULL means the process is inactivated by a user on fly.
+    if (fFastPathStep && IsSkippedInFastPath(fCurrentProcess)) continue;
 
+    G4double t0 = fProfileCalls ? G4SteppingProfiler::Now() : 0.0;
     fParticleChange = fCurrentProcess->AlongStepDoIt( *fTrack, *fStep );
+    if(fProfileCalls) { ProfileCall(t0); }
 
     // Update the PostStepPoint of Step according to ParticleChange
     fParticleChange->UpdateStepForAlongStep(fStep);
 
     #ifdef G4VERBOSE
-      if(verboseLevel>0) fVerbose->AlongStepDoItOneByOne();
+      if constexpr (verbose) { fVerbose->AlongStepDoItOneByOne(); }
     #endif
 
     // Now Store the secondaries from ParticleChange to SecondaryList
@@ -564,6 +618,7 @@ void G4SteppingManager::InvokeAlongStepDoItProcs()
 }
 
 ////////////////////////////////////////////////////////
+template <G4bool verbose>
 void G4SteppingManager::InvokePostStepDoItProcs()
 ////////////////////////////////////////////////////////
 {
@@ -583,7 +638,7 @@ void G4SteppingManager::InvokePostStepDoItProcs()
           ((Cond == ExclusivelyForced) && (fStepStatus == fExclusivelyForcedProc)) || 
           ((Cond == StronglyForced) ) )
       {
-        InvokePSDIP(np);
+        InvokePSDIP<verbose>(np);
         if ((np==0) && (fTrack->GetNextVolume() == nullptr))
         {
           fStepStatus = fWorldBoundary;
@@ -602,7 +657,7 @@ void G4SteppingManager::InvokePostStepDoItProcs()
         G4int Cond2 = (*fSelectedPostStepDoItVector)[MAXofPostStepLoops-np1-1];
         if (Cond2 == StronglyForced)
         {
-          InvokePSDIP(np1);
+          InvokePSDIP<verbose>(np1);
         }
       }
       break;
@@ -611,17 +666,20 @@ void G4SteppingManager::InvokePostStepDoItProcs()
 }
 
 ////////////////////////////////////////////////////////
+template <G4bool verbose>
 void G4SteppingManager::InvokePSDIP(size_t np)
 ////////////////////////////////////////////////////////
 {
   fCurrentProcess = (*fPostStepDoItVector)[np];
+  G4double t0 = fProfileCalls ? G4SteppingProfiler::Now() : 0.0;
   fParticleChange = fCurrentProcess->PostStepDoIt( *fTrack, *fStep);
+  if(fProfileCalls) { ProfileCall(t0); }
 
   // Update PostStepPoint of Step according to ParticleChange
   fParticleChange->UpdateStepForPostStep(fStep);
 
   #ifdef G4VERBOSE
-    if(verboseLevel>0) fVerbose->PostStepDoItOneByOne();
+    if constexpr (verbose) { fVerbose->PostStepDoItOneByOne(); }
   #endif
 
   // Update G4Track according to ParticleChange after each PostStepDoIt
@@ -745,3 +803,16 @@ void G4SteppingManager::ApplyProductionCut(G4Track* aSecondary)
     }
   }
 }
+
+// Variants of the stepping loop, see G4SteppingManager::Stepping()
+//
+template void G4SteppingManager::DefinePhysicalStepLength<false>();
+template void G4SteppingManager::InvokeAtRestDoItProcs<false>();
+template void G4SteppingManager::InvokeAlongStepDoItProcs<false>();
+template void G4SteppingManager::InvokePostStepDoItProcs<false>();
+#ifdef G4VERBOSE
+template void G4SteppingManager::DefinePhysicalStepLength<true>();
+template void G4SteppingManager::InvokeAtRestDoItProcs<true>();
+template void G4SteppingManager::InvokeAlongStepDoItProcs<true>();
+template void G4SteppingManager::InvokePostStepDoItProcs<true>();
+#endif
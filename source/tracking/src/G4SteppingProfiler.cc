@@ -0,0 +1,201 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4SteppingProfiler class implementation
+// --------------------------------------------------------------------
+
+#include "G4SteppingProfiler.hh"
+#include "G4AutoLock.hh"
+#include "G4LogicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Region.hh"
+#include "G4VProcess.hh"
+#include "G4ios.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <tuple>
+#include <vector>
+
+std::atomic<G4int> G4SteppingProfiler::fLevel(0);
+
+namespace
+{
+  G4Mutex profilerMutex = G4MUTEX_INITIALIZER;
+
+  std::vector<G4SteppingProfiler*>& Instances()
+  {
+    static std::vector<G4SteppingProfiler*> instances;
+    return instances;
+  }
+
+  G4String& FileName()
+  {
+    static G4String fileName;
+    return fileName;
+  }
+}
+
+// --------------------------------------------------------------------
+G4SteppingProfiler* G4SteppingProfiler::GetInstance()
+{
+  static G4ThreadLocal G4SteppingProfiler* instance = nullptr;
+  if(instance == nullptr)
+  {
+    instance = new G4SteppingProfiler();
+    G4AutoLock l(&profilerMutex);
+    Instances().push_back(instance);
+  }
+  return instance;
+}
+
+// --------------------------------------------------------------------
+void G4SteppingProfiler::SetLevel(G4int val)
+{
+  fLevel.store(val, std::memory_order_relaxed);
+}
+
+// --------------------------------------------------------------------
+void G4SteppingProfiler::SetFileName(const G4String& name)
+{
+  G4AutoLock l(&profilerMutex);
+  FileName() = name;
+}
+
+// --------------------------------------------------------------------
+G4String G4SteppingProfiler::GetFileName()
+{
+  G4AutoLock l(&profilerMutex);
+  return FileName();
+}
+
+// --------------------------------------------------------------------
+void G4SteppingProfiler::Report()
+{
+  // particle, process, volume and region names
+  using Name = std::tuple<G4String, G4String, G4String, G4String>;
+  std::map<Name, Entry> merged;
+  G4String fileName;
+  {
+    G4AutoLock l(&profilerMutex);
+    for(auto profiler : Instances())
+    {
+      for(const auto& row : profiler->fTable)
+      {
+        const Key& key = row.first;
+        G4String particle = (key.particle != nullptr)
+                          ? key.particle->GetParticleName() : G4String("-");
+        G4String process = (key.process != nullptr)
+                         ? key.process->GetProcessName() : G4String("-");
+        G4String volume = "-";
+        G4String region = "-";
+        if(key.volume != nullptr)
+        {
+          volume = key.volume->GetName();
+          if(key.volume->GetRegion() != nullptr)
+          {
+            region = key.volume->GetRegion()->GetName();
+          }
+        }
+        Entry& e = merged[Name(particle, process, volume, region)];
+        e.steps += row.second.steps;
+        e.stepTime += row.second.stepTime;
+        e.calls += row.second.calls;
+        e.callTime += row.second.callTime;
+      }
+      profiler->fTable.clear();
+    }
+    fileName = FileName();
+  }
+  if(merged.empty())
+  {
+    return;
+  }
+
+  std::vector<std::pair<Name, Entry>> rows(merged.cbegin(), merged.cend());
+  std::sort(rows.begin(), rows.end(),
+            [](const std::pair<Name, Entry>& a, const std::pair<Name, Entry>& b)
+            {
+              if(a.second.stepTime != b.second.stepTime)
+              {
+                return a.second.stepTime > b.second.stepTime;
+              }
+              return a.second.callTime > b.second.callTime;
+            });
+
+  G4long nSteps = 0;
+  G4double stepTime = 0.0;
+  for(const auto& row : rows)
+  {
+    nSteps += row.second.steps;
+    stepTime += row.second.stepTime;
+  }
+
+  const G4double ms = 1.e-6;
+  G4cout << "\n=========== Step profile: " << nSteps << " steps, "
+         << stepTime*ms << " ms ===========\n"
+         << std::setw(16) << "Particle" << std::setw(20) << "Process"
+         << std::setw(20) << "Volume" << std::setw(20) << "Region"
+         << std::setw(12) << "Steps" << std::setw(14) << "Time[ms]"
+         << std::setw(12) << "Calls" << std::setw(14) << "CallTime[ms]"
+         << "\n";
+  for(const auto& row : rows)
+  {
+    G4cout << std::setw(16) << std::get<0>(row.first)
+           << std::setw(20) << std::get<1>(row.first)
+           << std::setw(20) << std::get<2>(row.first)
+           << std::setw(20) << std::get<3>(row.first)
+           << std::setw(12) << row.second.steps
+           << std::setw(14) << row.second.stepTime*ms
+           << std::setw(12) << row.second.calls
+           << std::setw(14) << row.second.callTime*ms << "\n";
+  }
+  G4cout << G4endl;
+
+  if(fileName.empty())
+  {
+    return;
+  }
+  std::ofstream out(fileName);
+  if(!out)
+  {
+    G4ExceptionDescription ed;
+    ed << "Cannot open file " << fileName << ", the step profile is not"
+       << " written.";
+    G4Exception("G4SteppingProfiler::Report()", "Tracking0016", JustWarning, ed);
+    return;
+  }
+  out << "particle,process,volume,region,steps,step_time_ms,calls,"
+      << "call_time_ms\n";
+  for(const auto& row : rows)
+  {
+    out << std::get<0>(row.first) << "," << std::get<1>(row.first) << ","
+        << std::get<2>(row.first) << "," << std::get<3>(row.first) << ","
+        << row.second.steps << "," << row.second.stepTime*ms << ","
+        << row.second.calls << "," << row.second.callTime*ms << "\n";
+  }
+}
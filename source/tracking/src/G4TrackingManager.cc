@@ -35,6 +35,8 @@
 #include "G4Trajectory.hh"
 #include "G4SmoothTrajectory.hh"
 #include "G4RichTrajectory.hh"
+#include "G4CompactTrajectory.hh"
+#include "G4UserSteppingBatchAction.hh"
 #include "G4ios.hh"
 #include "G4Profiler.hh"
 #include "G4TiMemory.hh"
@@ -116,6 +118,9 @@ void G4TrackingManager::ProcessOneTrack(G4Track* apValueG4Track)
         case 4:
           fpTrajectory = new G4RichTrajectory(fpTrack);
           break;
+        case 5:
+          fpTrajectory = new G4CompactTrajectory(fpTrack);
+          break;
       }
     }
 #endif
@@ -151,6 +156,9 @@ void G4TrackingManager::ProcessOneTrack(G4Track* apValueG4Track)
     fpTrack->GetDefinition()->GetProcessManager()->EndTracking();
   }
 
+  // Deliver the steps of batched stepping actions, if requested per track
+  G4UserSteppingBatchAction::EndOfTrack();
+
   // Post tracking user intervention process.
   if( fpUserTrackingAction != nullptr )
   {
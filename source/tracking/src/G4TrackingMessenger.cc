@@ -36,15 +36,19 @@
 #include "G4UIdirectory.hh"
 #include "G4UIcmdWithoutParameter.hh"
 #include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWithAString.hh"
 #include "G4UImanager.hh"
 #include "globals.hh"
 #include "G4TrackingManager.hh"
 #include "G4SteppingManager.hh"
+#include "G4SteppingProfiler.hh"
 #include "G4TrackStatus.hh"
 #include "G4ios.hh"
 #include "G4TransportationManager.hh"
 #include "G4PropagatorInField.hh"
 #include "G4IdentityTrajectoryFilter.hh"
+#include "G4CompactTrajectory.hh"
 
 ///////////////////////////////////////////////////////////////////
 G4TrackingMessenger::G4TrackingMessenger(G4TrackingManager* trMan)
@@ -70,9 +74,28 @@ G4TrackingMessenger::G4TrackingMessenger(G4TrackingManager* trMan)
   StoreTrajectoryCmd->SetGuidance(" 2 : Choose G4SmoothTrajectory as default.");
   StoreTrajectoryCmd->SetGuidance(" 3 : Choose G4RichTrajectory as default.");
   StoreTrajectoryCmd->SetGuidance(" 4 : Choose G4RichTrajectory with auxiliary points as default.");
+  StoreTrajectoryCmd->SetGuidance(" 5 : Choose G4CompactTrajectory as default.");
   StoreTrajectoryCmd->SetParameterName("Store",true);
   StoreTrajectoryCmd->SetDefaultValue(0);
-  StoreTrajectoryCmd->SetRange("Store >=0 && Store <= 4"); 
+  StoreTrajectoryCmd->SetRange("Store >=0 && Store <= 5"); 
+
+  TrajAngleTolCmd = new G4UIcmdWithADoubleAndUnit("/tracking/trajectoryAngleTolerance",this);
+  TrajAngleTolCmd->SetGuidance("Points of G4CompactTrajectory are dropped if the");
+  TrajAngleTolCmd->SetGuidance("direction changes by less than this angle.");
+  TrajAngleTolCmd->SetGuidance(" 0 : criterion not applied (default).");
+  TrajAngleTolCmd->SetParameterName("angle",true);
+  TrajAngleTolCmd->SetDefaultValue(0.);
+  TrajAngleTolCmd->SetRange("angle >= 0.");
+  TrajAngleTolCmd->SetDefaultUnit("deg");
+
+  TrajDistanceTolCmd = new G4UIcmdWithADoubleAndUnit("/tracking/trajectoryDistanceTolerance",this);
+  TrajDistanceTolCmd->SetGuidance("Points of G4CompactTrajectory are dropped if they are");
+  TrajDistanceTolCmd->SetGuidance("closer than this to the segment joining their neighbours.");
+  TrajDistanceTolCmd->SetGuidance(" 0 : criterion not applied (default).");
+  TrajDistanceTolCmd->SetParameterName("distance",true);
+  TrajDistanceTolCmd->SetDefaultValue(0.);
+  TrajDistanceTolCmd->SetRange("distance >= 0.");
+  TrajDistanceTolCmd->SetDefaultUnit("mm");
 
   VerboseCmd = new G4UIcmdWithAnInteger("/tracking/verbose",this);
 #ifdef G4VERBOSE
@@ -93,6 +116,36 @@ G4TrackingMessenger::G4TrackingMessenger(G4TrackingManager* trMan)
 #else 
   VerboseCmd->SetGuidance("You need to recompile the tracking category defining G4VERBOSE ");  
 #endif
+
+  FastPathCmd = new G4UIcmdWithADoubleAndUnit("/tracking/fastPathDensity",this);
+  FastPathCmd->SetGuidance("Set density below which steps of neutral particles");
+  FastPathCmd->SetGuidance("take the fast path.");
+  FastPathCmd->SetGuidance("In such materials, without field, electromagnetic and");
+  FastPathCmd->SetGuidance("hadronic processes are not invoked: only transportation,");
+  FastPathCmd->SetGuidance("decay and material independent processes limit the step.");
+  FastPathCmd->SetGuidance("The number of fast path steps is printed at the end.");
+  FastPathCmd->SetGuidance(" 0 : fast path disabled (default).");
+  FastPathCmd->SetParameterName("density",true);
+  FastPathCmd->SetDefaultValue(0.);
+  FastPathCmd->SetRange("density >= 0.");
+  FastPathCmd->SetDefaultUnit("g/cm3");
+  FastPathCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  ProfileCmd = new G4UIcmdWithAnInteger("/tracking/profile",this);
+  ProfileCmd->SetGuidance("Accumulate number of steps and time per particle,");
+  ProfileCmd->SetGuidance("process and logical volume, printed at end of run.");
+  ProfileCmd->SetGuidance(" 0 : no profiling (default).");
+  ProfileCmd->SetGuidance(" 1 : time of steps, by the process limiting the step.");
+  ProfileCmd->SetGuidance(" 2 : in addition, time of each process invocation.");
+  ProfileCmd->SetParameterName("profile_level",true);
+  ProfileCmd->SetDefaultValue(0);
+  ProfileCmd->SetRange("profile_level >=0 && profile_level <= 2");
+  ProfileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  ProfileFileCmd = new G4UIcmdWithAString("/tracking/profileFile",this);
+  ProfileFileCmd->SetGuidance("Write the step profile to this CSV file.");
+  ProfileFileCmd->SetParameterName("file_name",false);
+  ProfileFileCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
 }
 
 ////////////////////////////////////////////
@@ -103,7 +156,12 @@ G4TrackingMessenger::~G4TrackingMessenger()
   delete AbortCmd;
   delete ResumeCmd;
   delete StoreTrajectoryCmd;
+  delete TrajAngleTolCmd;
+  delete TrajDistanceTolCmd;
   delete VerboseCmd;
+  delete FastPathCmd;
+  delete ProfileCmd;
+  delete ProfileFileCmd;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -115,6 +173,33 @@ void G4TrackingMessenger::SetNewValue(G4UIcommand* command,G4String newValues)
     trackingManager->SetVerboseLevel(VerboseCmd->ConvertToInt(newValues));
   }
 
+  if( command == TrajAngleTolCmd )
+  {
+    G4CompactTrajectory::SetAngleTolerance(
+      TrajAngleTolCmd->GetNewDoubleValue(newValues));
+  }
+
+  if( command == TrajDistanceTolCmd )
+  {
+    G4CompactTrajectory::SetDistanceTolerance(
+      TrajDistanceTolCmd->GetNewDoubleValue(newValues));
+  }
+
+  if( command == FastPathCmd )
+  {
+    steppingManager->SetFastPathDensity(FastPathCmd->GetNewDoubleValue(newValues));
+  }
+
+  if( command == ProfileCmd )
+  {
+    G4SteppingProfiler::SetLevel(ProfileCmd->ConvertToInt(newValues));
+  }
+
+  if( command == ProfileFileCmd )
+  {
+    G4SteppingProfiler::SetFileName(newValues);
+  }
+
   if( command == AbortCmd )
   {
     steppingManager->GetTrack()->SetTrackStatus(fStopAndKill);
@@ -162,5 +247,18 @@ G4String G4TrackingMessenger::GetCurrentValue(G4UIcommand* command)
     return StoreTrajectoryCmd
            ->ConvertToString(trackingManager->GetStoreTrajectory());
   }
+  else if( command == ProfileCmd )
+  {
+    return ProfileCmd->ConvertToString(G4SteppingProfiler::GetLevel());
+  }
+  else if( command == ProfileFileCmd )
+  {
+    return G4SteppingProfiler::GetFileName();
+  }
+  else if( command == FastPathCmd )
+  {
+    return FastPathCmd
+           ->ConvertToString(steppingManager->GetFastPathDensity(),"g/cm3");
+  }
   return G4String(1,'\0');
 }
@@ -0,0 +1,123 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+// G4UserSteppingBatchAction class implementation
+//
+// --------------------------------------------------------------------
+
+#include "G4UserSteppingBatchAction.hh"
+
+#include <algorithm>
+
+/////////////////////////////////////////////////////////
+G4UserSteppingBatchAction::G4UserSteppingBatchAction(std::size_t batchSize)
+  : fBatchSize(std::max(batchSize, std::size_t(1)))
+/////////////////////////////////////////////////////////
+{
+  fBuffer.reserve(fBatchSize);
+  if(Instances() == nullptr)
+  {
+    Instances() = new std::vector<G4UserSteppingBatchAction*>;
+  }
+  Instances()->push_back(this);
+}
+
+/////////////////////////////////////////////////////////
+G4UserSteppingBatchAction::~G4UserSteppingBatchAction()
+/////////////////////////////////////////////////////////
+{
+  auto actions = Instances();
+  if(actions != nullptr)
+  {
+    actions->erase(std::remove(actions->begin(), actions->end(), this),
+                   actions->end());
+    if(actions->empty())
+    {
+      delete actions;
+      Instances() = nullptr;
+    }
+  }
+}
+
+/////////////////////////////////////////////////////////
+std::vector<G4UserSteppingBatchAction*>*&
+G4UserSteppingBatchAction::Instances()
+/////////////////////////////////////////////////////////
+{
+  G4ThreadLocalStatic std::vector<G4UserSteppingBatchAction*>* _instances
+    = nullptr;
+  return _instances;
+}
+
+/////////////////////////////////////////////////////////
+void G4UserSteppingBatchAction::UserSteppingAction(const G4Step* aStep)
+/////////////////////////////////////////////////////////
+{
+  Record(aStep);
+}
+
+/////////////////////////////////////////////////////////
+void G4UserSteppingBatchAction::Flush()
+/////////////////////////////////////////////////////////
+{
+  if(!fBuffer.empty())
+  {
+    UserSteppingBatch(fBuffer);
+    fBuffer.clear();
+  }
+}
+
+/////////////////////////////////////////////////////////
+void G4UserSteppingBatchAction::SetBatchSize(std::size_t n)
+/////////////////////////////////////////////////////////
+{
+  fBatchSize = std::max(n, std::size_t(1));
+  if(fBuffer.size() >= fBatchSize) { Flush(); }
+  fBuffer.reserve(fBatchSize);
+}
+
+/////////////////////////////////////////////////////////
+void G4UserSteppingBatchAction::EndOfTrack()
+/////////////////////////////////////////////////////////
+{
+  auto actions = Instances();
+  if(actions == nullptr) { return; }
+  for(auto action : *actions)
+  {
+    if(action->fFlushAtEndOfTrack) { action->Flush(); }
+  }
+}
+
+/////////////////////////////////////////////////////////
+void G4UserSteppingBatchAction::EndOfEvent()
+/////////////////////////////////////////////////////////
+{
+  auto actions = Instances();
+  if(actions == nullptr) { return; }
+  for(auto action : *actions)
+  {
+    action->Flush();
+  }
+}